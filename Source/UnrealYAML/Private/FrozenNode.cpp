@@ -0,0 +1,79 @@
+﻿#include "FrozenNode.h"
+
+#include "Node.h"
+
+FYamlFrozenNode FYamlFrozenDocument::Root() const {
+    return FYamlFrozenNode(Document.Root());
+}
+
+int32 FYamlFrozenDocument::Num() const {
+    return Document.size();
+}
+
+EYamlNodeType FYamlFrozenNode::Type() const {
+    return static_cast<EYamlNodeType>(Node.Type());
+}
+
+bool FYamlFrozenNode::IsDefined() const {
+    return Node.IsDefined();
+}
+
+bool FYamlFrozenNode::IsNull() const {
+    return Node.IsNull();
+}
+
+bool FYamlFrozenNode::IsScalar() const {
+    return Node.IsScalar();
+}
+
+bool FYamlFrozenNode::IsSequence() const {
+    return Node.IsSequence();
+}
+
+bool FYamlFrozenNode::IsMap() const {
+    return Node.IsMap();
+}
+
+FYamlFrozenNode::operator bool() const {
+    return Node.IsDefined();
+}
+
+bool FYamlFrozenNode::operator!() const {
+    return !Node.IsDefined();
+}
+
+bool FYamlFrozenNode::Is(const FYamlFrozenNode& Other) const {
+    return Node.is(Other.Node);
+}
+
+FString FYamlFrozenNode::Scalar() const {
+    const FUTF8ToTCHAR Converted(Node.ScalarData(), Node.ScalarSize());
+    return FString(Converted.Length(), Converted.Get());
+}
+
+bool FYamlFrozenNode::Decode(FString& Value) const {
+    if (!Node.IsScalar()) {
+        return false;
+    }
+    Value = Scalar();
+    return true;
+}
+
+FYamlNode FYamlFrozenNode::Thaw() const {
+    return FYamlNode(Node.Thaw());
+}
+
+int32 FYamlFrozenNode::Size() const {
+    return Node.size();
+}
+
+FYamlFrozenNode FYamlFrozenNode::KeyAt(const int32 Index) const {
+    return Index >= 0 ? FYamlFrozenNode(Node.key_at(Index)) : FYamlFrozenNode();
+}
+
+FYamlFrozenNode FYamlFrozenNode::ValueAt(const int32 Index) const {
+    if (Index < 0) {
+        return FYamlFrozenNode();
+    }
+    return FYamlFrozenNode(Node.IsMap() ? Node.value_at(Index) : Node.at(Index));
+}
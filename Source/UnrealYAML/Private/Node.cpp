@@ -1,12 +1,13 @@
 ﻿#include "Node.h"
 
 EYamlNodeType FYamlNode::Type() const {
-    try {
-        return static_cast<EYamlNodeType>(Node.Type());
-    } catch (YAML::InvalidNode) {
+    const YAML::ErrorScope Errors;
+    const EYamlNodeType NodeType = static_cast<EYamlNodeType>(Node.Type());
+    if (YAML::HasError()) {
         UE_LOG(LogTemp, Warning, TEXT("Node was Invalid, returning default value for Type()!"))
         return EYamlNodeType::Undefined;
     }
+    return NodeType;
 }
 
 bool FYamlNode::IsDefined() const {
@@ -29,6 +30,16 @@ bool FYamlNode::IsMap() const {
     return Node.IsMap();
 }
 
+EYamlScalarType FYamlNode::ScalarType() const {
+    const YAML::ErrorScope Errors;
+    const EYamlScalarType Resolved = static_cast<EYamlScalarType>(YAML::ResolveScalar(Node).type);
+    if (YAML::HasError()) {
+        UE_LOG(LogTemp, Warning, TEXT("Node was Invalid, returning default value for ScalarType()!"))
+        return EYamlScalarType::Null;
+    }
+    return Resolved;
+}
+
 FYamlNode::operator bool() const {
     return Node.IsDefined();
 }
@@ -38,12 +49,13 @@ bool FYamlNode::operator!() const {
 }
 
 EYamlEmitterStyle FYamlNode::Style() const {
-    try {
-        return static_cast<EYamlEmitterStyle>(Node.Style());
-    } catch (YAML::InvalidNode) {
+    const YAML::ErrorScope Errors;
+    const EYamlEmitterStyle NodeStyle = static_cast<EYamlEmitterStyle>(Node.Style());
+    if (YAML::HasError()) {
         UE_LOG(LogTemp, Warning, TEXT("Node was Invalid, returning default value for Style()!"))
         return EYamlEmitterStyle::Default;
     }
+    return NodeStyle;
 }
 
 void FYamlNode::SetStyle(const EYamlEmitterStyle Style) {
@@ -51,12 +63,13 @@ void FYamlNode::SetStyle(const EYamlEmitterStyle Style) {
 }
 
 bool FYamlNode::Is(const FYamlNode& Other) const {
-    try {
-        return Node.is(Other.Node);
-    } catch (YAML::InvalidNode) {
+    const YAML::ErrorScope Errors;
+    const bool bIs = Node.is(Other.Node);
+    if (YAML::HasError()) {
         UE_LOG(LogTemp, Warning, TEXT("Node was Invalid, returning default value for Is() / Equals-Operation!"))
         return false;
     }
+    return bIs;
 }
 
 bool FYamlNode::operator==(const FYamlNode Other) const {
@@ -64,37 +77,102 @@ bool FYamlNode::operator==(const FYamlNode Other) const {
 }
 
 bool FYamlNode::Reset(const FYamlNode& Other) {
-    try {
-        Node.reset(Other.Node);
-        return true;
-    } catch (YAML::InvalidNode) {
+    const YAML::ErrorScope Errors;
+    Node.reset(Other.Node);
+    if (YAML::HasError()) {
         UE_LOG(LogTemp, Warning, TEXT("Node was Invalid and will not be Reset!"))
         return false;
     }
+    return true;
+}
+
+FYamlNode FYamlNode::Clone() const {
+    const YAML::ErrorScope Errors;
+    YAML::Node Copy = YAML::Clone(Node);
+    if (YAML::HasError()) {
+        UE_LOG(LogTemp, Warning, TEXT("Node was Invalid, returning an empty Node for Clone()"))
+        return FYamlNode();
+    }
+    return FYamlNode(Copy);
+}
+
+int64 FYamlNode::Compact() const {
+    const YAML::ErrorScope Errors;
+    const int64 Reclaimed = YAML::Compact(Node);
+    if (YAML::HasError()) {
+        UE_LOG(LogTemp, Warning, TEXT("Node was Invalid, nothing to Compact()"))
+        return 0;
+    }
+    return Reclaimed;
+}
+
+FYamlMemoryUsage FYamlNode::GetMemoryUsage() const {
+    const YAML::ErrorScope Errors;
+    const YAML::MemoryUsage Usage = YAML::GetMemoryUsage(Node);
+    if (YAML::HasError()) {
+        UE_LOG(LogTemp, Warning, TEXT("Node was Invalid, returning an empty Memory Usage for GetMemoryUsage()"))
+        return FYamlMemoryUsage();
+    }
+    return FYamlMemoryUsage(Usage);
+}
+
+int64 FYamlNode::GetNodeCount() const {
+    const YAML::ErrorScope Errors;
+    const int64 Count = YAML::GetNodeCount(Node);
+    if (YAML::HasError()) {
+        UE_LOG(LogTemp, Warning, TEXT("Node was Invalid, returning 0 for GetNodeCount()"))
+        return 0;
+    }
+    return Count;
 }
 
 FString FYamlNode::Scalar() const {
-    try {
-        return FString(Node.Scalar().c_str());
-    } catch (YAML::InvalidNode) {
+    const YAML::ErrorScope Errors;
+    const std::string& Value = Node.Scalar();
+    if (YAML::HasError()) {
         UE_LOG(LogTemp, Warning, TEXT("Node was Invalid, returning default value for Scalar()"))
         return "";
     }
+    return FString(Value.c_str());
 }
 
 FString FYamlNode::GetContent() const {
-    std::stringstream Stream;
-    Stream << Node;
-    return UTF8_TO_TCHAR(Stream.str().c_str());
+    YAML::Emitter Emitter;
+    Emitter << Node;
+    return UTF8_TO_TCHAR(Emitter.c_str());
+}
+
+FString FYamlNode::GetContentAsJson(const int32 Indent) const {
+    const YAML::ErrorScope Errors;
+    YAML::JsonEmitter Emitter;
+    Emitter.SetIndent(FMath::Max(Indent, 0));
+    Emitter << Node;
+    if (YAML::HasError() || !Emitter.good()) {
+        UE_LOG(LogTemp, Warning, TEXT("Node could not be written as JSON, returning empty String for GetContentAsJson()"))
+        return "";
+    }
+    return UTF8_TO_TCHAR(Emitter.c_str());
+}
+
+TSharedRef<const FYamlFrozenDocument, ESPMode::ThreadSafe> FYamlNode::Freeze() const {
+    const YAML::ErrorScope Errors;
+    TSharedRef<const FYamlFrozenDocument, ESPMode::ThreadSafe> Snapshot =
+        MakeShared<FYamlFrozenDocument, ESPMode::ThreadSafe>(Node);
+    if (YAML::HasError()) {
+        // the Document of an Invalid Node is frozen as an empty one
+        UE_LOG(LogTemp, Warning, TEXT("Node was Invalid, returning an empty Snapshot for Freeze()"))
+    }
+    return Snapshot;
 }
 
 int32 FYamlNode::Size() const {
-    try {
-        return Node.size();
-    } catch (YAML::InvalidNode) {
+    const YAML::ErrorScope Errors;
+    const int32 NodeSize = Node.size();
+    if (YAML::HasError()) {
         UE_LOG(LogTemp, Warning, TEXT("Node was Invalid, returning default value for Size()"))
         return 0;
     }
+    return NodeSize;
 }
 
 FYamlIterator FYamlNode::begin() {
@@ -104,3 +182,48 @@ FYamlIterator FYamlNode::begin() {
 FYamlIterator FYamlNode::end() {
     return FYamlIterator(Node.end());
 }
+
+
+FYamlMemoryUsage::FYamlMemoryUsage(const YAML::MemoryUsage& Usage) :
+    UndefinedNodes(Usage.undefinedNodes),
+    EmptyNodes(Usage.nullNodes),
+    ScalarNodes(Usage.scalarNodes),
+    SequenceNodes(Usage.sequenceNodes),
+    MapNodes(Usage.mapNodes),
+    FreeNodes(Usage.freeNodes),
+    ScalarBytes(Usage.scalarBytes),
+    TagBytes(Usage.tagBytes),
+    ContainerBytes(Usage.containerBytes),
+    NodeBytes(Usage.nodeBytes),
+    FrozenBytes(Usage.frozenBytes) {}
+
+FYamlMemoryUsage& FYamlMemoryUsage::operator+=(const FYamlMemoryUsage& Other) {
+    UndefinedNodes += Other.UndefinedNodes;
+    EmptyNodes += Other.EmptyNodes;
+    ScalarNodes += Other.ScalarNodes;
+    SequenceNodes += Other.SequenceNodes;
+    MapNodes += Other.MapNodes;
+    FreeNodes += Other.FreeNodes;
+    ScalarBytes += Other.ScalarBytes;
+    TagBytes += Other.TagBytes;
+    ContainerBytes += Other.ContainerBytes;
+    NodeBytes += Other.NodeBytes;
+    FrozenBytes += Other.FrozenBytes;
+    return *this;
+}
+
+TArray<FYamlMemoryUsage> FYamlMemoryUsage::ForLiveDocuments() {
+    TArray<FYamlMemoryUsage> Usages;
+    for (const YAML::MemoryUsage& Usage : YAML::GetDocumentMemoryUsage()) {
+        Usages.Emplace(Usage);
+    }
+    return Usages;
+}
+
+FString FYamlMemoryUsage::ToString() const {
+    return FString::Printf(
+        TEXT("%lld Nodes (%lld Undefined, %lld Empty, %lld Scalar, %lld Sequence, %lld Map, %lld Free), ")
+        TEXT("%lld Bytes (%lld Scalar, %lld Tag, %lld Container, %lld Node, %lld Frozen)"),
+        Nodes(), UndefinedNodes, EmptyNodes, ScalarNodes, SequenceNodes, MapNodes, FreeNodes,
+        TotalBytes(), ScalarBytes, TagBytes, ContainerBytes, NodeBytes, FrozenBytes);
+}
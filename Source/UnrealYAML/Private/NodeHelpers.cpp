@@ -3,6 +3,27 @@
 #include "node/parse.h"
 #include "HAL/FileManagerGeneric.h"
 
+namespace {
+    // Decodes straight into Value, without a temporary Copy, unless Value is the Default itself
+    template<typename T>
+    bool DecodeOrDefault(const FYamlNode& Node, const T& Default, T& Value) {
+        if (&Value == &Default) {
+            T Decoded;
+            if (!Node.DecodeInto(Decoded)) {
+                return false;
+            }
+            Value = MoveTemp(Decoded);
+            return true;
+        }
+
+        if (Node.DecodeInto(Value)) {
+            return true;
+        }
+        Value = Default;
+        return false;
+    }
+}
+
 // At least here we can use macros :)
 #define DEFINE_YAML_CONVERSIONS(Type, FancyName) \
     FYamlNode UYamlNodeHelpers::MakeFrom##FancyName(Type Value) { \
@@ -18,28 +39,16 @@
         return FYamlNode(Value); \
     } \
     bool UYamlNodeHelpers::As##FancyName(const FYamlNode& Node, Type Default, Type& Value) { \
-        const auto Out = Node.AsOptional<Type>(); \
-        const bool Success = Out.IsSet(); \
-        Value = Out.Get(Default); \
-        return Success; \
+        return DecodeOrDefault(Node, Default, Value); \
     } \
     bool UYamlNodeHelpers::As##FancyName##Array(const FYamlNode& Node, const TArray<Type>& Default, TArray<Type>& Value) { \
-        const auto Out = Node.AsOptional<TArray<Type>>(); \
-        const bool Success = Out.IsSet(); \
-        Value = Out.Get(Default); \
-        return Success; \
+        return DecodeOrDefault(Node, Default, Value); \
     } \
     bool UYamlNodeHelpers::AsInt##FancyName##Map(const FYamlNode& Node, const TMap<int32, Type>& Default, TMap<int32, Type>& Value) { \
-        const auto Out = Node.AsOptional<TMap<int32, Type>>(); \
-        const bool Success = Out.IsSet(); \
-        Value = Out.Get(Default); \
-        return Success; \
+        return DecodeOrDefault(Node, Default, Value); \
     } \
     bool UYamlNodeHelpers::AsString##FancyName##Map(const FYamlNode& Node, const TMap<FString, Type>& Default, TMap<FString, Type>& Value) { \
-        const auto Out = Node.AsOptional<TMap<FString, Type>>(); \
-        const bool Success = Out.IsSet(); \
-        Value = Out.Get(Default); \
-        return Success; \
+        return DecodeOrDefault(Node, Default, Value); \
     }
 
 DEFINE_YAML_CONVERSIONS(int32, Int)
@@ -1,17 +1,20 @@
 ﻿#include "Parsing.h"
 
+#include "HAL/FileManager.h"
+
 
 DEFINE_LOG_CATEGORY(LogYamlParsing)
 
 
 // Parsing into/from Files ---------------------------------------------------------------------------------------------
 bool UYamlParsing::ParseYaml(const FString String, FYamlNode& Out) {
-    try {
-        Out = FYamlNode(YAML::Load(TCHAR_TO_UTF8(*String)));
-        return true;
-    } catch (YAML::ParserException) {
+    const YAML::ErrorScope Errors;
+    YAML::Node Root = YAML::Load(TCHAR_TO_UTF8(*String));
+    if (YAML::HasError()) {
         return false;
     }
+    Out = FYamlNode(Root);
+    return true;
 }
 
 bool UYamlParsing::LoadYamlFromFile(const FString Path, FYamlNode& Out) {
@@ -23,7 +26,21 @@ bool UYamlParsing::LoadYamlFromFile(const FString Path, FYamlNode& Out) {
 }
 
 void UYamlParsing::WriteYamlToFile(const FString Path, const FYamlNode Node) {
-    FFileHelper::SaveStringToFile(Node.GetContent(), *Path);
+    const TUniquePtr<FArchive> File(IFileManager::Get().CreateFileWriter(*Path));
+    if (!File) {
+        UE_LOG(LogYamlParsing, Warning, TEXT("Could not open '%s' for writing"), *Path)
+        return;
+    }
+
+    // The Emitter streams into the File through a fixed Buffer, so the Document is never held in Memory as a whole
+    {
+        FYamlArchiveSink Sink(*File);
+        FYamlEmitter Emitter(Sink);
+        Emitter << Node;
+    }
+    if (!File->Close()) {
+        UE_LOG(LogYamlParsing, Warning, TEXT("Could not write '%s'"), *Path)
+    }
 }
 
 
@@ -39,22 +56,30 @@ bool UYamlParsing::ParseIntoProperty(const FYamlNode& Node, const FProperty& Pro
     if (!Node.IsDefined()) return false;
 
     if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(&Property)) {
+        // The resolved Scalar is cached with the Node, so the Conversions below reuse it instead of parsing again
+        const EYamlScalarType ScalarType = Node.ScalarType();
         if (NumericProperty->IsInteger()) {
-            const auto Value = Node.AsOptional<uint64>();
-            if (Value.IsSet()) NumericProperty->SetIntPropertyValue(PropertyValue, Value.GetValue());
-        } else {
-            const auto Value = Node.AsOptional<float>();
-            if (Value.IsSet()) NumericProperty->SetFloatingPointPropertyValue(PropertyValue, Value.GetValue());
+            if (ScalarType == EYamlScalarType::Int) {
+                // Negative Values only fit into int64, the largest ones only into uint64
+                int64 Value;
+                uint64 UnsignedValue;
+                if (Node.TryAs(Value)) {
+                    NumericProperty->SetIntPropertyValue(PropertyValue, Value);
+                } else if (Node.TryAs(UnsignedValue)) {
+                    NumericProperty->SetIntPropertyValue(PropertyValue, UnsignedValue);
+                }
+            }
+        } else if (ScalarType == EYamlScalarType::Int || ScalarType == EYamlScalarType::Float) {
+            double Value;
+            if (Node.TryAs(Value)) NumericProperty->SetFloatingPointPropertyValue(PropertyValue, Value);
         }
     } else if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(&Property)) {
-        const auto Value = Node.AsOptional<bool>();
-        if (Value.IsSet()) BoolProperty->SetPropertyValue(PropertyValue, Value.GetValue());
+        bool Value;
+        if (Node.TryAs(Value)) BoolProperty->SetPropertyValue(PropertyValue, Value);
     } else if (const FStrProperty* StringProperty = CastField<FStrProperty>(&Property)) {
-        const auto Value = Node.AsOptional<FString>();
-        if (Value.IsSet()) *const_cast<FString*>(&StringProperty->GetPropertyValue(PropertyValue)) = Value.GetValue();
+        Node.TryAs(*const_cast<FString*>(&StringProperty->GetPropertyValue(PropertyValue)));
     } else if (const FTextProperty* TextProperty = CastField<FTextProperty>(&Property)) {
-        const auto Value = Node.AsOptional<FText>();
-        if (Value.IsSet()) *const_cast<FText*>(&TextProperty->GetPropertyValue(PropertyValue)) = Value.GetValue();
+        Node.TryAs(*const_cast<FText*>(&TextProperty->GetPropertyValue(PropertyValue)));
     } else if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(&Property)) {
          const int64 Index = EnumProperty->GetEnum()->GetIndexByNameString(Node.As<FString>());
          EnumProperty->GetUnderlyingProperty()->SetIntPropertyValue(PropertyValue, Index);
@@ -0,0 +1,720 @@
+﻿#include "Misc/AutomationTest.h"
+
+#include "HAL/PlatformTime.h"
+#include "numeric.h"
+#include "yaml.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <list>
+#include <locale>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace {
+    // Encodes one Character per six Bits, the plain Way
+    std::string ReferenceBase64(const std::vector<unsigned char>& Data) {
+        const char* Digits = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        std::string Text;
+        for (std::size_t i = 0; i < Data.size(); i += 3) {
+            const std::size_t Left = Data.size() - i;
+            const uint32 Group = Data[i] << 16 | (Left > 1 ? Data[i + 1] << 8 : 0) | (Left > 2 ? Data[i + 2] : 0);
+            Text += Digits[Group >> 18 & 63];
+            Text += Digits[Group >> 12 & 63];
+            Text += Left > 1 ? Digits[Group >> 6 & 63] : '=';
+            Text += Left > 2 ? Digits[Group & 63] : '=';
+        }
+        return Text;
+    }
+
+    // Deterministic Bytes, so failures can be reproduced
+    std::vector<unsigned char> MakeBytes(const std::size_t Size, uint32 Seed) {
+        std::vector<unsigned char> Bytes(Size);
+        for (unsigned char& Byte : Bytes) {
+            Seed = Seed * 1664525 + 1013904223;
+            Byte = static_cast<unsigned char>(Seed >> 24);
+        }
+        return Bytes;
+    }
+
+    // Decodes the Sequence in one Pass and Element by Element, which must agree
+    template<typename T>
+    bool DecodesLikeElements(const YAML::Node& Sequence) {
+        std::vector<T> Bulk;
+        if (!Sequence.TryDecode(Bulk) || Bulk.size() != Sequence.size()) {
+            return false;
+        }
+        for (std::size_t i = 0; i < Bulk.size(); i++) {
+            T Element;
+            if (!Sequence[i].TryDecode(Element) || !(Element == Bulk[i] || (Element != Element && Bulk[i] != Bulk[i]))) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+namespace {
+    template<typename T>
+    bool Parses(const char* Text, T& Value) {
+        return YAML::ParseNumber(Text, Text + std::strlen(Text), Value);
+    }
+
+    std::string Format(const double Value) {
+        char Buffer[YAML::kMaxNumberSize];
+        return std::string(Buffer, YAML::FormatNumber(Buffer, Value));
+    }
+
+    std::string Format(const float Value) {
+        char Buffer[YAML::kMaxNumberSize];
+        return std::string(Buffer, YAML::FormatNumber(Buffer, Value));
+    }
+
+    // The Number of significant Digits in Text written by FormatNumber or printf
+    int32 CountDigits(const std::string& Text) {
+        const std::string Mantissa = Text.substr(0, Text.find('e'));
+        std::string Digits;
+        for (const char Character : Mantissa) {
+            if (Character >= '0' && Character <= '9' && (!Digits.empty() || Character != '0')) {
+                Digits += Character;
+            }
+        }
+        while (!Digits.empty() && Digits.back() == '0') {
+            Digits.pop_back();
+        }
+        return static_cast<int32>(Digits.size());
+    }
+
+    // The fewest Digits %.*g needs for Text that strtod reads back as Value
+    int32 ShortestDigits(const double Value) {
+        char Buffer[32];
+        for (int32 Precision = 1; Precision < 17; Precision++) {
+            std::snprintf(Buffer, sizeof(Buffer), "%.*g", Precision, Value);
+            if (std::strtod(Buffer, nullptr) == Value) {
+                return Precision;
+            }
+        }
+        return 17;
+    }
+
+    // Doubles from every Exponent, from Bit Patterns that are the same on every Run
+    double MakeBitPattern(uint64& Seed) {
+        double Value;
+        do {
+            Seed = Seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            std::memcpy(&Value, &Seed, sizeof(Value));
+        } while (Value != Value || Value - Value != 0);
+        return Value;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlParseNumbersTest, "UnrealYAML.Convert.ParseNumbers",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+// Integers and Floats follow the YAML 1.2 Core Schema, and Floats are rounded like strtod and strtof round
+bool FYamlParseNumbersTest::RunTest(const FString& Parameters) {
+    long long Integer = 0;
+    unsigned long long Unsigned = 0;
+    TestTrue(TEXT("Signs are read"), Parses("-42", Integer) && Integer == -42 && Parses("+7", Integer) && Integer == 7);
+    TestTrue(TEXT("Leading Zeros are decimal"), Parses("012", Integer) && Integer == 12);
+    TestTrue(TEXT("0x is hexadecimal"), Parses("0x1F", Integer) && Integer == 31);
+    TestTrue(TEXT("0o is octal"), Parses("0o17", Integer) && Integer == 15);
+    TestTrue(TEXT("The largest long long is read"),
+        Parses("9223372036854775807", Integer) && Integer == LLONG_MAX);
+    TestTrue(TEXT("The smallest long long is read"),
+        Parses("-9223372036854775808", Integer) && Integer == LLONG_MIN);
+    TestFalse(TEXT("long long doesn't overflow"), Parses("9223372036854775808", Integer));
+    TestTrue(TEXT("unsigned long long reads past it"),
+        Parses("18446744073709551615", Unsigned) && Unsigned == ULLONG_MAX);
+    TestFalse(TEXT("unsigned long long doesn't overflow"), Parses("18446744073709551616", Unsigned));
+    TestFalse(TEXT("unsigned long long has no Sign"), Parses("-1", Unsigned));
+    TestTrue(TEXT("Hexadecimal reads every Bit"), Parses("0xffffffffffffffff", Unsigned) && Unsigned == ULLONG_MAX);
+    TestFalse(TEXT("Hexadecimal doesn't overflow"), Parses("0x10000000000000000", Unsigned));
+
+    const char* NotIntegers[] = {"", "-", "0x", "0X1F", "0o8", "-0x1", "+0o7", "12 ", " 12", "1_000", "1.0", "1e3"};
+    for (const char* Text : NotIntegers) {
+        TestFalse(*FString::Printf(TEXT("'%s' isn't an Integer"), *FString(Text)), Parses(Text, Integer));
+    }
+
+    // every Value strtod reads from the Text
+    const char* Doubles[] = {
+        "0", "-0", "0.1", "-2.5e3", ".5", "5.", "+.5", "1e+2", "1E-2", "123456789.123456789",
+        "9007199254740991", "9007199254740992", "9007199254740993", "9007199254740995", "18446744073709551616",
+        "1.7976931348623157e308", "1.7976931348623158e308", "2.2250738585072014e-308", "2.2250738585072011e-308",
+        "4.9406564584124654e-324", "2.4703282292062328e-324", "2.4703282292062327e-324", "1e-400",
+        "0.000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000001",
+        "89255.0e-22", "7.038531e-26", "1448997445238699", "8.988465674311579e307",
+        "3.14159265358979323846264338327950288419716939937510582097494459230781640628620899862803482534211706798214"};
+    for (const char* Text : Doubles) {
+        double Value = 1;
+        const double Expected = std::strtod(Text, nullptr);
+        TestTrue(*FString::Printf(TEXT("%s is read like strtod reads it"), *FString(Text)),
+            Parses(Text, Value) && std::memcmp(&Value, &Expected, sizeof(Value)) == 0);
+    }
+
+    double Value = 0;
+    TestTrue(TEXT("Floats read Hexadecimal"), Parses("0x10", Value) && Value == 16);
+    TestTrue(TEXT("Floats read Octal"), Parses("0o10", Value) && Value == 8);
+    TestTrue(TEXT("Long Integers are Floats"), Parses("123456789012345678901234567890", Value) && Value == 1.2345678901234568e29);
+    TestFalse(TEXT("Doubles don't overflow"), Parses("1.7976931348623159e308", Value));
+    TestFalse(TEXT("Huge Exponents don't overflow"), Parses("1e309", Value) || Parses("-1e400", Value));
+    TestFalse(TEXT("Hexadecimal Floats don't overflow"), Parses("0x1ffffffffffffffff", Value));
+
+    const char* Infinities[] = {".inf", ".Inf", ".INF", "+.inf", "+.Inf", "+.INF"};
+    for (const char* Text : Infinities) {
+        TestTrue(*FString::Printf(TEXT("%s is Infinity"), *FString(Text)), Parses(Text, Value) && Value == DBL_MAX * 2);
+    }
+    TestTrue(TEXT("-.inf is negative Infinity"), Parses("-.inf", Value) && Value == -DBL_MAX * 2);
+    const char* NaNs[] = {".nan", ".NaN", ".NAN"};
+    for (const char* Text : NaNs) {
+        TestTrue(*FString::Printf(TEXT("%s is NaN"), *FString(Text)), Parses(Text, Value) && Value != Value);
+    }
+    const char* NotFloats[] = {"inf", "nan", ".iNf", ".nAn", "-.nan", "+.nan", ".infinity", "1e", "e5", ".", "-.", "1.2.3", "0x1p3"};
+    for (const char* Text : NotFloats) {
+        TestFalse(*FString::Printf(TEXT("'%s' isn't a Float"), *FString(Text)), Parses(Text, Value));
+    }
+
+    // Floats read as Doubles first, which must not round twice
+    const char* Floats[] = {
+        "0.1", "16777217", "16777219", "33554435", "1e-45", "7e-46", "7.006492321624085e-46", "1.17549435e-38",
+        "3.4028235e38", "3.4028235677973365e38", "1.000000059604644775390625", "1.0000000596046447753906250001",
+        "1.0000000596046447753906249999", "1.00000017881393432617187499", "1.00000017881393432617187500"};
+    for (const char* Text : Floats) {
+        float Float = 1;
+        const float Expected = std::strtof(Text, nullptr);
+        TestTrue(*FString::Printf(TEXT("%s is read like strtof reads it"), *FString(Text)),
+            Parses(Text, Float) && std::memcmp(&Float, &Expected, sizeof(Float)) == 0);
+    }
+    float Float = 0;
+    TestFalse(TEXT("Floats don't overflow"), Parses("3.4028236e38", Float) || Parses("1e39", Float));
+    TestTrue(TEXT("Floats read Infinity"), Parses("-.Inf", Float) && Float == -FLT_MAX * 2);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlFormatNumbersTest, "UnrealYAML.Convert.FormatNumbers",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+// Numbers are written with the fewest Digits that read back to the same Value
+bool FYamlFormatNumbersTest::RunTest(const FString& Parameters) {
+    char Buffer[YAML::kMaxNumberSize];
+    TestEqual(TEXT("The smallest long long is written"),
+        std::string(Buffer, YAML::FormatNumber(Buffer, LLONG_MIN)), std::string("-9223372036854775808"));
+    TestEqual(TEXT("The largest unsigned long long is written"),
+        std::string(Buffer, YAML::FormatNumber(Buffer, ULLONG_MAX)), std::string("18446744073709551615"));
+    TestEqual(TEXT("Zero is written"), std::string(Buffer, YAML::FormatNumber(Buffer, 0LL)), std::string("0"));
+
+    const std::pair<double, const char*> Known[] = {
+        {0.1, "0.1"}, {-0.0, "-0"}, {1.5, "1.5"}, {100, "100"}, {1e-5, "1e-05"}, {0.0001, "0.0001"},
+        {1e16, "10000000000000000"}, {1e17, "1e+17"}, {9007199254740993.0, "9007199254740992"},
+        {DBL_MAX, "1.7976931348623157e+308"}, {DBL_MIN, "2.2250738585072014e-308"}, {4.9406564584124654e-324, "5e-324"},
+        {DBL_MAX * 2, ".inf"}, {-DBL_MAX * 2, "-.inf"}, {DBL_MAX * 2 - DBL_MAX * 2, ".nan"}};
+    for (const auto& Pair : Known) {
+        TestEqual(*FString::Printf(TEXT("%.17g is written as %s"), Pair.first, *FString(Pair.second)),
+            Format(Pair.first), std::string(Pair.second));
+    }
+    TestEqual(TEXT("Floats are written with Float Precision"), Format(0.1f), std::string("0.1"));
+    TestEqual(TEXT("The largest Float is written"), Format(FLT_MAX), std::string("3.4028235e+38"));
+    TestEqual(TEXT("The smallest Float is written"), Format(1e-45f), std::string("1e-45"));
+
+    int32 Mismatches = 0;
+    int32 Longer = 0;
+    uint64 Seed = 1;
+    for (int32 i = 0; i < 100000; i++) {
+        const double Value = MakeBitPattern(Seed);
+        const std::string Text = Format(Value);
+        double Read;
+        if (!Parses(Text.c_str(), Read) || Read != Value || std::strtod(Text.c_str(), nullptr) != Value) {
+            Mismatches++;
+        }
+        if (i % 10 == 0 && CountDigits(Text) > ShortestDigits(Value)) {
+            Longer++;
+        }
+
+        const float Narrow = static_cast<float>(Value);
+        if (Narrow - Narrow == 0) {
+            const std::string FloatText = Format(Narrow);
+            float FloatRead;
+            if (!Parses(FloatText.c_str(), FloatRead) || FloatRead != Narrow) {
+                Mismatches++;
+            }
+        }
+    }
+    TestEqual(TEXT("Random Doubles and Floats round-trip"), Mismatches, 0);
+    TestEqual(TEXT("Random Doubles are written with the fewest Digits"), Longer, 0);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlFormatPrecisionTest, "UnrealYAML.Convert.FormatPrecision",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+// A Precision writes what printf's %.*g writes, and 17 Digits always read back to the same Double
+bool FYamlFormatPrecisionTest::RunTest(const FString& Parameters) {
+    int32 Mismatches = 0;
+    uint64 Seed = 3;
+    for (int32 i = 0; i < 20000; i++) {
+        const double Value = MakeBitPattern(Seed);
+        const std::size_t Precision = i % 17 + 1;
+        char Buffer[YAML::kMaxNumberSize];
+        const std::string Text(Buffer, YAML::FormatNumber(Buffer, Value, Precision));
+        char Expected[32];
+        std::snprintf(Expected, sizeof(Expected), "%.*g", static_cast<int32>(Precision), Value);
+        if (Text != Expected) {
+            Mismatches++;
+        }
+
+        const std::string Full(Buffer, YAML::FormatNumber(Buffer, Value, 17));
+        double Read;
+        if (!Parses(Full.c_str(), Read) || Read != Value) {
+            Mismatches++;
+        }
+    }
+    TestEqual(TEXT("Every Precision formats like printf and 17 Digits round-trip"), Mismatches, 0);
+
+    char Buffer[YAML::kMaxNumberSize];
+    TestEqual(TEXT("Precision 0 writes one Digit"), std::string(Buffer, YAML::FormatNumber(Buffer, 2.5, 0)),
+        std::string("2"));
+    TestEqual(TEXT("Precisions past 17 write 17 Digits"), std::string(Buffer, YAML::FormatNumber(Buffer, 0.1, 40)),
+        std::string("0.10000000000000001"));
+    TestEqual(TEXT("Halfway Cases round to even"), std::string(Buffer, YAML::FormatNumber(Buffer, 0.125, 2)),
+        std::string("0.12"));
+    TestEqual(TEXT("Rounding carries into the Exponent"), std::string(Buffer, YAML::FormatNumber(Buffer, 9.96e5, 2)),
+        std::string("1e+06"));
+    TestEqual(TEXT("Infinity keeps its Spelling"), std::string(Buffer, YAML::FormatNumber(Buffer, -DBL_MAX * 2, 3)),
+        std::string("-.inf"));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlResolveScalarTest, "UnrealYAML.Convert.ResolveScalar",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+// Plain Scalars resolve by the YAML 1.2 Core Schema, and the Resolution cached with a Node follows its Scalar
+bool FYamlResolveScalarTest::RunTest(const FString& Parameters) {
+    const auto Resolve = [](const char* Text) { return YAML::ResolveScalar(Text, std::strlen(Text)); };
+    const std::pair<const char*, YAML::ScalarType> Types[] = {
+        {"", YAML::ScalarType::Null}, {"~", YAML::ScalarType::Null}, {"null", YAML::ScalarType::Null},
+        {"Null", YAML::ScalarType::Null}, {"NULL", YAML::ScalarType::Null}, {"nULL", YAML::ScalarType::String},
+        {"~~", YAML::ScalarType::String}, {"true", YAML::ScalarType::Bool}, {"True", YAML::ScalarType::Bool},
+        {"FALSE", YAML::ScalarType::Bool}, {"tRUE", YAML::ScalarType::String}, {"TRue", YAML::ScalarType::String},
+        {"yes", YAML::ScalarType::String}, {"0", YAML::ScalarType::Int}, {"-0", YAML::ScalarType::Int},
+        {"012", YAML::ScalarType::Int}, {"0x1F", YAML::ScalarType::Int}, {"0o17", YAML::ScalarType::Int},
+        {"0X1F", YAML::ScalarType::String}, {"12 ", YAML::ScalarType::String}, {"1_000", YAML::ScalarType::String},
+        {"18446744073709551615", YAML::ScalarType::Int}, {"18446744073709551616", YAML::ScalarType::Float},
+        {"-9223372036854775808", YAML::ScalarType::Int}, {"-9223372036854775809", YAML::ScalarType::Float},
+        {"0x10000000000000000", YAML::ScalarType::String}, {"1.5", YAML::ScalarType::Float},
+        {"-.inf", YAML::ScalarType::Float}, {".NaN", YAML::ScalarType::Float}, {"1e400", YAML::ScalarType::String},
+        {".", YAML::ScalarType::String}, {"abc", YAML::ScalarType::String}};
+    for (const auto& Pair : Types) {
+        TestTrue(*FString::Printf(TEXT("'%s' resolves to its Type"), *FString(Pair.first)),
+            Resolve(Pair.first).type == Pair.second);
+    }
+
+    TestTrue(TEXT("Booleans keep their Value"), Resolve("True").boolValue && !Resolve("false").boolValue);
+    const YAML::ResolvedScalar Negative = Resolve("-31");
+    TestTrue(TEXT("Integers are a Sign and a Magnitude"), Negative.negative && Negative.magnitude == 31);
+    TestTrue(TEXT("-0 keeps its Sign"), Resolve("-0").negative && Resolve("-0").magnitude == 0);
+    TestTrue(TEXT("The largest Integer keeps every Bit"), Resolve("18446744073709551615").magnitude == ULLONG_MAX);
+    TestTrue(TEXT("Floats keep their Value"), Resolve("-2.5e3").floatValue == -2500);
+
+    // Floats resolve as Doubles first, and narrowing one must not round twice
+    const char* Floats[] = {"0.1", "16777217.0", "1.0000000596046447753906250001", "1.0000000596046447753906249999",
+        "3.4028235677973365e38", "7.006492321624085e-46"};
+    for (const char* Text : Floats) {
+        float Float = 1;
+        const float Expected = std::strtof(Text, nullptr);
+        TestTrue(*FString::Printf(TEXT("%s narrows like strtof reads it"), *FString(Text)),
+            YAML::NarrowNumber(Resolve(Text).floatValue, Text, Text + std::strlen(Text), Float) &&
+            std::memcmp(&Float, &Expected, sizeof(Float)) == 0);
+    }
+    float Float = 0;
+    const char* Overflow = "3.4028236e38";
+    TestFalse(TEXT("Narrowing doesn't overflow"),
+        YAML::NarrowNumber(Resolve(Overflow).floatValue, Overflow, Overflow + std::strlen(Overflow), Float));
+
+    YAML::Node Node("12");
+    TestTrue(TEXT("Nodes resolve their Scalar"), YAML::ResolveScalar(Node).type == YAML::ScalarType::Int);
+    TestEqual(TEXT("Integers convert from the Resolution"), Node.as<int32>(), 12);
+    TestEqual(TEXT("Doubles convert from the same Resolution"), Node.as<double>(), 12.0);
+    YAML::Node Alias = Node;
+    Alias = "x";
+    TestTrue(TEXT("A new Scalar is resolved again"), YAML::ResolveScalar(Node).type == YAML::ScalarType::String);
+    TestEqual(TEXT("A new Scalar doesn't convert from the old Resolution"), Node.as<int32>(-1), -1);
+    Node = 2.5;
+    TestTrue(TEXT("Assigned Numbers are resolved"), YAML::ResolveScalar(Node).type == YAML::ScalarType::Float);
+    TestEqual(TEXT("Assigned Numbers convert"), Node.as<double>(), 2.5);
+    Node = YAML::Load("[1]");
+    TestTrue(TEXT("Sequences are Strings"), YAML::ResolveScalar(Node).type == YAML::ScalarType::String);
+
+    TestEqual(TEXT("Leading Zeros are decimal"), YAML::Node("012").as<int32>(), 12);
+    TestEqual(TEXT("Uppercase Prefixes aren't Numbers"), YAML::Node("0X1F").as<int32>(-1), -1);
+    TestEqual(TEXT("Trailing Spaces aren't Numbers"), YAML::Load("'12 '").as<int32>(-1), -1);
+    TestTrue(TEXT("YAML 1.1 Booleans still convert"), YAML::Node("yes").as<bool>() && !YAML::Node("Off").as<bool>(true));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlNumberConversionBenchmark, "UnrealYAML.Benchmark.NumberConversion",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+// ParseNumber and FormatNumber against the Stream Conversions in the classic Locale that convert<T> used before
+bool FYamlNumberConversionBenchmark::RunTest(const FString& Parameters) {
+    const int32 Count = 200000;
+    std::vector<std::string> Integers, Decimals, Long;
+    std::vector<double> Doubles;
+    uint64 Seed = 7;
+    for (int32 i = 0; i < Count; i++) {
+        Integers.push_back(std::to_string(i * 7919 - Count));
+        Decimals.push_back(std::to_string(i * 0.37));
+        Doubles.push_back(MakeBitPattern(Seed));
+        char Buffer[32];
+        std::snprintf(Buffer, sizeof(Buffer), "%.17g", Doubles.back());
+        Long.push_back(Buffer);
+    }
+
+    const auto Time = [this, Count](const TCHAR* Name, const std::function<double()>& Fast,
+                                    const std::function<double()>& Stream) {
+        double Start = FPlatformTime::Seconds();
+        const double FastSum = Fast();
+        const double FastTime = FPlatformTime::Seconds() - Start;
+        Start = FPlatformTime::Seconds();
+        const double StreamSum = Stream();
+        const double StreamTime = FPlatformTime::Seconds() - Start;
+        TestTrue(*FString::Printf(TEXT("%s converts like the Stream"), Name), FastSum == StreamSum);
+        AddInfo(FString::Printf(TEXT("%s: %.1f ns, Stream %.1f ns per Number"),
+            Name, FastTime * 1e9 / Count, StreamTime * 1e9 / Count));
+    };
+
+    const auto Parse = [](const std::vector<std::string>& Texts, auto Value) {
+        return [&Texts, Value]() {
+            double Sum = 0;
+            for (const std::string& Text : Texts) {
+                auto Parsed = Value;
+                YAML::ParseNumber(Text.data(), Text.data() + Text.size(), Parsed);
+                Sum += Parsed;
+            }
+            return Sum;
+        };
+    };
+    const auto ParseWithStream = [](const std::vector<std::string>& Texts, auto Value) {
+        return [&Texts, Value]() {
+            double Sum = 0;
+            for (const std::string& Text : Texts) {
+                std::istringstream Stream(Text);
+                Stream.imbue(std::locale::classic());
+                auto Parsed = Value;
+                Stream >> Parsed;
+                Sum += Parsed;
+            }
+            return Sum;
+        };
+    };
+    Time(TEXT("Parse Integers"), Parse(Integers, 0LL), ParseWithStream(Integers, 0LL));
+    Time(TEXT("Parse short Decimals"), Parse(Decimals, 0.0), ParseWithStream(Decimals, 0.0));
+    Time(TEXT("Parse 17 Digits"), Parse(Long, 0.0), ParseWithStream(Long, 0.0));
+
+    Time(TEXT("Format Integers"), [&]() {
+        double Size = 0;
+        char Buffer[YAML::kMaxNumberSize];
+        for (int32 i = 0; i < Count; i++) {
+            Size += YAML::FormatNumber(Buffer, static_cast<long long>(i) * 7919 - Count) - Buffer;
+        }
+        return Size;
+    }, [&]() {
+        double Size = 0;
+        for (int32 i = 0; i < Count; i++) {
+            std::ostringstream Stream;
+            Stream.imbue(std::locale::classic());
+            Stream << static_cast<long long>(i) * 7919 - Count;
+            Size += Stream.str().size();
+        }
+        return Size;
+    });
+
+    // the Stream writes 17 Digits to round-trip, so only the Values are compared
+    Time(TEXT("Format Doubles"), [&]() {
+        double Sum = 0;
+        char Buffer[YAML::kMaxNumberSize];
+        for (const double Value : Doubles) {
+            *YAML::FormatNumber(Buffer, Value) = '\0';
+            Sum += std::strtod(Buffer, nullptr) == Value;
+        }
+        return Sum;
+    }, [&]() {
+        double Sum = 0;
+        for (const double Value : Doubles) {
+            std::ostringstream Stream;
+            Stream.imbue(std::locale::classic());
+            Stream.precision(17);
+            Stream << Value;
+            Sum += std::strtod(Stream.str().c_str(), nullptr) == Value;
+        }
+        return Sum;
+    });
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlNumberSequencesTest, "UnrealYAML.Convert.NumberSequences",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FYamlNumberSequencesTest::RunTest(const FString& Parameters) {
+    const YAML::Node Integers = YAML::Load(
+        "[0, -1, +7, 0x1F, 0o17, 12345678, 123456789012, -9876543210123456, 9223372036854775807]");
+    TestTrue(TEXT("Integers decode like their Elements"), DecodesLikeElements<int64>(Integers));
+    TestTrue(TEXT("Integers decode as Doubles like their Elements"), DecodesLikeElements<double>(Integers));
+    TestTrue(TEXT("Cached Resolutions decode the same"), DecodesLikeElements<int64>(Integers));
+
+    const YAML::Node Floats = YAML::Load(
+        "[0.1, -2.5e3, 1e-5, 123456789.123456789, .inf, -.Inf, .nan, 3.4028235e38, 1.17549435e-38]");
+    TestTrue(TEXT("Floats decode like their Elements"), DecodesLikeElements<double>(Floats));
+    TestTrue(TEXT("Floats decode as float like their Elements"), DecodesLikeElements<float>(Floats));
+
+    // halfway Cases between two floats round to even, like the C Library does
+    const char* Halfway[] = {"16777217", "16777219", "0.1", "7.038531e-26", "1e-45", "33554435"};
+    for (const char* Text : Halfway) {
+        const float Expected = std::strtof(Text, nullptr);
+        const std::vector<float> Values = YAML::Load(std::string("[") + Text + "]").as<std::vector<float>>();
+        TestTrue(*FString::Printf(TEXT("%s rounds to the nearest float"), *FString(Text)), Values[0] == Expected);
+    }
+
+    std::vector<uint8> Bytes;
+    TestFalse(TEXT("Numbers out of Range don't decode"), YAML::Load("[255, 256]").TryDecode(Bytes));
+    std::vector<int32> Mixed;
+    TestFalse(TEXT("Text doesn't decode as a Number"), YAML::Load("[1, a, 3]").TryDecode(Mixed));
+    std::vector<std::string> Strings;
+    TestTrue(TEXT("Mixed Sequences decode as Strings"), YAML::Load("[1, a, 3]").TryDecode(Strings));
+    TestEqual(TEXT("Numbers keep their Text as Strings"), Strings[2], std::string("3"));
+
+    double Values[3];
+    TestFalse(TEXT("DecodeNumbers needs the exact Size"), YAML::DecodeNumbers(Floats, Values, 3));
+    TestTrue(TEXT("DecodeNumbers fills raw Storage"), YAML::DecodeNumbers(YAML::Load("[1, 2, 3.5]"), Values, 3));
+    TestEqual(TEXT("DecodeNumbers writes every Element"), Values[2], 3.5);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlNumberSequencesBenchmark, "UnrealYAML.Benchmark.NumberSequences",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+// Navmesh and Curve Data: long Sequences of Floats, decoded in one Pass or Element by Element
+bool FYamlNumberSequencesBenchmark::RunTest(const FString& Parameters) {
+    const int32 Count = 100000;
+    std::string Text = "[";
+    for (int32 i = 0; i < Count; i++) {
+        Text += std::to_string(i * 0.37) + (i + 1 < Count ? ", " : "]");
+    }
+    const YAML::Node Sequence = YAML::Load(Text);
+
+    double Start = FPlatformTime::Seconds();
+    std::vector<float> Values = Sequence.as<std::vector<float>>();
+    const double First = FPlatformTime::Seconds() - Start;
+
+    Start = FPlatformTime::Seconds();
+    Sequence.DecodeInto(Values);
+    const double Again = FPlatformTime::Seconds() - Start;
+
+    Start = FPlatformTime::Seconds();
+    std::vector<float> Elements;
+    for (const YAML::Node Element : Sequence) {
+        Elements.push_back(Element.as<float>());
+    }
+    const double ByElement = FPlatformTime::Seconds() - Start;
+
+    TestTrue(TEXT("Both Ways decode the same"), Values == Elements);
+    AddInfo(FString::Printf(TEXT("%d Floats: first Decode %.2f ms, again %.2f ms, Element by Element %.2f ms"),
+        Count, First * 1e3, Again * 1e3, ByElement * 1e3));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlDecodeIntoTest, "UnrealYAML.Convert.DecodeInto",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+// Containers are refilled in place: what they held before is gone, the Capacity they had is kept
+bool FYamlDecodeIntoTest::RunTest(const FString& Parameters) {
+    std::vector<std::vector<int32>> Nested(1, std::vector<int32>(100, 9));
+    Nested.reserve(16);
+    const std::vector<int32>* const Storage = Nested.data();
+    YAML::Load("[[1, 2], [3], []]").DecodeInto(Nested);
+    TestTrue(TEXT("Nested Vectors are refilled"),
+        Nested == std::vector<std::vector<int32>>({{1, 2}, {3}, {}}));
+    TestTrue(TEXT("The Outer Vector keeps its Storage"), Nested.data() == Storage);
+
+    std::map<std::string, std::list<std::string>> Map = {{"old", {"x"}}};
+    YAML::Load("{a: [b, c], d: []}").DecodeInto(Map);
+    TestEqual(TEXT("Maps drop their old Keys"), Map.count("old"), std::size_t(0));
+    TestEqual(TEXT("Map Values are decoded in place"), Map["a"].back(), std::string("c"));
+    TestTrue(TEXT("Empty Values are decoded"), Map.count("d") == 1 && Map["d"].empty());
+
+    std::vector<bool> Flags;
+    YAML::Load("[true, false, true]").DecodeInto(Flags);
+    TestTrue(TEXT("Vectors of bool are decoded"), Flags == std::vector<bool>({true, false, true}));
+
+    std::pair<int32, std::string> Pair;
+    YAML::Load("[1, one]").DecodeInto(Pair);
+    TestTrue(TEXT("Pairs are decoded in place"), Pair.first == 1 && Pair.second == "one");
+
+    std::vector<int32> Partial = {5, 6};
+    TestFalse(TEXT("Failures are reported"), YAML::Load("[1, x]").TryDecode(Partial));
+    int32 Scalar = 0;
+    YAML::Load("7").DecodeInto(Scalar);
+    TestEqual(TEXT("Scalars are decoded into existing Values too"), Scalar, 7);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlTryDecodeTest, "UnrealYAML.Convert.TryDecode",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+// Probing only reports whether a Node converts: no Error is kept and the Value is only written on Success
+bool FYamlTryDecodeTest::RunTest(const FString& Parameters) {
+    YAML::ClearError();
+    const YAML::Node Map = YAML::Load("{count: 3, ratio: 0.5, name: abc, on: true, list: [1, 2]}");
+
+    int32 Count = -1;
+    TestTrue(TEXT("Integers convert"), Map["count"].TryDecode(Count) && Count == 3);
+    double Ratio = 0;
+    TestFalse(TEXT("Floats aren't Integers"), Map["ratio"].TryDecode(Count));
+    TestEqual(TEXT("A failed Probe leaves the Value alone"), Count, 3);
+    TestTrue(TEXT("Floats convert"), Map["ratio"].TryDecode(Ratio) && Ratio == 0.5);
+    bool bOn = false;
+    TestFalse(TEXT("Text isn't a Boolean"), Map["name"].TryDecode(bOn));
+    TestTrue(TEXT("Booleans convert"), Map["on"].TryDecode(bOn) && bOn);
+    std::vector<int32> List;
+    TestFalse(TEXT("Maps aren't Sequences"), Map.TryDecode(List));
+    TestTrue(TEXT("Sequences convert"), Map["list"].TryDecode(List) && List.size() == 2);
+
+    TestTrue(TEXT("TryDecode with a Key reads the Value"), Map.TryDecode("count", Count) && Count == 3);
+    TestFalse(TEXT("Missing Keys don't convert"), Map.TryDecode("missing", Count));
+    TestFalse(TEXT("Keys of Scalars don't convert"), Map["name"].TryDecode("x", Count));
+    TestTrue(TEXT("Indexes work like Keys"), Map["list"].TryDecode(1, Count) && Count == 2);
+    TestFalse(TEXT("Indexes past the End don't convert"), Map["list"].TryDecode(5, Count));
+
+    TestFalse(TEXT("Probing keeps no Error"), YAML::HasError());
+    TestEqual(TEXT("Probing by Key doesn't add the Key"), Map.size(), std::size_t(5));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlTryDecodeBenchmark, "UnrealYAML.Benchmark.TryDecode",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+// Probing every Scalar for bool, int, double and then string, as Type Detection does, on clean Numbers and on Text
+// that fails every Probe but the last
+bool FYamlTryDecodeBenchmark::RunTest(const FString& Parameters) {
+    const int32 Count = 10000;
+    YAML::Node Numbers, Words;
+    for (int32 i = 0; i < Count; i++) {
+        Numbers.push_back(i);
+        Words.push_back("word" + std::to_string(i));
+    }
+
+    const auto Probe = [](const YAML::Node& Sequence) {
+        int64 Matched = 0;
+        for (const YAML::Node Element : Sequence) {
+            bool bValue;
+            int32 Integer;
+            double Float;
+            std::string String;
+            Matched += Element.TryDecode(bValue) ? 1 : Element.TryDecode(Integer) ? 2 :
+                Element.TryDecode(Float) ? 3 : Element.TryDecode(String) ? 4 : 0;
+        }
+        return Matched;
+    };
+
+    double Start = FPlatformTime::Seconds();
+    const int64 Clean = Probe(Numbers);
+    const double CleanTime = FPlatformTime::Seconds() - Start;
+
+    Start = FPlatformTime::Seconds();
+    const int64 Mismatched = Probe(Words);
+    const double MismatchedTime = FPlatformTime::Seconds() - Start;
+
+    TestEqual(TEXT("Numbers are found as Integers"), Clean, int64(Count) * 2);
+    TestEqual(TEXT("Words are found as Strings"), Mismatched, int64(Count) * 4);
+    AddInfo(FString::Printf(TEXT("Clean %.1f ns, mismatch-heavy %.1f ns per Scalar"),
+        CleanTime * 1e9 / Count, MismatchedTime * 1e9 / Count));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlBase64Test, "UnrealYAML.Convert.Base64",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+// The vectorized Steps must give the same Text as the plain Encoding, for every Size and Alignment of the Tail
+bool FYamlBase64Test::RunTest(const FString& Parameters) {
+    const char* Known[][2] = {{"", ""}, {"f", "Zg=="}, {"fo", "Zm8="}, {"foo", "Zm9v"}, {"foobar", "Zm9vYmFy"}};
+    for (const auto& Pair : Known) {
+        const unsigned char* Data = reinterpret_cast<const unsigned char*>(Pair[0]);
+        TestEqual(TEXT("Known Texts encode"), YAML::EncodeBase64(Data, std::strlen(Pair[0])), std::string(Pair[1]));
+    }
+
+    int32 Mismatches = 0;
+    for (std::size_t Size = 0; Size < 300; Size++) {
+        const std::vector<unsigned char> Bytes = MakeBytes(Size, static_cast<uint32>(Size));
+        const std::string Text = YAML::EncodeBase64(Bytes.data(), Bytes.size());
+        if (Text != ReferenceBase64(Bytes) || YAML::DecodeBase64(Text) != Bytes) {
+            Mismatches++;
+        }
+
+        // wrapped the Way Emitters write long Scalars
+        std::string Wrapped;
+        for (std::size_t i = 0; i < Text.size(); i += 76) {
+            Wrapped += Text.substr(i, 76) + "\n  ";
+        }
+        if (YAML::DecodeBase64(Wrapped) != Bytes) {
+            Mismatches++;
+        }
+    }
+    TestEqual(TEXT("Every Size round-trips"), Mismatches, 0);
+
+    const std::vector<unsigned char> Large = MakeBytes(100000, 7);
+    std::string Chunked(YAML::EncodedBase64Size(Large.size()), '\0');
+    char* Out = &Chunked[0];
+    for (std::size_t i = 0; i < Large.size(); i += 3000) {
+        Out = YAML::EncodeBase64(Large.data() + i, std::min<std::size_t>(3000, Large.size() - i), Out);
+    }
+    TestEqual(TEXT("Chunks of whole Groups encode like the whole"), Chunked, ReferenceBase64(Large));
+
+    YAML::Emitter Emitter;
+    Emitter << YAML::Binary(Large.data(), Large.size());
+    const YAML::Node Emitted = YAML::Load(Emitter.c_str());
+    TestEqual(TEXT("Binary is emitted with its Tag"), Emitted.Tag(), std::string("tag:yaml.org,2002:binary"));
+    const YAML::Binary Loaded = Emitted.as<YAML::Binary>();
+    TestTrue(TEXT("Streamed Binary loads back"),
+        Loaded.size() == Large.size() && std::equal(Large.begin(), Large.end(), Loaded.data()));
+
+    TestTrue(TEXT("Other Characters don't decode"), YAML::DecodeBase64("Zm9v*mFy").empty());
+    YAML::Binary Binary;
+    TestFalse(TEXT("Invalid Base64 isn't Binary"), YAML::Node("not base64!").TryDecode(Binary));
+    TestTrue(TEXT("Valid Base64 is Binary"), YAML::Node("Zm9vYmFy").TryDecode(Binary) && Binary.size() == 6);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlBase64Benchmark, "UnrealYAML.Benchmark.Base64",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+// Baked Textures and Audio embedded as !!binary
+bool FYamlBase64Benchmark::RunTest(const FString& Parameters) {
+    const std::vector<unsigned char> Bytes = MakeBytes(32 << 20, 1);
+
+    double Start = FPlatformTime::Seconds();
+    const std::string Text = YAML::EncodeBase64(Bytes.data(), Bytes.size());
+    const double Encode = FPlatformTime::Seconds() - Start;
+
+    Start = FPlatformTime::Seconds();
+    const std::vector<unsigned char> Decoded = YAML::DecodeBase64(Text);
+    const double Decode = FPlatformTime::Seconds() - Start;
+
+    Start = FPlatformTime::Seconds();
+    YAML::Emitter Emitter;
+    Emitter << YAML::Binary(Bytes.data(), Bytes.size());
+    const double Emit = FPlatformTime::Seconds() - Start;
+
+    TestTrue(TEXT("The Bytes round-trip"), Decoded == Bytes);
+    AddInfo(FString::Printf(TEXT("32 MB: Encode %.1f ms, Decode %.1f ms, Emit %.1f ms (%llu Characters)"),
+        Encode * 1e3, Decode * 1e3, Emit * 1e3, static_cast<uint64>(Emitter.size())));
+    return true;
+}
+
+#endif
@@ -0,0 +1,481 @@
+﻿#include "Misc/AutomationTest.h"
+
+#include "HAL/PlatformTime.h"
+#include "yaml.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace {
+    // Formats a Number the Way the Emitter did with a Stream
+    template<typename T>
+    std::string StreamNumber(const T Value, const int32 Precision) {
+        if (std::isnan(Value)) {
+            return ".nan";
+        }
+        if (std::isinf(Value)) {
+            return Value > 0 ? ".inf" : "-.inf";
+        }
+        std::stringstream Stream;
+        Stream.precision(Precision);
+        Stream << Value;
+        return Stream.str();
+    }
+
+    template<typename T>
+    std::string EmitNumber(const T Value, const YAML::EmitterManip Format = YAML::EmitterManip::Dec) {
+        YAML::Emitter Emitter;
+        Emitter.SetIntBase(Format);
+        Emitter << Value;
+        return Emitter.c_str();
+    }
+
+    // Deterministic Doubles over the whole Range, so failures can be reproduced
+    double MakeDouble(uint64& Seed) {
+        Seed = Seed * 6364136223846793005ull + 1442695040888963407ull;
+        const double Mantissa = static_cast<double>(Seed >> 11) / static_cast<double>(1ull << 53);
+        const int32 Exponent = static_cast<int32>(Seed % 600) - 300;
+        return (Seed & 1 ? -1 : 1) * Mantissa * std::pow(10.0, Exponent);
+    }
+
+    // Nested Maps and Sequences with multi-line Scalars and long Keys, which exercise most of the Layout
+    YAML::Node MakeLayoutDocument(const int32 Count) {
+        YAML::Node Document;
+        for (int32 i = 0; i < Count; i++) {
+            YAML::Node Entry;
+            Entry["id"] = i;
+            Entry["text"] = i % 3 ? "plain" : "first line\nsecond line\n  indented";
+            Entry["items"].push_back(i);
+            Entry["items"].push_back("x: y");
+            YAML::Node Inner;
+            Inner["inner"] = std::string(i % 7 * 12, 'w');
+            Entry["items"].push_back(Inner);
+            Document[i % 5 ? "key" + std::to_string(i) : std::string(130, 'k') + std::to_string(i)] = Entry;
+        }
+        return Document;
+    }
+
+    // Collects what an Emitter hands over, and how
+    class FRecordingSink final : public YAML::OutputSink {
+    public:
+        virtual void Write(const char* Data, const std::size_t Size) override {
+            Text.append(Data, Size);
+            Writes++;
+            Largest = std::max(Largest, Size);
+        }
+
+        std::string Text;
+        int32 Writes = 0;
+        std::size_t Largest = 0;
+    };
+
+    // Only counts the Bytes, like a File would take them
+    class FCountingSink final : public YAML::OutputSink {
+    public:
+        virtual void Write(const char* Data, const std::size_t Size) override {
+            Bytes += Size;
+            Largest = std::max(Largest, Size);
+        }
+
+        std::size_t Bytes = 0;
+        std::size_t Largest = 0;
+    };
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlEmitNumbersTest, "UnrealYAML.Emitter.Numbers",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FYamlEmitNumbersTest::RunTest(const FString& Parameters) {
+    TestEqual(TEXT("Zero"), EmitNumber(0), std::string("0"));
+    TestEqual(TEXT("Smallest int32"), EmitNumber(std::numeric_limits<int32>::min()), std::string("-2147483648"));
+    TestEqual(TEXT("Largest uint64"), EmitNumber(std::numeric_limits<uint64>::max()),
+        std::string("18446744073709551615"));
+    TestEqual(TEXT("Smallest int64"), EmitNumber(std::numeric_limits<int64>::min()),
+        std::string("-9223372036854775808"));
+
+    // negative Values show the Bits of their own Size, as a Stream does
+    TestEqual(TEXT("Hex"), EmitNumber(255, YAML::EmitterManip::Hex), std::string("0xff"));
+    TestEqual(TEXT("Negative Hex int16"), EmitNumber<int16>(-1, YAML::EmitterManip::Hex), std::string("0xffff"));
+    TestEqual(TEXT("Negative Hex int32"), EmitNumber(-2, YAML::EmitterManip::Hex), std::string("0xfffffffe"));
+    TestEqual(TEXT("Negative Oct int64"), EmitNumber<int64>(-1, YAML::EmitterManip::Oct),
+        std::string("01777777777777777777777"));
+    TestEqual(TEXT("Oct Zero"), EmitNumber(0, YAML::EmitterManip::Oct), std::string("00"));
+
+    TestEqual(TEXT("Infinity"), EmitNumber(std::numeric_limits<double>::infinity()), std::string(".inf"));
+    TestEqual(TEXT("Negative Infinity"), EmitNumber(-std::numeric_limits<float>::infinity()), std::string("-.inf"));
+    TestEqual(TEXT("NaN"), EmitNumber(std::numeric_limits<double>::quiet_NaN()), std::string(".nan"));
+
+    // every Precision formats like a Stream, for the global Settings and a local Manipulator. Float Precisions above
+    // max_digits10 are refused and keep the Default
+    const int32 FloatDigits = std::numeric_limits<float>::max_digits10;
+    uint64 Seed = 7;
+    for (int32 Precision = 0; Precision <= 17; Precision++) {
+        for (int32 i = 0; i < 500; i++) {
+            const double Double = MakeDouble(Seed);
+            const float Float = static_cast<float>(i % 2 ? Double : Double * 1e-280);
+
+            YAML::Emitter Global;
+            Global.SetDoublePrecision(Precision);
+            Global.SetFloatPrecision(Precision);
+            Global << YAML::EmitterManip::Flow << YAML::EmitterManip::BeginSeq << Double << Float
+                << YAML::EmitterManip::EndSeq;
+            const std::string Expected = "[" + StreamNumber(Double, Precision) + ", "
+                + StreamNumber(Float, std::min(Precision, FloatDigits)) + "]";
+            if (!TestEqual(*FString::Printf(TEXT("Precision %d"), Precision), std::string(Global.c_str()), Expected)) {
+                return false;
+            }
+
+            YAML::Emitter Local;
+            Local << YAML::EmitterManip::Flow << YAML::EmitterManip::BeginSeq << YAML::Precision(Precision) << Double
+                << YAML::Precision(Precision) << Float << YAML::EmitterManip::EndSeq;
+            if (!TestEqual(*FString::Printf(TEXT("Local Precision %d"), Precision), std::string(Local.c_str()),
+                Expected)) {
+                return false;
+            }
+        }
+    }
+
+    // the default Precision gives back the same Double
+    for (int32 i = 0; i < 2000; i++) {
+        const double Value = MakeDouble(Seed);
+        const double Loaded = YAML::Load(EmitNumber(Value)).as<double>();
+        // TestEqual would allow for a Tolerance
+        if (!TestTrue(TEXT("Doubles round-trip"), Loaded == Value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlEmitPositionTest, "UnrealYAML.Emitter.Position",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FYamlEmitPositionTest::RunTest(const FString& Parameters) {
+    // Row and Column after Writes of every Length, counted Character by Character
+    std::string Text;
+    for (int32 i = 0; i < 4000; i++) {
+        Text += i % 11 == 0 ? '\n' : static_cast<char>('a' + i % 26);
+        if (i % 97 == 0) {
+            Text += "\n\n";
+        }
+    }
+    YAML::ostream_wrapper Out;
+    std::size_t Row = 0;
+    std::size_t Column = 0;
+    std::size_t Size = 0;
+    for (std::size_t Start = 0, Length = 0; Start < Text.size(); Start += Length, Length = (Length + 7) % 41) {
+        Length = std::min(Length, Text.size() - Start);
+        Out.write(Text.data() + Start, Length);
+        for (std::size_t i = Start; i < Start + Length; i++) {
+            Column = Text[i] == '\n' ? 0 : Column + 1;
+            Row += Text[i] == '\n';
+        }
+        Size += Length;
+        if (!TestEqual(TEXT("Row"), Out.row(), Row) || !TestEqual(TEXT("Column"), Out.col(), Column)
+            || !TestEqual(TEXT("Position"), Out.pos(), Size)) {
+            return false;
+        }
+    }
+    TestEqual(TEXT("Buffer"), std::string(Out.str()), Text);
+
+    YAML::ostream_wrapper Comment;
+    Comment.set_comment();
+    Comment.write(std::string("# long enough to be searched"));
+    TestTrue(TEXT("Comment lasts to the End of the Line"), Comment.comment());
+    Comment.write(std::string("\n"));
+    TestFalse(TEXT("Comment ends with the Line"), Comment.comment());
+
+    // Comments line up after the Column of multi-line Scalars, and Indents are written in Runs
+    YAML::Emitter Literal;
+    Literal << YAML::EmitterManip::BeginSeq << YAML::EmitterManip::Literal << "line one\nline two"
+        << YAML::Comment("after") << "x" << YAML::Comment("c") << YAML::EmitterManip::EndSeq;
+    TestEqual(TEXT("Literal"), std::string(Literal.c_str()),
+        std::string("- |\n  line one\n  line two  # after\n- x  # c"));
+
+    YAML::Emitter Keys;
+    Keys << YAML::EmitterManip::BeginMap << YAML::EmitterManip::Key << std::string(20, 'k') << YAML::EmitterManip::Value
+        << 1 << YAML::Comment("note") << YAML::EmitterManip::Key << YAML::EmitterManip::LongKey << "long"
+        << YAML::EmitterManip::Value << YAML::EmitterManip::BeginSeq << "v" << YAML::EmitterManip::EndSeq
+        << YAML::EmitterManip::EndMap;
+    TestEqual(TEXT("Keys"), std::string(Keys.c_str()), std::string(20, 'k') + ": 1  # note\n? long\n: - v");
+
+    YAML::Emitter Indented;
+    Indented.SetIndent(70);
+    Indented << YAML::EmitterManip::BeginMap << YAML::EmitterManip::Key << "a" << YAML::EmitterManip::Value
+        << YAML::EmitterManip::BeginSeq << 1 << YAML::EmitterManip::EndSeq << YAML::EmitterManip::EndMap;
+    TestEqual(TEXT("Wide Indent"), std::string(Indented.c_str()),
+        "a:\n" + std::string(70, ' ') + "-" + std::string(69, ' ') + "1");
+
+    // a Stream gets the same Bytes as the String
+    const YAML::Node Document = MakeLayoutDocument(300);
+    for (int32 Indent = 2; Indent <= 6; Indent++) {
+        YAML::Emitter String;
+        String.SetIndent(Indent);
+        String << Document;
+        std::stringstream Stream;
+        YAML::Emitter Streamed(Stream);
+        Streamed.SetIndent(Indent);
+        Streamed << Document;
+        TestEqual(*FString::Printf(TEXT("Indent %d streams the same Text"), Indent), Stream.str(),
+            std::string(String.c_str()));
+        TestEqual(TEXT("Sizes agree"), Streamed.size(), String.size());
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlEmitDocumentBenchmark, "UnrealYAML.Benchmark.EmitDocument",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+// Emits a large nested Document to a String and a Stream, and a 32 MB Binary Scalar
+bool FYamlEmitDocumentBenchmark::RunTest(const FString& Parameters) {
+    const YAML::Node Document = MakeLayoutDocument(100000);
+
+    double Start = FPlatformTime::Seconds();
+    YAML::Emitter String;
+    String << Document;
+    const double StringTime = FPlatformTime::Seconds() - Start;
+
+    Start = FPlatformTime::Seconds();
+    std::stringstream Stream;
+    YAML::Emitter Streamed(Stream);
+    Streamed << Document;
+    const double StreamTime = FPlatformTime::Seconds() - Start;
+
+    const std::vector<unsigned char> Bytes(32 * 1024 * 1024, 0x5a);
+    Start = FPlatformTime::Seconds();
+    YAML::Emitter Binary;
+    Binary << YAML::Binary(Bytes.data(), Bytes.size());
+    const double BinaryTime = FPlatformTime::Seconds() - Start;
+
+    AddInfo(FString::Printf(TEXT("Document to String %.0f ms, to Stream %.0f ms (%llu Bytes), Binary %.0f ms"),
+        StringTime * 1e3, StreamTime * 1e3, static_cast<unsigned long long>(String.size()), BinaryTime * 1e3));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlEmitJsonTest, "UnrealYAML.Emitter.Json",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FYamlEmitJsonTest::RunTest(const FString& Parameters) {
+    // plain Scalars are resolved in the Core Schema, quoted and !!str ones stay Strings
+    const YAML::Node Scalars = YAML::Load(
+        "a: 1\nb: [true, null, ~, 0x10, .5, +3, 1e3, .inf, -.nan, \"7\", '8', !!str 9, text]\nc: {}\nd: []");
+    TestEqual(TEXT("Scalars"), YAML::DumpJson(Scalars),
+        std::string(R"({"a":1,"b":[true,null,null,16,0.5,3,1e3,null,"-.nan","7","8","9","text"],"c":{},"d":[]})"));
+    TestEqual(TEXT("A lone Scalar"), YAML::DumpJson(YAML::Load("plain")), std::string("\"plain\""));
+    TestEqual(TEXT("An empty Document"), YAML::DumpJson(YAML::Load("")), std::string("null"));
+
+    TestEqual(TEXT("Collection Keys are written as their JSON"),
+        YAML::DumpJson(YAML::Load("{[1, 2]: x, {k: v}: y, 3: z}")),
+        std::string(R"({"[1,2]":"x","{\"k\":\"v\"}":"y","3":"z"})"));
+    TestEqual(TEXT("Aliases are written out"), YAML::DumpJson(YAML::Load("a: &x [1, {b: 2}]\nc: *x")),
+        std::string(R"({"a":[1,{"b":2}],"c":[1,{"b":2}]})"));
+    TestEqual(TEXT("Strings are escaped only where JSON requires it"),
+        YAML::DumpJson(YAML::Load(R"(s: "tab\t quote\" back\\ ctl\x01 \u00e9")")),
+        std::string(R"({"s":"tab\t quote\" back\\ ctl\u0001 )" "\xc3\xa9\"}"));
+
+    TestEqual(TEXT("Pretty"), YAML::DumpJson(YAML::Load("- 1\n- [2, []]\n- {a: b}"), 2),
+        std::string("[\n  1,\n  [\n    2,\n    []\n  ],\n  {\n    \"a\": \"b\"\n  }\n]"));
+
+    YAML::Node Recursive;
+    Recursive["self"] = Recursive;
+    TestEqual(TEXT("A Node that contains itself gives nothing"), YAML::DumpJson(Recursive), std::string());
+
+    // JSON is YAML, so minimal and pretty Output load back to the same Values
+    const YAML::Node Document = MakeLayoutDocument(200);
+    const std::string Minimal = YAML::DumpJson(Document);
+    TestEqual(TEXT("Minimal Output loads back"), YAML::DumpJson(YAML::Load(Minimal)), Minimal);
+    TestEqual(TEXT("Pretty Output loads back"), YAML::DumpJson(YAML::Load(YAML::DumpJson(Document, 4))), Minimal);
+
+    YAML::JsonEmitter Values;
+    Values << YAML::EmitterManip::BeginMap << "k" << 1.5 << "b"
+        << YAML::Binary(reinterpret_cast<const unsigned char*>("hi!"), 3) << "f" << 0.1f << "n" << YAML::Null
+        << "i" << -7 << "u" << std::string("\xff\x41") << 1 << true << YAML::EmitterManip::EndMap;
+    TestTrue(TEXT("Values are written"), Values.good());
+    TestEqual(TEXT("Values"), std::string(Values.c_str()),
+        std::string(R"({"k":1.5,"b":"aGkh","f":0.1,"n":null,"i":-7,"u":")" "\xef\xbf\xbd" R"(A","1":true})"));
+
+    YAML::JsonEmitter CollectionKey;
+    CollectionKey << YAML::EmitterManip::BeginMap << YAML::EmitterManip::BeginSeq;
+    TestFalse(TEXT("Collections can't be Keys"), CollectionKey.good());
+    YAML::JsonEmitter MissingValue;
+    MissingValue << YAML::EmitterManip::BeginMap << "a" << YAML::EmitterManip::EndMap;
+    TestEqual(TEXT("Maps need a Value for every Key"), MissingValue.GetLastError(),
+        std::string(YAML::ErrorMsg::JSON_EXPECTED_VALUE));
+
+    YAML::JsonEmitter TopLevel;
+    TopLevel << 1 << "two" << YAML::EmitterManip::BeginSeq << YAML::EmitterManip::EndSeq;
+    TestEqual(TEXT("Top Level Values go on their own Lines"), std::string(TopLevel.c_str()),
+        std::string("1\n\"two\"\n[]"));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlEmitJsonBenchmark, "UnrealYAML.Benchmark.EmitJson",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+// JSON against YAML Output of the same Document, which has to measure every Scalar to pick its Style
+bool FYamlEmitJsonBenchmark::RunTest(const FString& Parameters) {
+    const YAML::Node Document = MakeLayoutDocument(50000);
+
+    double Start = FPlatformTime::Seconds();
+    const std::string Yaml = YAML::Dump(Document);
+    const double YamlTime = FPlatformTime::Seconds() - Start;
+
+    Start = FPlatformTime::Seconds();
+    const std::string Minimal = YAML::DumpJson(Document);
+    const double MinimalTime = FPlatformTime::Seconds() - Start;
+
+    Start = FPlatformTime::Seconds();
+    const std::string Pretty = YAML::DumpJson(Document, 2);
+    const double PrettyTime = FPlatformTime::Seconds() - Start;
+
+    AddInfo(FString::Printf(TEXT("Dump %.0f ms, DumpJson %.0f ms, DumpJson(2) %.0f ms (%llu, %llu, %llu Bytes)"),
+        YamlTime * 1e3, MinimalTime * 1e3, PrettyTime * 1e3, static_cast<unsigned long long>(Yaml.size()),
+        static_cast<unsigned long long>(Minimal.size()), static_cast<unsigned long long>(Pretty.size())));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlEmitSinkTest, "UnrealYAML.Emitter.Sink",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FYamlEmitSinkTest::RunTest(const FString& Parameters) {
+    const YAML::Node Document = MakeLayoutDocument(500);
+    const std::string Expected = YAML::Dump(Document);
+
+    // any Buffer Size gives the same Output, handed over in Chunks no larger than the Buffer
+    const std::size_t BufferSizes[] = {1, 2, 7, 64, 4096, YAML::ostream_wrapper::kSinkBufferSize};
+    for (const std::size_t BufferSize : BufferSizes) {
+        FRecordingSink Sink;
+        {
+            YAML::Emitter Emitter(Sink, BufferSize);
+            Emitter << Document;
+            TestNull(TEXT("A Sink has no String"), Emitter.c_str());
+            TestEqual(TEXT("The Size counts every Byte"), Emitter.size(), Expected.size());
+        }
+        TestEqual(*FString::Printf(TEXT("Buffer of %llu Bytes"), static_cast<unsigned long long>(BufferSize)),
+            Sink.Text, Expected);
+        if (BufferSize >= 4096) {
+            TestTrue(TEXT("Chunks fit the Buffer"), Sink.Largest <= BufferSize);
+        }
+    }
+
+    FRecordingSink Sink;
+    YAML::Emitter Emitter(Sink);
+    Emitter << YAML::Load("a: 1");
+    TestEqual(TEXT("Short Output waits in the Buffer"), Sink.Writes, 0);
+    Emitter.Flush();
+    TestEqual(TEXT("Flush hands it over"), Sink.Text, std::string("a: 1"));
+    Emitter.Flush();
+    TestEqual(TEXT("An empty Buffer isn't handed over"), Sink.Writes, 1);
+
+    FRecordingSink JsonSink;
+    {
+        YAML::JsonEmitter Json(JsonSink, 64);
+        Json.SetIndent(2);
+        Json << Document;
+    }
+    TestEqual(TEXT("JSON through a Sink"), JsonSink.Text, YAML::DumpJson(Document, 2));
+
+    std::stringstream Stream;
+    Stream << Document;
+    TestEqual(TEXT("Streams get the same Text"), Stream.str(), Expected);
+
+    // Aliases are still found in large Documents, and load back as the same Node
+    YAML::Node Shared;
+    for (int32 i = 0; i < 5000; i++) {
+        YAML::Node Entry;
+        Entry["id"] = i;
+        Shared.push_back(Entry);
+        Shared.push_back(Entry);
+    }
+    FRecordingSink AliasSink;
+    {
+        YAML::Emitter Aliases(AliasSink, 256);
+        Aliases << Shared;
+    }
+    const YAML::Node Loaded = YAML::Load(AliasSink.Text);
+    TestEqual(TEXT("Every Entry is written"), Loaded.size(), std::size_t(10000));
+    TestTrue(TEXT("Aliases load as the same Node"), Loaded[9998].is(Loaded[9999]));
+    TestFalse(TEXT("Other Entries stay apart"), Loaded[0].is(Loaded[2]));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlEmitSinkBenchmark, "UnrealYAML.Benchmark.EmitSink",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+// A Sink only ever holds its Buffer, where a String or a Stream of the same Output grow with the Document
+bool FYamlEmitSinkBenchmark::RunTest(const FString& Parameters) {
+    const YAML::Node Document = MakeLayoutDocument(100000);
+
+    double Start = FPlatformTime::Seconds();
+    const std::string String = YAML::Dump(Document);
+    const double StringTime = FPlatformTime::Seconds() - Start;
+
+    Start = FPlatformTime::Seconds();
+    std::stringstream Stream;
+    Stream << Document;
+    const double StreamTime = FPlatformTime::Seconds() - Start;
+
+    Start = FPlatformTime::Seconds();
+    FCountingSink Sink;
+    {
+        YAML::Emitter Emitter(Sink);
+        Emitter << Document;
+    }
+    const double SinkTime = FPlatformTime::Seconds() - Start;
+
+    AddInfo(FString::Printf(TEXT("String %.0f ms, Stream %.0f ms, Sink %.0f ms for %llu Bytes, at most %llu at once"),
+        StringTime * 1e3, StreamTime * 1e3, SinkTime * 1e3, static_cast<unsigned long long>(Sink.Bytes),
+        static_cast<unsigned long long>(Sink.Largest)));
+    TestEqual(TEXT("The Sink gets every Byte"), Sink.Bytes, String.size());
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlEmitNumbersBenchmark, "UnrealYAML.Benchmark.EmitNumbers",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+// Emits ten Million Numbers of each Kind into one Flow Sequence
+bool FYamlEmitNumbersBenchmark::RunTest(const FString& Parameters) {
+    const int32 Count = 10000000;
+
+    double Start = FPlatformTime::Seconds();
+    YAML::Emitter Integers;
+    Integers << YAML::EmitterManip::Flow << YAML::EmitterManip::BeginSeq;
+    for (int32 i = 0; i < Count; i++) {
+        Integers << i - Count / 2;
+    }
+    Integers << YAML::EmitterManip::EndSeq;
+    const double IntegerTime = FPlatformTime::Seconds() - Start;
+
+    uint64 Seed = 11;
+    Start = FPlatformTime::Seconds();
+    YAML::Emitter Doubles;
+    Doubles << YAML::EmitterManip::Flow << YAML::EmitterManip::BeginSeq;
+    for (int32 i = 0; i < Count; i++) {
+        Doubles << MakeDouble(Seed);
+    }
+    Doubles << YAML::EmitterManip::EndSeq;
+    const double DoubleTime = FPlatformTime::Seconds() - Start;
+
+    Start = FPlatformTime::Seconds();
+    YAML::Emitter Floats;
+    Floats << YAML::EmitterManip::Flow << YAML::EmitterManip::BeginSeq;
+    for (int32 i = 0; i < Count; i++) {
+        Floats << static_cast<float>(i) * 0.37f;
+    }
+    Floats << YAML::EmitterManip::EndSeq;
+    const double FloatTime = FPlatformTime::Seconds() - Start;
+
+    AddInfo(FString::Printf(TEXT("int %.0f ms, double %.0f ms, float %.0f ms (%llu Bytes)"), IntegerTime * 1e3,
+        DoubleTime * 1e3, FloatTime * 1e3, static_cast<unsigned long long>(Integers.size() + Doubles.size()
+            + Floats.size())));
+    return true;
+}
+
+#endif
@@ -0,0 +1,114 @@
+﻿#include "Misc/AutomationTest.h"
+
+#include "HAL/PlatformTime.h"
+#include "yaml.h"
+
+#include <string>
+#include <vector>
+
+// The Plugin builds yaml-cpp without Exceptions, see UnrealYAML.Build.cs
+#if WITH_DEV_AUTOMATION_TESTS && defined(YAML_CPP_NO_EXCEPTIONS)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlErrorsTest, "UnrealYAML.Errors.NoExceptions",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+// Every Error that would have been thrown is kept as the Error of the Thread, and the Operation carries on
+bool FYamlErrorsTest::RunTest(const FString& Parameters) {
+    YAML::ClearError();
+    const YAML::Node Broken = YAML::Load("a: [1, 2\nb: 3");
+    TestTrue(TEXT("Parser Errors are kept"), YAML::HasError());
+    YAML::Error Error = YAML::TakeError();
+    TestTrue(TEXT("Parser Errors have their Code"), Error.code == YAML::ErrorCode::Parser);
+    TestFalse(TEXT("Parser Errors have a Message"), Error.msg.empty());
+    TestTrue(TEXT("A broken Document loads as Null"), Broken.IsNull());
+    TestFalse(TEXT("Taking the Error clears it"), YAML::HasError());
+
+    const YAML::Node Map = YAML::Load("{a: 1, text: abc}");
+    TestEqual(TEXT("Failed Conversions return a Default"), Map["text"].as<int32>(), 0);
+    TestTrue(TEXT("Failed Conversions are kept"), YAML::TakeError().code == YAML::ErrorCode::BadConversion);
+
+    const YAML::Node Missing = Map["missing"]["deeper"];
+    TestFalse(TEXT("Missing Keys are undefined"), Missing.IsDefined());
+    TestEqual(TEXT("Invalid Nodes are empty"), Missing.size(), std::size_t(0));
+    Missing.as<int32>();
+    Error = YAML::TakeError();
+    TestTrue(TEXT("Reading an invalid Node is kept"), Error.code == YAML::ErrorCode::InvalidNode);
+    TestTrue(TEXT("The Message names the Key"), Error.msg.find("missing") != std::string::npos);
+
+    YAML::Node Scalar = YAML::Load("1");
+    Scalar.push_back(2);
+    Scalar["key"] = 3;
+    TestTrue(TEXT("The first Error wins"), YAML::TakeError().code == YAML::ErrorCode::BadPushback);
+    TestTrue(TEXT("Dropped Changes leave the Node as it was"), Scalar.IsScalar() && Scalar.as<int32>() == 1);
+    TestFalse(TEXT("Successful Operations leave no Error"), YAML::HasError());
+
+    const std::vector<YAML::Node> Documents = YAML::LoadAll("a\n---\n[b\n---\nc\n");
+    YAML::ClearError();
+    TestEqual(TEXT("LoadAll returns the Documents before the Error"), Documents.size(), std::size_t(1));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlErrorScopeTest, "UnrealYAML.Errors.Scope",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+// Wrappers check for their own Errors without losing one the Caller has not read yet
+bool FYamlErrorScopeTest::RunTest(const FString& Parameters) {
+    const YAML::Node Map = YAML::Load("{a: 1, text: abc}");
+    YAML::ClearError();
+
+    YAML::Load("a: [1, 2\nb: 3");
+    {
+        const YAML::ErrorScope Errors;
+        TestFalse(TEXT("A Scope starts without an Error"), YAML::HasError());
+        Map["a"].as<int32>();
+        TestFalse(TEXT("Successful Operations in a Scope leave no Error"), YAML::HasError());
+    }
+    TestTrue(TEXT("A pending Error is restored after a Scope"), YAML::HasError());
+    {
+        const YAML::ErrorScope Errors;
+        Map["text"].as<int32>();
+        TestTrue(TEXT("A Scope sees its own Errors"), YAML::HasError());
+    }
+    TestTrue(TEXT("The pending Error wins over the one of a Scope"), YAML::TakeError().code == YAML::ErrorCode::Parser);
+
+    {
+        const YAML::ErrorScope Errors;
+        Map["text"].as<int32>();
+    }
+    TestTrue(TEXT("Without a pending Error the one of a Scope stays"),
+        YAML::TakeError().code == YAML::ErrorCode::BadConversion);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlErrorsBenchmark, "UnrealYAML.Benchmark.Errors",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+// Errors cost an Error Record instead of unwinding the Stack
+bool FYamlErrorsBenchmark::RunTest(const FString& Parameters) {
+    const int32 Count = 20000;
+    double Start = FPlatformTime::Seconds();
+    int32 Failed = 0;
+    for (int32 i = 0; i < Count; i++) {
+        YAML::ClearError();
+        YAML::Load(i % 2 ? "{a: [1, 2], b: c}" : "{a: [1, 2, b: c");
+        Failed += YAML::HasError();
+    }
+    const double Documents = FPlatformTime::Seconds() - Start;
+
+    const YAML::Node Text = YAML::Load("abc");
+    Start = FPlatformTime::Seconds();
+    for (int32 i = 0; i < Count; i++) {
+        YAML::ClearError();
+        Text.as<int32>();
+        Failed += YAML::HasError();
+    }
+    const double Conversions = FPlatformTime::Seconds() - Start;
+    YAML::ClearError();
+
+    TestEqual(TEXT("Every malformed Input fails"), Failed, Count / 2 + Count);
+    AddInfo(FString::Printf(TEXT("%.1f us per Document, half of them malformed, %.1f ns per failed Conversion"),
+        Documents * 1e6 / Count, Conversions * 1e9 / Count));
+    return true;
+}
+
+#endif
@@ -0,0 +1,141 @@
+﻿#include "Misc/AutomationTest.h"
+
+#include "HAL/PlatformTime.h"
+#include "yaml.h"
+
+#include <functional>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace {
+    // Decodes both the Node and its frozen Copy, which must agree
+    template<typename T>
+    bool DecodesAlike(const YAML::Node& Node, const YAML::FrozenNode& Frozen) {
+        T FromNode{}, FromFrozen{};
+        const bool bNodeDecoded = Node.TryDecode(FromNode);
+        if (bNodeDecoded != Frozen.TryDecode(FromFrozen)) {
+            return false;
+        }
+        // NaN only equals itself in the Text
+        return !bNodeDecoded || FromNode == FromFrozen || (FromNode != FromNode && FromFrozen != FromFrozen);
+    }
+
+    // A Base Config of Maps of Maps, Count by Count Entries
+    YAML::Node MakeConfig(const int32 Count) {
+        YAML::Node Config;
+        for (int32 i = 0; i < Count; i++) {
+            YAML::Node Section = Config["m" + std::to_string(i)];
+            for (int32 j = 0; j < Count; j++) {
+                Section["k" + std::to_string(j)] = i * Count + j;
+            }
+        }
+        return Config;
+    }
+
+    // The Bytes a Copy adds on top of the Frozen Document it shares
+    int64 OwnBytes(const YAML::Node& Node) {
+        const YAML::MemoryUsage Usage = YAML::GetMemoryUsage(Node);
+        return static_cast<int64>(Usage.totalBytes() - Usage.frozenBytes);
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlFrozenScalarsTest, "UnrealYAML.Frozen.Scalars",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FYamlFrozenScalarsTest::RunTest(const FString& Parameters) {
+    const char* Texts[] = {
+        "0", "-1", "017", "0o17", "0x1F", "-0x10", "1.5", "-2.25e3", ".inf", "-.inf", ".nan", "1e400",
+        "3.4028236e38", "255", "256", "-129", "4294967296", "-9223372036854775808", "18446744073709551615",
+        "true", "False", "yes", "NO", "on", "n", "~", "", "abc", " 1", "1 ",
+    };
+    YAML::Node Sequence;
+    for (const char* Text : Texts) {
+        Sequence.push_back(YAML::Node(std::string(Text)));
+    }
+    Sequence.push_back(YAML::Node(YAML::NodeType::Null));
+    Sequence.push_back(YAML::Load("[1, 2]"));
+    Sequence.push_back(YAML::Load("{a: 1}"));
+
+    const YAML::FrozenDocument Document(Sequence);
+    const YAML::FrozenNode Root = Document.Root();
+    for (std::size_t i = 0; i < Sequence.size(); i++) {
+        const YAML::Node Node = Sequence[i];
+        const YAML::FrozenNode Frozen = Root[i];
+        const bool bAlike = DecodesAlike<int>(Node, Frozen) && DecodesAlike<unsigned>(Node, Frozen) &&
+            DecodesAlike<long long>(Node, Frozen) && DecodesAlike<unsigned long long>(Node, Frozen) &&
+            DecodesAlike<short>(Node, Frozen) && DecodesAlike<unsigned char>(Node, Frozen) &&
+            DecodesAlike<float>(Node, Frozen) && DecodesAlike<double>(Node, Frozen) &&
+            DecodesAlike<bool>(Node, Frozen) && DecodesAlike<std::string>(Node, Frozen) &&
+            DecodesAlike<std::vector<int>>(Node, Frozen);
+        TestTrue(*FString::Printf(TEXT("Frozen Element %d decodes like the Node"), static_cast<int32>(i)), bAlike);
+    }
+
+    TestEqual(TEXT("as() with a Fallback"), Root[6].as<double>(0.0), 1.5);
+    TestEqual(TEXT("as() falls back for Text"), Root[27].as<int>(7), 7);
+    TestEqual(TEXT("Undefined Nodes fall back"), YAML::FrozenNode().as<int>(5), 5);
+    TestEqual(TEXT("Null decodes as the String null"), Root[30].as<std::string>(), std::string("null"));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlCopyOnWriteTest, "UnrealYAML.Frozen.CopyOnWrite",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+// Thawed Copies and their Clones share every Part of the Frozen Document that wasn't changed
+bool FYamlCopyOnWriteTest::RunTest(const FString& Parameters) {
+    YAML::Node First, Second, Cloned;
+    int64 Full = 0;
+    {
+        const YAML::Node Base = MakeConfig(50);
+        Full = OwnBytes(Base);
+        const YAML::FrozenDocument Frozen(Base);
+
+        First = Frozen.Root().Thaw();
+        Second = Frozen.Root().Thaw();
+        First["m3"]["k5"] = -1;
+        TestEqual(TEXT("Changes stay in their Copy"), Second["m3"]["k5"].as<int32>(), 155);
+        TestEqual(TEXT("Changes don't reach the Frozen Document"), Frozen.Root()["m3"]["k5"].as<int32>(), 155);
+
+        Cloned = YAML::Clone(First);
+        Cloned["m4"]["k6"] = -2;
+        TestEqual(TEXT("Clones see what was changed before"), Cloned["m3"]["k5"].as<int32>(), -1);
+        TestEqual(TEXT("Changes to a Clone stay in it"), First["m4"]["k6"].as<int32>(), 206);
+    }
+
+    TestEqual(TEXT("Copies outlive the Frozen Document"), Second["m49"]["k49"].as<int32>(), 2499);
+    TestEqual(TEXT("Clones outlive the Frozen Document"), Cloned["m0"]["k1"].as<int32>(), 1);
+    TestTrue(TEXT("A changed Copy only owns the Path to the Change"), OwnBytes(First) * 4 < Full);
+    TestTrue(TEXT("A changed Clone only owns the Paths to the Changes"), OwnBytes(Cloned) * 4 < Full);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlCopyOnWriteBenchmark, "UnrealYAML.Benchmark.CopyOnWrite",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+// Layering Overrides on a large Base Config: a full Clone of the live Base against Copies of its Frozen Document
+bool FYamlCopyOnWriteBenchmark::RunTest(const FString& Parameters) {
+    const YAML::Node Base = MakeConfig(200);
+    const YAML::FrozenDocument Frozen(Base);
+    const int32 Copies = 20;
+
+    const auto Measure = [&](const TCHAR* Name, const std::function<YAML::Node()>& Copy) {
+        int64 Bytes = 0;
+        const double Start = FPlatformTime::Seconds();
+        for (int32 i = 0; i < Copies; i++) {
+            YAML::Node Node = Copy();
+            for (int32 j = 0; j < 3; j++) {
+                Node["m" + std::to_string(i * 3 + j)]["k1"] = -1;
+            }
+            Bytes += OwnBytes(Node);
+        }
+        AddInfo(FString::Printf(TEXT("%s: %.2f ms and %lld KiB per Copy"), Name,
+            (FPlatformTime::Seconds() - Start) * 1e3 / Copies, Bytes / 1024 / Copies));
+    };
+
+    Measure(TEXT("Clone of the live Base"), [&] { return YAML::Clone(Base); });
+    Measure(TEXT("Thaw"), [&] { return Frozen.Root().Thaw(); });
+    const YAML::Node Thawed = Frozen.Root().Thaw();
+    Measure(TEXT("Clone of a thawed Copy"), [&] { return YAML::Clone(Thawed); });
+    return true;
+}
+
+#endif
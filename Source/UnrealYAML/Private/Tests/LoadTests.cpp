@@ -0,0 +1,104 @@
+﻿#include "Misc/AutomationTest.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformTime.h"
+#include "yaml.h"
+
+#include <atomic>
+#include <string>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace {
+    // A Map of Count Entries, each a Map with an id, a name and four tags
+    std::string MakeText(const int32 Count) {
+        std::string Text;
+        for (int32 i = 0; i < Count; i++) {
+            const std::string Index = std::to_string(i);
+            Text += "k" + Index + ":\n  id: " + Index + "\n  name: item " + Index + "\n  tags: [a, b, c, d]\n";
+        }
+        return Text;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlParallelLoadBenchmark, "UnrealYAML.Benchmark.ParallelLoad",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+// Documents loaded on different Threads share no Counters and rarely a Lock, so the Documents loaded per Second
+// should grow with the Threads up to the Cores of the Machine. Beyond that, the Threads only share the Cores, and the
+// Numbers show what Contention costs instead
+bool FYamlParallelLoadBenchmark::RunTest(const FString& Parameters) {
+    const std::string Text = MakeText(1000);
+    const int32 DocumentsPerThread = 16;
+
+    const int32 Cores = FPlatformMisc::NumberOfCoresIncludingHyperthreads();
+    AddInfo(FString::Printf(TEXT("%d Cores"), Cores));
+    // the first Load warms up the Allocator, which would count against one Thread
+    YAML::Load(Text);
+    double OneThread = 0;
+    for (const int32 Threads : {1, 2, 4, 8, 16}) {
+        std::atomic<int64> Entries(0);
+        const double Start = FPlatformTime::Seconds();
+        ParallelFor(Threads, [&](const int32 Thread) {
+            for (int32 i = 0; i < DocumentsPerThread; i++) {
+                const YAML::Node Document = YAML::Load(Text);
+                Entries += Document.size();
+            }
+        });
+        const double Elapsed = FPlatformTime::Seconds() - Start;
+
+        const double PerSecond = Threads * DocumentsPerThread / Elapsed;
+        if (Threads == 1) {
+            OneThread = PerSecond;
+        }
+        AddInfo(FString::Printf(TEXT("%d Threads: %.0f Documents per Second, %.2fx one Thread%s"),
+            Threads, PerSecond, PerSecond / OneThread, Threads > Cores ? TEXT(" (more Threads than Cores)") : TEXT("")));
+        TestEqual(TEXT("Every Document is loaded in full"), Entries.load(), int64(Threads) * DocumentsPerThread * 1000);
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlLargeDocumentBenchmark, "UnrealYAML.Benchmark.LargeDocument",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+// Nodes are placed in Chunks of their Document instead of being allocated one by one, so a Document of a Million
+// Nodes should load, build and free in a fraction of the Time and with a few Bytes of Bookkeeping per Node
+bool FYamlLargeDocumentBenchmark::RunTest(const FString& Parameters) {
+    // Twelve Nodes per Entry: its Key and Map, id, name and tags with their Values, and four Elements
+    const int32 Count = 1000000 / 12;
+    const std::string Text = MakeText(Count);
+
+    double Start = FPlatformTime::Seconds();
+    YAML::Node Loaded = YAML::Load(Text);
+    const double Load = FPlatformTime::Seconds() - Start;
+
+    Start = FPlatformTime::Seconds();
+    YAML::Node Built;
+    for (int32 i = 0; i < Count; i++) {
+        YAML::Node Value = Built["k" + std::to_string(i)];
+        Value["id"] = i;
+        Value["name"] = "item " + std::to_string(i);
+        for (const char* Tag : {"a", "b", "c", "d"}) {
+            Value["tags"].push_back(Tag);
+        }
+    }
+    const double Build = FPlatformTime::Seconds() - Start;
+
+    const YAML::MemoryUsage Usage = YAML::GetMemoryUsage(Loaded);
+    const std::size_t Nodes = Usage.nodes();
+    TestTrue(TEXT("Every Entry is loaded"), Loaded.size() == std::size_t(Count) && Nodes >= std::size_t(Count) * 12);
+
+    Start = FPlatformTime::Seconds();
+    Loaded.reset();
+    Built.reset();
+    const double Free = FPlatformTime::Seconds() - Start;
+
+    AddInfo(FString::Printf(TEXT("%llu Nodes: Load %.1f ns, Build %.1f ns, Free %.1f ns per Node"),
+        static_cast<uint64>(Nodes), Load * 1e9 / Nodes, Build * 1e9 / Nodes, Free * 1e9 / Nodes));
+    AddInfo(FString::Printf(TEXT("%.1f Node Bytes and %.1f Container Bytes per Node"),
+        double(Usage.nodeBytes) / Nodes, double(Usage.containerBytes) / Nodes));
+    return true;
+}
+
+#endif
@@ -0,0 +1,271 @@
+﻿#include "Misc/AutomationTest.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+#include "yaml.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlCompactTest, "UnrealYAML.Memory.Compact",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FYamlCompactTest::RunTest(const FString& Parameters) {
+    YAML::Node Document = YAML::Load("a: 1\nb: [1, 2, 3]\nc: {x: y}\n");
+    for (int32 i = 0; i < 100; i++) {
+        Document["b"] = YAML::Load("[4, 5, 6, 7, 8]");
+    }
+    YAML::Node Removed = Document["c"];
+    Document.remove("c");
+    YAML::Node Placeholder = Document["new"];
+
+    TestTrue(TEXT("Overwritten Sequences are reclaimed"), YAML::Compact(Document) > 0);
+    TestEqual(TEXT("Nothing is left for a second Compaction"), YAML::Compact(Document), std::size_t(0));
+
+    TestEqual(TEXT("Reachable Values survive"), Document["b"][4].as<int32>(), 8);
+    TestEqual(TEXT("Removed Nodes still held survive"), Removed["x"].as<std::string>(), std::string("y"));
+    Placeholder = 5;
+    TestEqual(TEXT("Placeholders still held survive"), Document["new"].as<int32>(), 5);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlCompactOnlyOnRequestTest, "UnrealYAML.Memory.CompactOnlyOnRequest",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+// Changes never compact, so Views and Iterators into a Document stay valid until YAML::Compact() is called
+bool FYamlCompactOnlyOnRequestTest::RunTest(const FString& Parameters) {
+    YAML::Node Document = YAML::Load("{settings: {volume: 1, name: a}, items: [1, 2, 3]}");
+    const YAML::NodeView Items(Document["items"]);
+    YAML::const_iterator Setting = Document["settings"].begin();
+
+    const std::size_t Before = YAML::GetMemoryUsage(Document).nodes();
+    for (int32 i = 0; i < 10000; i++) {
+        Document["items"] = YAML::Load("[4, 5, 6, 7]");
+        Document["settings"]["volume"] = i;
+    }
+    TestTrue(TEXT("Overwritten Nodes are kept"), YAML::GetMemoryUsage(Document).nodes() >= Before + 50000);
+    TestEqual(TEXT("Views still read their Node"), Items[2].as<int32>(), 6);
+    TestEqual(TEXT("Iterators still walk their Map"), Setting->first.as<std::string>(), std::string("volume"));
+    TestEqual(TEXT("Iterators see the latest Values"), Setting->second.as<int32>(), 9999);
+
+    TestTrue(TEXT("Compacting frees the overwritten Nodes"), YAML::Compact(Document) > 0);
+    TestTrue(TEXT("Only reachable Nodes are left"), YAML::GetMemoryUsage(Document).nodes() < Before + 10);
+    TestEqual(TEXT("The last Sequence is kept"), Document["items"][3].as<int32>(), 7);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlNodeCountTest, "UnrealYAML.Memory.NodeCount",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+// The Node Count is kept up to date, so Callers can compact at their own Safe Points once the Document has grown
+bool FYamlNodeCountTest::RunTest(const FString& Parameters) {
+    YAML::Node Document = YAML::Load("{settings: {volume: 1, name: a}, items: [1, 2, 3]}");
+    TestEqual(TEXT("Parsed Nodes are counted"), YAML::GetNodeCount(Document), YAML::GetMemoryUsage(Document).nodes());
+
+    std::size_t Limit = 2 * YAML::GetNodeCount(Document);
+    int32 Compactions = 0;
+    for (int32 i = 0; i < 1000; i++) {
+        Document["items"] = YAML::Load("[4, 5, 6, 7]");
+        if (YAML::GetNodeCount(Document) > Limit) {
+            YAML::Compact(Document);
+            Limit = 2 * YAML::GetNodeCount(Document);
+            Compactions++;
+        }
+    }
+    TestTrue(TEXT("The Document grows past the Limit again and again"), Compactions > 100);
+    TestTrue(TEXT("The Document stays within the Limit"), YAML::GetNodeCount(Document) <= Limit);
+    TestEqual(TEXT("Merged and overwritten Nodes are counted"), YAML::GetNodeCount(Document),
+        YAML::GetMemoryUsage(Document).nodes());
+    TestEqual(TEXT("The last Sequence is kept"), Document["items"][3].as<int32>(), 7);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlMemoryLifetimeTest, "UnrealYAML.Memory.Lifetime",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+// A Document's Nodes live in Chunks it owns, which die with the last Node that refers to any of them
+bool FYamlMemoryLifetimeTest::RunTest(const FString& Parameters) {
+    YAML::Node Kept;
+    YAML::Node Element;
+    {
+        YAML::Node Document;
+        for (int32 i = 0; i < 10000; i++) {
+            Document["items"].push_back(i);
+        }
+        Kept = Document["items"];
+        Element = Document["items"][9999];
+
+        const YAML::MemoryUsage Usage = YAML::GetMemoryUsage(Document);
+        TestTrue(TEXT("Every Element is counted"), Usage.scalarNodes >= 10000);
+        TestTrue(TEXT("Node Slots are counted"), Usage.nodeBytes >= Usage.nodes());
+    }
+
+    TestEqual(TEXT("Nodes outlive the Document they were taken from"), Kept[5000].as<int32>(), 5000);
+    Kept.reset();
+    TestEqual(TEXT("The last Node keeps the whole Document alive"), Element.as<int32>(), 9999);
+
+    YAML::Node Loaded = YAML::Load("a: [1, 2]\nb: {c: d}\n");
+    const YAML::Node Inner = Loaded["b"]["c"];
+    Loaded = YAML::Node();
+    TestEqual(TEXT("Loaded Nodes outlive their Root"), Inner.as<std::string>(), std::string("d"));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlMemoryMergeTest, "UnrealYAML.Memory.Merge",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+// Assigning or pushing a Node of another Document merges the two Documents into one, in whichever Order
+bool FYamlMemoryMergeTest::RunTest(const FString& Parameters) {
+    YAML::Node Root;
+    YAML::Node First;
+    for (int32 i = 0; i < 1000; i++) {
+        YAML::Node Inner;
+        Inner.push_back(i);
+        YAML::Node Element;
+        Element["inner"] = Inner;
+        Root.push_back(Element);
+        if (i == 0) {
+            First = Inner;
+        }
+    }
+    TestEqual(TEXT("Bottom-up Documents keep every Element"), Root[999]["inner"][0].as<int32>(), 999);
+    TestTrue(TEXT("All merged Documents are counted as one"), YAML::GetMemoryUsage(First).mapNodes >= 1000);
+
+    // the small Document is merged into the large one, then only the small one's Node is left
+    YAML::Node Small = YAML::Load("[x]");
+    Root.push_back(Small);
+    Root = YAML::Node();
+    First = YAML::Node();
+    TestEqual(TEXT("A merged Document lives as long as any of its Nodes"), Small[0].as<std::string>(),
+        std::string("x"));
+
+    // the large Document is merged into the small one
+    YAML::Node Large = YAML::Load("[1, 2, 3, 4, 5, 6, 7, 8]");
+    YAML::Node Target = YAML::Load("a: 1");
+    Target["large"] = Large;
+    Large = YAML::Node();
+    TestEqual(TEXT("Either Side of a Merge may be the larger one"), Target["large"][7].as<int32>(), 8);
+    return true;
+}
+
+#if YAML_CPP_THREADSAFE_REFCOUNT
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlSharedHandlesTest, "UnrealYAML.Memory.SharedHandles",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::StressFilter)
+
+// Nodes of one Document are copied and dropped on many Threads at once, which only touches their Reference Counts
+bool FYamlSharedHandlesTest::RunTest(const FString& Parameters) {
+    std::vector<YAML::Node> Handles;
+    {
+        YAML::Node Document;
+        for (int32 i = 0; i < 256; i++) {
+            Document.push_back(i);
+        }
+        for (int32 i = 0; i < 256; i++) {
+            Handles.push_back(Document[i]);
+        }
+    }
+
+    std::atomic<int32> Mismatches(0);
+    ParallelFor(16, [&](const int32 Task) {
+        for (int32 Pass = 0; Pass < 200; Pass++) {
+            std::vector<YAML::Node> Copies(Handles.begin(), Handles.end());
+            for (int32 i = 0; i < 256; i++) {
+                const YAML::Node Copy = Copies[(i + Task) % 256];
+                if (Copy.Scalar() != std::to_string((i + Task) % 256)) {
+                    Mismatches++;
+                }
+            }
+        }
+    });
+    TestEqual(TEXT("Every Thread reads the Values it copied"), Mismatches.load(), 0);
+
+    const YAML::Node Last = Handles.back();
+    Handles.clear();
+    TestEqual(TEXT("The Document survives all other Copies"), Last.as<int32>(), 255);
+    return true;
+}
+#endif
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlMemoryUsageTest, "UnrealYAML.Memory.Usage",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FYamlMemoryUsageTest::RunTest(const FString& Parameters) {
+    const std::string Long(200, 'x');
+    const YAML::Node Document = YAML::Load("{a: " + Long + ", b: !!custom_tag_that_is_long [1, 2, ~]}");
+    const YAML::MemoryUsage Usage = YAML::GetMemoryUsage(Document["b"]);
+
+    TestEqual(TEXT("Maps are counted"), Usage.mapNodes, std::size_t(1));
+    TestEqual(TEXT("Sequences are counted"), Usage.sequenceNodes, std::size_t(1));
+    TestEqual(TEXT("Scalars are counted"), Usage.scalarNodes, std::size_t(5));
+    TestEqual(TEXT("Null is counted"), Usage.nullNodes, std::size_t(1));
+    TestTrue(TEXT("Long Scalars are counted in full"), Usage.scalarBytes >= Long.size());
+    TestTrue(TEXT("Long Tags are counted"), Usage.tagBytes > 0);
+    TestTrue(TEXT("Element Arrays are counted"), Usage.containerBytes > 0);
+    TestEqual(TEXT("The Total adds up"), Usage.totalBytes(),
+        Usage.scalarBytes + Usage.tagBytes + Usage.containerBytes + Usage.nodeBytes + Usage.frozenBytes);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlLiveDocumentsTest, "UnrealYAML.Memory.LiveDocuments",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+// Counts live Documents, so nothing else may load Documents meanwhile
+bool FYamlLiveDocumentsTest::RunTest(const FString& Parameters) {
+    const bool WasTracking = YAML::IsDocumentTracking();
+    YAML::SetDocumentTracking(false);
+    const std::size_t Before = YAML::GetDocumentMemoryUsage().size();
+    {
+        const YAML::Node Untracked = YAML::Load("[0]");
+        TestEqual(TEXT("Documents aren't listed while Tracking is off"), YAML::GetDocumentMemoryUsage().size(), Before);
+    }
+
+    YAML::SetDocumentTracking(true);
+    {
+        YAML::Node First = YAML::Load("[1]");
+        const YAML::Node Second = YAML::Load("[2]");
+        std::vector<YAML::Node> Many;
+        for (int32 i = 0; i < 100; i++) {
+            Many.push_back(YAML::Load("{a: 1}"));
+        }
+        TestEqual(TEXT("Every loaded Document is listed"), YAML::GetDocumentMemoryUsage().size(), Before + 102);
+
+        Many.erase(Many.begin() + 10, Many.begin() + 60);
+        TestEqual(TEXT("Destroyed Documents leave the List"), YAML::GetDocumentMemoryUsage().size(), Before + 52);
+
+        First.push_back(Second);
+        TestEqual(TEXT("Merged Documents are listed once"), YAML::GetDocumentMemoryUsage().size(), Before + 51);
+    }
+    TestEqual(TEXT("All Documents left the List"), YAML::GetDocumentMemoryUsage().size(), Before);
+    YAML::SetDocumentTracking(WasTracking);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlDocumentTeardownBenchmark, "UnrealYAML.Benchmark.DocumentTeardown",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+// Listing and unlisting a Document takes constant Time, however many other Documents are alive
+bool FYamlDocumentTeardownBenchmark::RunTest(const FString& Parameters) {
+    for (const int32 Count : {10000, 40000}) {
+        std::vector<YAML::Node> Documents;
+        Documents.reserve(Count);
+
+        double Start = FPlatformTime::Seconds();
+        for (int32 i = 0; i < Count; i++) {
+            Documents.push_back(YAML::Load("a"));
+        }
+        const double Load = FPlatformTime::Seconds() - Start;
+
+        Start = FPlatformTime::Seconds();
+        Documents.clear();
+        const double Free = FPlatformTime::Seconds() - Start;
+
+        AddInfo(FString::Printf(TEXT("%d Documents: Load %.1f ns, Free %.1f ns per Document"),
+            Count, Load * 1e9 / Count, Free * 1e9 / Count));
+    }
+    return true;
+}
+
+#endif
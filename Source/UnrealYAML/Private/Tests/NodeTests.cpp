@@ -0,0 +1,420 @@
+﻿#include "Misc/AutomationTest.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+#include "yaml.h"
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace {
+    // Large enough for string lookups to go through the key index, which the Map builds as it grows
+    YAML::Node MakeIndexedMap(YAML::Node FirstKey, const int32 Count) {
+        YAML::Node Map;
+        Map[FirstKey] = 0;
+        for (int32 i = 1; i < Count; i++) {
+            Map["k" + std::to_string(i)] = i;
+        }
+        return Map;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlStringKeyIndexTest, "UnrealYAML.Node.StringKeyIndex",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FYamlStringKeyIndexTest::RunTest(const FString& Parameters) {
+    // renamed through the iterator
+    {
+        YAML::Node Map = MakeIndexedMap(YAML::Node("k0"), 20);
+        for (auto It = Map.begin(); It != Map.end(); ++It) {
+            if (It->first.Scalar() == "k7") {
+                YAML::Node Key = It->first;
+                Key = "renamed";
+            }
+        }
+        TestTrue(TEXT("Key renamed through the iterator is found"), Map["renamed"].IsDefined());
+        TestFalse(TEXT("Old name of a renamed key is gone"), Map["k7"].IsDefined());
+        Map["renamed"] = 99;
+        TestEqual(TEXT("Assigning to a renamed key adds no entry"), Map.size(), std::size_t(20));
+    }
+
+    // assigned to the Node used as the key
+    {
+        YAML::Node Key("k0");
+        YAML::Node Map = MakeIndexedMap(Key, 20);
+        Key = "renamed";
+        TestTrue(TEXT("Key assigned a new scalar is found"), Map["renamed"].IsDefined());
+        Map["renamed"] = 99;
+        TestEqual(TEXT("Assigning to a reassigned key adds no entry"), Map.size(), std::size_t(20));
+    }
+
+    // a sequence key that becomes a scalar
+    {
+        YAML::Node Key;
+        Key.push_back(1);
+        YAML::Node Map = MakeIndexedMap(Key, 20);
+        Key = "renamed";
+        TestTrue(TEXT("Sequence key turned scalar is found"), Map["renamed"].IsDefined());
+    }
+
+    // the key Node made to refer to another node
+    {
+        YAML::Node Key("k0");
+        YAML::Node Map = MakeIndexedMap(Key, 20);
+        YAML::Node Other("renamed");
+        Key = Other;
+        TestTrue(TEXT("Key referring to another node is found"), Map["renamed"].IsDefined());
+        const YAML::Node& ConstMap = Map;
+        TestTrue(TEXT("Const lookup finds it too"), ConstMap["renamed"].IsDefined());
+        Map["renamed"] = 99;
+        TestEqual(TEXT("Assigning to a rereferenced key adds no entry"), Map.size(), std::size_t(20));
+    }
+
+    // const lookups only read, so they search a map whose index was dropped instead of rebuilding it
+    {
+        YAML::Node Key("k0");
+        YAML::Node Map = MakeIndexedMap(Key, 20);
+        Key = "renamed";
+        const YAML::Node& ConstMap = Map;
+        TestTrue(TEXT("Const lookups find a renamed key"), ConstMap["renamed"].IsDefined());
+        TestEqual(TEXT("Const lookups find the other keys"), ConstMap["k19"].as<int32>(), 19);
+
+        std::string Text;
+        for (int32 i = 0; i < 20; i++) {
+            Text += "k" + std::to_string(i) + ": " + std::to_string(i) + "\n";
+        }
+        const YAML::Node Loaded = YAML::Load(Text);
+        TestEqual(TEXT("Const lookups find the keys of a loaded map"), Loaded["k17"].as<int32>(), 17);
+    }
+
+    // one key Node in two indexed maps
+    {
+        YAML::Node Key("k0");
+        YAML::Node First = MakeIndexedMap(Key, 20);
+        YAML::Node Second = MakeIndexedMap(Key, 20);
+        Key = "renamed";
+        TestTrue(TEXT("First map sharing the key finds it"), First["renamed"].IsDefined());
+        TestTrue(TEXT("Second map sharing the key finds it"), Second["renamed"].IsDefined());
+    }
+
+    // a key that outlives the map that indexed it
+    {
+        YAML::Node Key("k0");
+        {
+            YAML::Node Map = MakeIndexedMap(Key, 20);
+            Map["renamed"];
+        }
+        YAML::Compact(Key);
+        Key = "renamed";
+        TestEqual(TEXT("Key outliving its map can be renamed"), Key.Scalar(), std::string("renamed"));
+    }
+
+    // entries removed from an indexed map
+    {
+        YAML::Node Map = MakeIndexedMap(YAML::Node("k0"), 40);
+        Map.force_insert("k30", "duplicate");
+        for (int32 i = 0; i < 40; i += 3) {
+            Map.remove("k" + std::to_string(i));
+        }
+        bool bFound = true;
+        for (int32 i = 1; i < 40; i++) {
+            if (i % 3 != 0) {
+                bFound = bFound && Map["k" + std::to_string(i)].as<int32>() == i;
+            }
+        }
+        TestTrue(TEXT("Entries after a removed one are still found"), bFound);
+        TestEqual(TEXT("Removing a duplicate key removes the first Entry"), Map["k30"].as<std::string>(),
+            std::string("duplicate"));
+        TestTrue(TEXT("Removed keys are gone"), !Map["k3"].IsDefined());
+        TestEqual(TEXT("Removed keys aren't counted"), Map.size(), std::size_t(40 - 14 + 1));
+        TestEqual(TEXT("Entries keep their Order"), Map.begin()->first.Scalar(), std::string("k1"));
+        Map["k3"] = 3;
+        TestEqual(TEXT("Keys added after a removal are found"), Map["k3"].as<int32>(), 3);
+        TestEqual(TEXT("Keys added after a removal are counted"), Map.size(), std::size_t(40 - 14 + 2));
+    }
+    return true;
+}
+
+namespace {
+    int32 CountEntries(const YAML::Node& Map) {
+        int32 Count = 0;
+        for (auto It = Map.begin(); It != Map.end(); ++It) {
+            Count++;
+        }
+        return Count;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlUndefinedEntriesTest, "UnrealYAML.Node.UndefinedEntries",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FYamlUndefinedEntriesTest::RunTest(const FString& Parameters) {
+    // a defined key made to refer to a node that is not defined
+    {
+        YAML::Node Other, Key, Map;
+        Map[Key] = "b";
+        TestEqual(TEXT("Entry with a null key counts"), Map.size(), std::size_t(1));
+        Key = Other["missing"];
+        TestEqual(TEXT("Entry with an undefined key is not counted"), Map.size(), std::size_t(0));
+        TestEqual(TEXT("Entry with an undefined key is not iterated"), CountEntries(Map), 0);
+        TestEqual(TEXT("Entry with an undefined key is not emitted"), YAML::Dump(Map), std::string("{}"));
+
+        Other["missing"] = "a";
+        TestEqual(TEXT("Entry counts again once its key is defined"), Map.size(), std::size_t(1));
+        TestEqual(TEXT("Entry is iterated again once its key is defined"), CountEntries(Map), 1);
+    }
+
+    // a defined key made to refer to a value that is not defined
+    {
+        YAML::Node Key, Map;
+        Map[Key] = "b";
+        YAML::Node Value = Map["b"];
+        Key = Value;
+        TestEqual(TEXT("Size skips the entry whose key became undefined"), Map.size(), std::size_t(0));
+        TestEqual(TEXT("Iteration agrees with the size"), CountEntries(Map), 0);
+    }
+
+    // a value of a nested map made undefined through a Node of its own
+    {
+        YAML::Node Document = YAML::Load("{inner: {a: 1, b: 2}}");
+        YAML::Node Value = Document["inner"]["a"];
+        YAML::Node Other;
+        Value = Other["missing"];
+        const YAML::Node Inner = Document["inner"];
+        TestEqual(TEXT("Nested map skips the entry whose value became undefined"), Inner.size(), std::size_t(1));
+        TestEqual(TEXT("Const iteration agrees with the size"), CountEntries(Inner), 1);
+        Other["missing"] = 3;
+        TestEqual(TEXT("Nested entry counts again once its value is defined"), Inner.size(), std::size_t(2));
+    }
+
+    // a value that refers to other defined Nodes before it becomes undefined
+    {
+        YAML::Node Map = YAML::Load("{a: 1, b: 2}");
+        Map["a"] = YAML::Node(5);
+        Map["a"] = YAML::Node("six");
+        YAML::Compact(Map);
+        YAML::Node Other;
+        Map["a"] = Other["missing"];
+        TestEqual(TEXT("Map still skips the entry after it moved twice"), Map.size(), std::size_t(1));
+        TestEqual(TEXT("Iteration agrees with the size"), CountEntries(Map), 1);
+    }
+
+    // a value of a map thawed from a Frozen Document
+    {
+        const YAML::FrozenDocument Frozen(YAML::Load("{a: 1, b: 2, c: 3}"));
+        YAML::Node Map = Frozen.Root().Thaw();
+        YAML::Node Value = Map["b"];
+        YAML::Node Other;
+        Value = Other["missing"];
+        TestEqual(TEXT("Thawed map skips the entry whose value became undefined"), Map.size(), std::size_t(2));
+        TestEqual(TEXT("Frozen Document keeps the value"), Frozen.Root().size(), std::size_t(3));
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlNodeTypeChangesTest, "UnrealYAML.Node.TypeChanges",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+// A Node only holds the Storage of its current Type, which is swapped whenever its Type changes
+bool FYamlNodeTypeChangesTest::RunTest(const FString& Parameters) {
+    AddInfo(FString::Printf(TEXT("%llu Bytes per node_data"), static_cast<uint64>(sizeof(YAML::detail::node_data))));
+
+    YAML::Node Node(YAML::NodeType::Null);
+    const YAML::Node Alias = Node;
+    Node.push_back(1);
+    Node.push_back("two");
+    TestTrue(TEXT("An empty Node becomes a Sequence"), Alias.IsSequence() && Alias.size() == 2);
+
+    Node = YAML::Null;
+    TestTrue(TEXT("A Sequence becomes Null"), Alias.IsNull() && Alias.size() == 0);
+
+    Node.SetTag("!custom");
+    Node["a"] = 1;
+    Node["b"] = "text";
+    TestTrue(TEXT("Null becomes a Map"), Alias.IsMap() && Alias.size() == 2);
+    TestEqual(TEXT("Map Values are kept"), Alias["b"].as<std::string>(), std::string("text"));
+    TestEqual(TEXT("The Tag survives a Change of Type in place"), Alias.Tag(), std::string("!custom"));
+
+    Node = "short";
+    TestEqual(TEXT("A Map becomes a Scalar"), Alias.Scalar(), std::string("short"));
+
+    const std::string Long(1000, 'x');
+    Node = Long;
+    TestEqual(TEXT("Long Scalars are kept in full"), Alias.Scalar(), Long);
+    Node = 3;
+    TestEqual(TEXT("Scalars can shrink again"), Alias.as<int32>(), 3);
+
+    const YAML::Node Loaded = YAML::Load("a:\n  b: 1\n");
+    TestEqual(TEXT("Loaded Nodes keep their Mark"), Loaded["a"]["b"].Mark().line, 1);
+    TestEqual(TEXT("Non-specific Tags are kept"), Loaded["a"]["b"].Tag(), std::string("?"));
+    TestEqual(TEXT("Every Type is emitted from its own Storage"), YAML::Dump(YAML::Load("[1, {a: b}, ~]")),
+        std::string("[1, {a: b}, ~]"));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlCachedScalarsTest, "UnrealYAML.Node.CachedScalars",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+// Scalars are resolved once and decoded from that Resolution until they change
+bool FYamlCachedScalarsTest::RunTest(const FString& Parameters) {
+    YAML::Node Node = YAML::Load("42");
+    const YAML::Node Alias = Node;
+    TestEqual(TEXT("Integers decode"), Alias.as<int32>(), 42);
+    TestEqual(TEXT("Integers decode as Floats as well"), Alias.as<double>(), 42.0);
+    TestEqual(TEXT("The Text stays as it was"), Alias.as<std::string>(), std::string("42"));
+    TestFalse(TEXT("Integers aren't Booleans"), Alias.as<bool>(false));
+
+    Node = "7";
+    TestEqual(TEXT("A new Scalar is resolved again"), Alias.as<int32>(), 7);
+
+    Node = "text";
+    TestEqual(TEXT("Failed Conversions fall back"), Alias.as<int32>(-1), -1);
+    TestEqual(TEXT("Failed Conversions leave nothing behind"), Alias.as<int32>(-2), -2);
+
+    Node = "1.5";
+    TestEqual(TEXT("Floats decode"), Alias.as<double>(), 1.5);
+    TestEqual(TEXT("Floats aren't Integers"), Alias.as<int32>(-1), -1);
+
+    Node = "18446744073709551615";
+    TestEqual(TEXT("Large unsigned Integers decode"), Alias.as<uint64>(), UINT64_MAX);
+    TestEqual(TEXT("Integers out of Range fall back"), Alias.as<int64>(-1), int64(-1));
+
+    Node = "true";
+    TestTrue(TEXT("Booleans decode"), Alias.as<bool>(false));
+    Node = YAML::Load("[1]");
+    TestEqual(TEXT("Sequences don't decode as Scalars"), Node.as<int32>(-1), -1);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlConcurrentReadsTest, "UnrealYAML.Node.ConcurrentReads",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+// Const Nodes only fill in Caches that are published atomically, so Threads may read one Document at once
+bool FYamlConcurrentReadsTest::RunTest(const FString& Parameters) {
+    std::string Text = "values:\n";
+    for (int32 i = 0; i < 64; i++) {
+        Text += "  k" + std::to_string(i) + ": " + std::to_string(i) + "\n";
+    }
+    Text += "list: [";
+    for (int32 i = 0; i < 64; i++) {
+        Text += std::to_string(i) + ", ";
+    }
+    Text += "]";
+
+    // nothing is read before the Threads start, so they all find the Caches empty
+    const YAML::Node Document = YAML::Load(Text);
+    std::atomic<int32> Mismatches(0);
+    ParallelFor(16, [&](const int32 Task) {
+        const YAML::Node Values = Document["values"];
+        const YAML::Node List = Document["list"];
+        int64 Sum = 0;
+        for (int32 i = 0; i < 64; i++) {
+            Sum += Values["k" + std::to_string(i)].as<int64>() + List[i].as<int64>();
+        }
+        if (List.size() != 64 || Sum != 2 * 2016) {
+            Mismatches++;
+        }
+    });
+    TestEqual(TEXT("Every Thread reads the same Values"), Mismatches.load(), 0);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlRepeatedReadsBenchmark, "UnrealYAML.Benchmark.RepeatedReads",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+// Reading the same Values again, as Gameplay Code does every Frame, should only check and load the Resolution
+bool FYamlRepeatedReadsBenchmark::RunTest(const FString& Parameters) {
+    const YAML::Node Config = YAML::Load("{speed: 1.5, count: 3}");
+    const YAML::Node Speed = Config["speed"];
+    const YAML::Node Count = Config["count"];
+    const int32 Reads = 1000000;
+
+    double Start = FPlatformTime::Seconds();
+    double Sum = 0;
+    for (int32 i = 0; i < Reads; i++) {
+        Sum += Speed.as<double>() + Count.as<int32>();
+    }
+    const double Repeated = FPlatformTime::Seconds() - Start;
+
+    YAML::Node Changing = YAML::Load("0");
+    Start = FPlatformTime::Seconds();
+    for (int32 i = 0; i < Reads / 10; i++) {
+        Changing = "123456";
+        Sum += Changing.as<int32>();
+    }
+    const double First = FPlatformTime::Seconds() - Start;
+
+    AddInfo(FString::Printf(TEXT("Repeated Reads %.1f ns, first Read after a Change %.1f ns (%.0f)"),
+        Repeated * 1e9 / (Reads * 2), First * 1e9 / (Reads / 10), Sum));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlUndefinedEntriesBenchmark, "UnrealYAML.Benchmark.UndefinedEntries",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+// Only the Maps that hold a Value count their Entries again when it becomes undefined, not the whole Document
+bool FYamlUndefinedEntriesBenchmark::RunTest(const FString& Parameters) {
+    const int32 Count = 5000;
+    YAML::Node Document;
+    std::vector<YAML::Node> Values;
+    for (int32 i = 0; i < Count; i++) {
+        YAML::Node Entry = Document["k" + std::to_string(i)];
+        for (int32 j = 0; j < 10; j++) {
+            Entry["v" + std::to_string(j)] = j;
+        }
+        Values.push_back(Entry["v0"]);
+    }
+
+    YAML::Node Other;
+    const double Start = FPlatformTime::Seconds();
+    for (int32 i = 0; i < Count; i++) {
+        Values[i] = Other["missing"];
+    }
+    const double Elapsed = FPlatformTime::Seconds() - Start;
+
+    TestEqual(TEXT("Every Map skips its undefined Entry"), Document["k0"].size(), std::size_t(9));
+    AddInfo(FString::Printf(TEXT("%.2f us per Value that becomes undefined, in a Document of %d Maps"),
+        Elapsed * 1e6 / Count, Count));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlNodeTraversalBenchmark, "UnrealYAML.Benchmark.NodeTraversal",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+// Every Node handed out by a Lookup or an Iterator holds its Document, so Traversals are dominated by Reference Counts
+bool FYamlNodeTraversalBenchmark::RunTest(const FString& Parameters) {
+    YAML::Node Document;
+    for (int32 i = 0; i < 2000; i++) {
+        YAML::Node Value = Document["k" + std::to_string(i)];
+        Value["id"] = i;
+        Value["tags"].push_back(i);
+    }
+    const YAML::Node& Root = Document;
+    const int32 Passes = 50;
+
+    double Start = FPlatformTime::Seconds();
+    int64 Sum = 0;
+    for (int32 Pass = 0; Pass < Passes; Pass++) {
+        for (auto It = Root.begin(); It != Root.end(); ++It) {
+            const YAML::Node Value = It->second;
+            Sum += Value["tags"][0].as<int64>();
+        }
+    }
+    const double Iteration = FPlatformTime::Seconds() - Start;
+
+    Start = FPlatformTime::Seconds();
+    for (int32 Pass = 0; Pass < Passes; Pass++) {
+        std::vector<YAML::Node> Copies(2000, Root);
+        Sum += Copies.back().size();
+    }
+    const double Copying = FPlatformTime::Seconds() - Start;
+
+    AddInfo(FString::Printf(TEXT("Iteration with nested Lookups %.1f ns per Entry, %.1f ns per Node Copy (%lld)"),
+        Iteration * 1e9 / (Passes * 2000), Copying * 1e9 / (Passes * 2000), Sum));
+    return true;
+}
+
+#endif
@@ -0,0 +1,169 @@
+﻿#include "Misc/AutomationTest.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+#include "yaml.h"
+
+#include <atomic>
+#include <map>
+#include <vector>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace {
+    // Every Entry holds a small Map with a Sequence, so Walks go through all three Kinds of Nodes
+    YAML::Node MakeDocument(const int32 Count) {
+        YAML::Node Root;
+        for (int32 i = 0; i < Count; i++) {
+            YAML::Node Value;
+            Value["id"] = i;
+            Value["name"] = "entry" + std::to_string(i);
+            for (int32 j = 0; j < 4; j++) {
+                Value["tags"].push_back(i * 4 + j);
+            }
+            Root["k" + std::to_string(i)] = Value;
+        }
+        return Root;
+    }
+
+    // Sums everything below the View, visiting each Node once
+    int64 Walk(const YAML::NodeView& View) {
+        if (View.IsScalar()) {
+            return static_cast<int64>(View.ScalarSize()) + View.as<int64>(0);
+        }
+        int64 Sum = 0;
+        for (const auto Entry : View) {
+            if (Entry.first) {
+                Sum += Walk(Entry.first);
+            }
+            Sum += Walk(Entry.second);
+        }
+        return Sum;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlNodeViewEntriesTest, "UnrealYAML.NodeView.Entries",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FYamlNodeViewEntriesTest::RunTest(const FString& Parameters) {
+    YAML::Node Map = YAML::Load("{a: 1, b: [x, y], c: {d: 2}}");
+    YAML::Node Missing = Map["missing"];
+    const YAML::Node& ConstMap = Map;
+    const YAML::NodeView View(ConstMap);
+
+    TestEqual(TEXT("Undefined Entries are not counted"), View.size(), std::size_t(3));
+    std::string Keys;
+    for (const auto Entry : View) {
+        Keys += Entry.first.Scalar();
+    }
+    TestEqual(TEXT("Iteration skips undefined Entries"), Keys, std::string("abc"));
+    TestEqual(TEXT("entry_at() skips undefined Entries"), View.entry_at(2).first.Scalar(), std::string("c"));
+    TestEqual(TEXT("value_at() agrees with entry_at()"), View.value_at(1)[1].Scalar(), std::string("y"));
+    TestFalse(TEXT("entry_at() past the End is undefined"), View.entry_at(3).second.IsDefined());
+
+    Missing = 3;
+    TestEqual(TEXT("Defined Entries are counted"), View.size(), std::size_t(4));
+    TestEqual(TEXT("Defined Entries are found by Position"), View.key_at(3).Scalar(), std::string("missing"));
+
+    std::string Elements;
+    for (const auto Entry : View["b"]) {
+        TestFalse(TEXT("Sequence Elements have no Key"), Entry.first.IsDefined());
+        Elements += Entry.second.Scalar();
+    }
+    TestEqual(TEXT("Sequences iterate their Elements"), Elements, std::string("xy"));
+
+    // read from the Document a thawed Copy shares
+    const YAML::FrozenDocument Frozen(Map);
+    const YAML::Node Thawed = Frozen.Root().Thaw();
+    TestEqual(TEXT("Frozen Entries iterate like live ones"), Walk(YAML::NodeView(Thawed)), Walk(View));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlNodeViewConcurrencyTest, "UnrealYAML.NodeView.ConcurrentReads",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::StressFilter)
+
+// Meant to run under a Thread Sanitizer as well: Views of one Document are read from many Threads at once
+bool FYamlNodeViewConcurrencyTest::RunTest(const FString& Parameters) {
+    const YAML::Node Document = MakeDocument(2000);
+    const YAML::FrozenDocument Frozen(Document);
+    const YAML::Node Thawed = Frozen.Root().Thaw();
+    const YAML::NodeView Views[] = {YAML::NodeView(Document), YAML::NodeView(Thawed)};
+
+    YAML::Node Settings;
+    for (int32 i = 0; i < 64; i++) {
+        Settings["s" + std::to_string(i)] = i;
+    }
+    const YAML::FrozenDocument FrozenSettings(Settings);
+    const YAML::Node ThawedSettings = FrozenSettings.Root().Thaw();
+    const YAML::NodeView SettingsViews[] = {YAML::NodeView(Settings), YAML::NodeView(ThawedSettings)};
+
+    const int64 Expected = Walk(Views[0]);
+    std::atomic<int32> Mismatches(0);
+    ParallelFor(16, [&](const int32 Task) {
+        const YAML::NodeView& View = Views[Task % 2];
+        for (int32 Pass = 0; Pass < 4; Pass++) {
+            if (Walk(View) != Expected) {
+                Mismatches++;
+            }
+            for (int32 i = Task; i < 2000; i += 16) {
+                const YAML::NodeView Value = View["k" + std::to_string(i)];
+                if (Value["id"].as<int32>(-1) != i || Value["tags"][3].as<int32>(-1) != i * 4 + 3) {
+                    Mismatches++;
+                }
+
+                // Containers are decoded by walking the View, anything else from a private Copy
+                const std::vector<int32> Tags = Value["tags"].as<std::vector<int32>>(std::vector<int32>());
+                if (Tags.size() != 4 || Tags[3] != i * 4 + 3) {
+                    Mismatches++;
+                }
+                if (Value.as<YAML::Node>(YAML::Node())["id"].as<int32>(-1) != i) {
+                    Mismatches++;
+                }
+            }
+
+            const std::map<std::string, int32> Decoded =
+                SettingsViews[Task % 2].as<std::map<std::string, int32>>(std::map<std::string, int32>());
+            if (Decoded.size() != 64 || Decoded.at("s63") != 63) {
+                Mismatches++;
+            }
+        }
+    });
+    TestEqual(TEXT("Concurrent Readers see the same Document"), Mismatches.load(), 0);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlNodeViewBenchmark, "UnrealYAML.Benchmark.NodeViewWalk",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+// Walking a Map by Position, by Iterator and through Node should all grow linearly with its Size
+bool FYamlNodeViewBenchmark::RunTest(const FString& Parameters) {
+    for (const int32 Count : {1000, 4000, 16000}) {
+        const YAML::Node Document = MakeDocument(Count);
+        const YAML::NodeView View(Document);
+
+        double Start = FPlatformTime::Seconds();
+        int64 Sum = 0;
+        for (std::size_t i = 0; i < View.size(); i++) {
+            Sum += View.value_at(i)["id"].as<int64>(0);
+        }
+        const double ByPosition = FPlatformTime::Seconds() - Start;
+
+        Start = FPlatformTime::Seconds();
+        for (const auto Entry : View) {
+            Sum += Entry.second["id"].as<int64>(0);
+        }
+        const double ByIterator = FPlatformTime::Seconds() - Start;
+
+        Start = FPlatformTime::Seconds();
+        for (auto It = Document.begin(); It != Document.end(); ++It) {
+            Sum += It->second["id"].as<int64>(0);
+        }
+        const double ByNode = FPlatformTime::Seconds() - Start;
+
+        AddInfo(FString::Printf(TEXT("%d Entries: value_at %.1f ns, Iterator %.1f ns, Node %.1f ns per Entry (%lld)"),
+            Count, ByPosition * 1e9 / Count, ByIterator * 1e9 / Count, ByNode * 1e9 / Count, Sum));
+    }
+    return true;
+}
+
+#endif
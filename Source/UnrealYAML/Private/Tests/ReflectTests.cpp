@@ -0,0 +1,134 @@
+﻿#include "Misc/AutomationTest.h"
+
+#include "HAL/PlatformTime.h"
+#include "yaml.h"
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UnrealYAMLReflectTests {
+    struct FSpawn {
+        std::string Name;
+        int32 Count = 1;
+        std::vector<float> At;
+    };
+
+    struct FWave {
+        std::string Id;
+        std::vector<FSpawn> Spawns;
+        std::map<std::string, int32> Weights;
+        std::pair<int32, int32> Range;
+        double Delay = 0;
+        bool bLooping = false;
+        FSpawn Boss;
+    };
+
+    // More Fields than fit in one Bucket of the Key Hash
+    struct FWide {
+        int32 A0 = 0, A1 = 0, A2 = 0, A3 = 0, A4 = 0, A5 = 0, A6 = 0, A7 = 0, A8 = 0, A9 = 0;
+        int32 B0 = 0, B1 = 0, B2 = 0, B3 = 0, B4 = 0, B5 = 0, B6 = 0, B7 = 0, B8 = 0, B9 = 0;
+    };
+}
+
+YAML_CPP_REFLECT(UnrealYAMLReflectTests::FSpawn, Name, Count, At)
+YAML_CPP_REFLECT(UnrealYAMLReflectTests::FWave, Id, Spawns, Weights, Range, Delay, bLooping, Boss)
+YAML_CPP_REFLECT(UnrealYAMLReflectTests::FWide, A0, A1, A2, A3, A4, A5, A6, A7, A8, A9,
+    B0, B1, B2, B3, B4, B5, B6, B7, B8, B9)
+
+using namespace UnrealYAMLReflectTests;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlReflectTest, "UnrealYAML.Reflect.Structs",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FYamlReflectTest::RunTest(const FString& Parameters) {
+    const YAML::Node Node = YAML::Load(
+        "Id: first\n"
+        "Spawns: [{Name: orc, Count: 3, At: [1, 2.5]}, {Name: troll}]\n"
+        "Weights: {orc: 2, troll: 1}\n"
+        "Range: [4, 8]\n"
+        "Delay: 0.5\n"
+        "bLooping: true\n"
+        "Boss: {Name: dragon, At: [0, 0, 10]}\n"
+        "Unknown: ignored\n");
+
+    FWave Wave;
+    TestTrue(TEXT("Reflected Structs decode"), Node.TryDecode(Wave));
+    TestEqual(TEXT("Strings decode"), Wave.Id, std::string("first"));
+    TestTrue(TEXT("Sequences of reflected Structs decode"), Wave.Spawns.size() == 2 && Wave.Spawns[0].Count == 3);
+    TestEqual(TEXT("Fields without a Key keep their Value"), Wave.Spawns[1].Count, 1);
+    TestTrue(TEXT("Maps decode"), Wave.Weights.size() == 2 && Wave.Weights["orc"] == 2);
+    TestTrue(TEXT("Converted Types decode"), Wave.Range == std::make_pair(4, 8));
+    TestTrue(TEXT("Scalars decode"), Wave.Delay == 0.5 && Wave.bLooping);
+    TestEqual(TEXT("Nested reflected Structs decode"), Wave.Boss.At.back(), 10.f);
+
+    YAML::Emitter Emitter;
+    Emitter << Wave;
+    const FWave Emitted = YAML::Load(Emitter.c_str()).as<FWave>();
+    TestTrue(TEXT("Emitted Structs load back"), Emitted.Id == Wave.Id && Emitted.Spawns.size() == 2 &&
+        Emitted.Spawns[0].At == Wave.Spawns[0].At && Emitted.Weights == Wave.Weights && Emitted.Range == Wave.Range &&
+        Emitted.Boss.Name == Wave.Boss.Name);
+    TestTrue(TEXT("Nodes of Structs load back"), YAML::Node(Wave)["Boss"]["Name"].as<std::string>() == "dragon");
+
+    FSpawn Spawn;
+    TestFalse(TEXT("Fields that don't convert fail the Decode"), YAML::Load("{Count: many}").TryDecode(Spawn));
+    TestFalse(TEXT("Only Maps decode"), YAML::Load("[orc, 3]").TryDecode(Spawn));
+
+    FWide Wide;
+    TestTrue(TEXT("Every Key finds its Field"), YAML::Load("{A0: 1, A9: 2, B0: 3, B9: 4, B5: 5}").TryDecode(Wide));
+    TestTrue(TEXT("Keys go to their own Field"),
+        Wide.A0 == 1 && Wide.A9 == 2 && Wide.B0 == 3 && Wide.B9 == 4 && Wide.B5 == 5 && Wide.A5 == 0);
+    TestTrue(TEXT("Keys that are almost Fields are ignored"), YAML::Load("{A: 1, A10: 2, a0: 3}").TryDecode(Wide));
+    TestEqual(TEXT("Ignored Keys change nothing"), Wide.A0, 1);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlReflectBenchmark, "UnrealYAML.Benchmark.Reflect",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+// Reflected Decoding walks each Map once, against one Lookup per Field. Each Way reads its own Copy of the Document,
+// since Scalars keep what they were resolved to
+bool FYamlReflectBenchmark::RunTest(const FString& Parameters) {
+    const int32 Count = 20000;
+    std::string Text;
+    for (int32 i = 0; i < Count; i++) {
+        Text += "- {Name: spawn" + std::to_string(i) + ", Count: " + std::to_string(i) + ", At: [1, 2, 3]}\n";
+    }
+    const YAML::Node Sequence = YAML::Load(Text);
+    const YAML::Node Copy = YAML::Load(Text);
+
+    double Start = FPlatformTime::Seconds();
+    int64 Sum = 0;
+    for (const YAML::Node Element : Sequence) {
+        Sum += Element.as<FSpawn>().Count;
+    }
+    const double Reflected = FPlatformTime::Seconds() - Start;
+
+    Start = FPlatformTime::Seconds();
+    for (const YAML::Node Element : Copy) {
+        FSpawn Spawn;
+        Spawn.Name = Element["Name"].as<std::string>();
+        Spawn.Count = Element["Count"].as<int32>();
+        Spawn.At = Element["At"].as<std::vector<float>>();
+        Sum += Spawn.Count;
+    }
+    const double ByKey = FPlatformTime::Seconds() - Start;
+
+    Start = FPlatformTime::Seconds();
+    YAML::Emitter Emitter;
+    Emitter << YAML::EmitterManip::BeginSeq;
+    for (int32 i = 0; i < Count; i++) {
+        Emitter << FSpawn{"spawn", i, {1.f}};
+    }
+    Emitter << YAML::EmitterManip::EndSeq;
+    const double Emit = FPlatformTime::Seconds() - Start;
+
+    AddInfo(FString::Printf(TEXT("Reflected %.1f ns, by Key %.1f ns, emitted %.1f ns per Struct (%lld)"),
+        Reflected * 1e9 / Count, ByKey * 1e9 / Count, Emit * 1e9 / Count, Sum));
+    return true;
+}
+
+#endif
@@ -0,0 +1,306 @@
+﻿#include "Misc/AutomationTest.h"
+
+#include "Engine/EngineTypes.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryWriter.h"
+#include "Node.h"
+#include "NodeHelpers.h"
+#include "Parsing.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlPushBenchmark, "UnrealYAML.Benchmark.Push",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+// Every pushed Element starts out as a Document of its own, which Push merges into the Document of the Sequence.
+// Merging takes near constant Time, so the Time per Element should stay flat while the Sequence grows
+bool FYamlPushBenchmark::RunTest(const FString& Parameters) {
+    FYamlNode Sequence(EYamlNodeType::Sequence);
+
+    double Last = FPlatformTime::Seconds();
+    for (int32 i = 1; i <= 100000; i++) {
+        FYamlNode Element(EYamlNodeType::Map);
+        Element["id"] = i;
+        Sequence.Push(Element);
+
+        if (i % 25000 == 0) {
+            const double Now = FPlatformTime::Seconds();
+            AddInfo(FString::Printf(TEXT("%d Elements: %.1f ns per Element for the last 25000"),
+                i, (Now - Last) * 1e9 / 25000));
+            Last = Now;
+        }
+    }
+
+    TestEqual(TEXT("Every Element is pushed"), Sequence.Size(), 100000);
+    TestEqual(TEXT("Pushed Elements keep their Values"), Sequence[99999]["id"].As<int32>(), 100000);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlNodeCompactTest, "UnrealYAML.YamlNode.Compact",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FYamlNodeCompactTest::RunTest(const FString& Parameters) {
+    FYamlNode Document(EYamlNodeType::Map);
+    for (int32 i = 0; i < 100; i++) {
+        Document["items"].Push(i);
+    }
+    Document.Remove("items");
+    Document["kept"] = 1;
+
+    const int64 Held = Document.GetNodeCount();
+    TestEqual(TEXT("Removed Nodes are counted until compacted"), Held, Document.GetMemoryUsage().Nodes());
+    TestTrue(TEXT("Removed Nodes are reclaimed"), Document.Compact() > 0);
+    TestTrue(TEXT("Reclaimed Nodes are no longer counted"), Document.GetNodeCount() < Held);
+    TestEqual(TEXT("Reachable Values survive"), Document["kept"].As<int32>(), 1);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlNodePendingErrorTest, "UnrealYAML.YamlNode.PendingError",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+// FYamlNode checks its Operations for Errors, but leaves an Error of the Caller to the Caller
+bool FYamlNodePendingErrorTest::RunTest(const FString& Parameters) {
+    FYamlNode Node;
+    UYamlParsing::ParseYaml(TEXT("{a: 1, b: [1, 2]}"), Node);
+    YAML::ClearError();
+
+    YAML::Load("a: [1, 2\nb: 3");
+    TestEqual(TEXT("Wrappers still work with an Error pending"), Node["b"].Size(), 2);
+    TestEqual(TEXT("Wrappers still read Scalars with an Error pending"), Node["a"].Scalar(), FString(TEXT("1")));
+    TestTrue(TEXT("Successful Wrappers keep the pending Error"), YAML::TakeError().code == YAML::ErrorCode::Parser);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlNodeScalarTypeTest, "UnrealYAML.YamlNode.ScalarType",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+// Numeric Properties are only set from Scalars that resolve to a Number, Integer Properties only from Integers
+bool FYamlNodeScalarTypeTest::RunTest(const FString& Parameters) {
+    FYamlNode Node;
+    UYamlParsing::ParseYaml(TEXT("[~, true, -12, 0x1F, 2.5, .inf, text, '12 ', [1]]"), Node);
+    const EYamlScalarType Expected[] = {EYamlScalarType::Null, EYamlScalarType::Bool, EYamlScalarType::Int,
+        EYamlScalarType::Int, EYamlScalarType::Float, EYamlScalarType::Float, EYamlScalarType::String,
+        EYamlScalarType::String, EYamlScalarType::String};
+    for (int32 i = 0; i < UE_ARRAY_COUNT(Expected); i++) {
+        TestEqual(*FString::Printf(TEXT("Element %d resolves to its Type"), i), Node[i].ScalarType(), Expected[i]);
+    }
+    TestEqual(TEXT("The Helper resolves too"), UYamlNodeHelpers::ScalarType(Node[2]), EYamlScalarType::Int);
+
+    FYamlNode Changed(FString(TEXT("7")));
+    TestEqual(TEXT("Scalars are resolved"), Changed.ScalarType(), EYamlScalarType::Int);
+    Changed = FString(TEXT("seven"));
+    TestEqual(TEXT("Assigned Scalars are resolved again"), Changed.ScalarType(), EYamlScalarType::String);
+
+    // FHitResult has an int32, a float and a bool UPROPERTY
+    UScriptStruct* Struct = FHitResult::StaticStruct();
+    const auto ParseInto = [Struct](const TCHAR* Name, const TCHAR* Yaml, FHitResult& Hit) {
+        FYamlNode Value;
+        UYamlParsing::ParseYaml(Yaml, Value);
+        const FProperty& Property = *Struct->FindPropertyByName(Name);
+        return UYamlParsing::ParseIntoProperty(Value, Property, Property.ContainerPtrToValuePtr<void>(&Hit));
+    };
+
+    FHitResult Hit;
+    Hit.FaceIndex = -1;
+    ParseInto(TEXT("FaceIndex"), TEXT("0x1F"), Hit);
+    TestEqual(TEXT("Integer Properties take Hexadecimal"), Hit.FaceIndex, 31);
+    ParseInto(TEXT("FaceIndex"), TEXT("-012"), Hit);
+    TestEqual(TEXT("Integer Properties take negative decimal Values"), Hit.FaceIndex, -12);
+    ParseInto(TEXT("FaceIndex"), TEXT("1.5"), Hit);
+    TestEqual(TEXT("Integer Properties ignore Floats"), Hit.FaceIndex, -12);
+    ParseInto(TEXT("FaceIndex"), TEXT("'12 '"), Hit);
+    TestEqual(TEXT("Integer Properties ignore Text"), Hit.FaceIndex, -12);
+
+    ParseInto(TEXT("Time"), TEXT("0.25"), Hit);
+    TestEqual(TEXT("Float Properties take Floats"), Hit.Time, 0.25f);
+    ParseInto(TEXT("Time"), TEXT("2"), Hit);
+    TestEqual(TEXT("Float Properties take Integers"), Hit.Time, 2.f);
+    ParseInto(TEXT("Time"), TEXT("true"), Hit);
+    TestEqual(TEXT("Float Properties ignore Booleans"), Hit.Time, 2.f);
+
+    Hit.bBlockingHit = false;
+    ParseInto(TEXT("bBlockingHit"), TEXT("true"), Hit);
+    TestTrue(TEXT("Bool Properties take Booleans"), static_cast<bool>(Hit.bBlockingHit));
+    ParseInto(TEXT("bBlockingHit"), TEXT("off"), Hit);
+    TestFalse(TEXT("Bool Properties take YAML 1.1 Names"), static_cast<bool>(Hit.bBlockingHit));
+    ParseInto(TEXT("bBlockingHit"), TEXT("1"), Hit);
+    TestFalse(TEXT("Bool Properties ignore Numbers"), static_cast<bool>(Hit.bBlockingHit));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlNodeNumberArraysTest, "UnrealYAML.YamlNode.NumberArrays",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+// Sequences of Numbers are decoded into TArrays in one Pass, anything else Element by Element
+bool FYamlNodeNumberArraysTest::RunTest(const FString& Parameters) {
+    FYamlNode Numbers;
+    TestTrue(TEXT("The Numbers parse"), UYamlParsing::ParseYaml(TEXT("[1, 2.5, -3e2, 0x10]"), Numbers));
+
+    TArray<float> Floats;
+    TestTrue(TEXT("AsFloatArray decodes Numbers"), UYamlNodeHelpers::AsFloatArray(Numbers, {}, Floats));
+    TestTrue(TEXT("Every Float is decoded"), Floats == TArray<float>({1.f, 2.5f, -300.f, 16.f}));
+
+    TArray<int32> Integers = {7};
+    TestFalse(TEXT("Floats aren't Integers"), Numbers.TryAs(Integers));
+    TestTrue(TEXT("A failed Decode leaves the Array unchanged"), Integers == TArray<int32>({7}));
+
+    FYamlNode Mixed;
+    UYamlParsing::ParseYaml(TEXT("[1, a, 3]"), Mixed);
+    TArray<FString> Strings;
+    TestTrue(TEXT("Mixed Sequences decode as Strings"), Mixed.TryAs(Strings));
+    TestEqual(TEXT("Strings are decoded Element by Element"), Strings[1], FString(TEXT("a")));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlNodeColorsTest, "UnrealYAML.YamlNode.Colors",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+// Colors are decoded from their Name or from 3 or 4 Channels, without Alpha they are opaque
+bool FYamlNodeColorsTest::RunTest(const FString& Parameters) {
+    FYamlNode Colors;
+    UYamlParsing::ParseYaml(TEXT("[Red, [1, 2, 3], [1, 2, 3, 4], [1, 2], [1, 2, 300]]"), Colors);
+
+    FColor Color;
+    TestTrue(TEXT("Named Colors decode"), Colors[0].TryAs(Color) && Color == FColor::Red);
+    TestTrue(TEXT("3 Channels decode"), Colors[1].TryAs(Color));
+    TestTrue(TEXT("Colors without Alpha are opaque"), Color == FColor(1, 2, 3, 255));
+    TestFalse(TEXT("Colors without Alpha no longer get an Alpha of 1"), Color == FColor(1, 2, 3, 1));
+    TestTrue(TEXT("4 Channels decode"), Colors[2].TryAs(Color));
+    TestTrue(TEXT("Alpha is the 4th Channel"), Color == FColor(1, 2, 3, 4));
+    TestFalse(TEXT("2 Channels aren't a Color"), Colors[3].TryAs(Color));
+    TestFalse(TEXT("Channels must fit a Byte"), Colors[4].TryAs(Color));
+
+    FLinearColor Linear;
+    TestTrue(TEXT("Linear Colors decode"), Colors[1].TryAs(Linear));
+    TestEqual(TEXT("Linear Colors without Alpha are opaque"), Linear.A, 1.f);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlNodeDecodeIntoTest, "UnrealYAML.YamlNode.DecodeInto",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+// The Helpers decode straight into their Output, which keeps its Allocation
+bool FYamlNodeDecodeIntoTest::RunTest(const FString& Parameters) {
+    FYamlNode Node;
+    UYamlParsing::ParseYaml(TEXT("{a: 1.5, b: 2, c: -3}"), Node);
+
+    TMap<FString, float> Map;
+    Map.Reserve(64);
+    Map.Add(TEXT("old"), 1.f);
+    const SIZE_T Allocated = Map.GetAllocatedSize();
+    TestTrue(TEXT("AsStringFloatMap decodes"), UYamlNodeHelpers::AsStringFloatMap(Node, {}, Map));
+    TestEqual(TEXT("Old Entries are gone"), Map.Num(), 3);
+    TestEqual(TEXT("Values are decoded"), Map.FindRef(TEXT("a")), 1.5f);
+    TestEqual(TEXT("The Map keeps its Allocation"), Map.GetAllocatedSize(), Allocated);
+
+    TMap<FString, float> Default = {{TEXT("default"), 0.f}};
+    TMap<FString, float> Value;
+    const FYamlNode Text(FString(TEXT("text")));
+    TestFalse(TEXT("Scalars aren't Maps"), UYamlNodeHelpers::AsStringFloatMap(Text, Default, Value));
+    TestTrue(TEXT("A failed Decode yields the Default"), Value.Num() == 1 && Value.Contains(TEXT("default")));
+
+    TestTrue(TEXT("The Default may be the Value itself"), UYamlNodeHelpers::AsStringFloatMap(Node, Default, Default));
+    TestEqual(TEXT("The Default is overwritten"), Default.Num(), 3);
+
+    TArray<int32> Array;
+    Array.Reserve(32);
+    FYamlNode Sequence;
+    UYamlParsing::ParseYaml(TEXT("[1, 2, 3]"), Sequence);
+    TestTrue(TEXT("DecodeInto fills an Array"), Sequence.DecodeInto(Array));
+    TestTrue(TEXT("The Array keeps its Capacity"), Array.Num() == 3 && Array.Max() >= 32);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlNodeTryAsTest, "UnrealYAML.YamlNode.TryAs",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FYamlNodeTryAsTest::RunTest(const FString& Parameters) {
+    FYamlNode Node;
+    UYamlParsing::ParseYaml(TEXT("{count: 3, name: abc, list: [1.5]}"), Node);
+
+    int32 Count = -1;
+    TestTrue(TEXT("TryAs converts"), Node["count"].TryAs(Count) && Count == 3);
+    TestFalse(TEXT("TryAs reports a Mismatch"), Node["name"].TryAs(Count));
+    TestEqual(TEXT("A Mismatch leaves the Value alone"), Count, 3);
+    TestFalse(TEXT("CanConvertTo reports a Mismatch"), Node["name"].CanConvertTo<float>());
+    TestFalse(TEXT("AsOptional is empty for a Mismatch"), Node["name"].AsOptional<int32>().IsSet());
+
+    FString Name;
+    TestTrue(TEXT("TryGet reads the Value at a Key"), Node.TryGet("name", Name) && Name == TEXT("abc"));
+    float First = 0;
+    const FYamlNode List = Node["list"];
+    TestTrue(TEXT("TryGet reads the Value at an Index"), List.TryGet(0, First) && First == 1.5f);
+    TestFalse(TEXT("TryGet reports missing Keys"), Node.TryGet("missing", Count));
+    TestEqual(TEXT("TryGet doesn't add missing Keys"), Node.Size(), 3);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlNodeJsonTest, "UnrealYAML.YamlNode.Json",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FYamlNodeJsonTest::RunTest(const FString& Parameters) {
+    FYamlNode Node;
+    UYamlParsing::ParseYaml(TEXT("{a: 1, b: [x, true, ~], c: \"2\"}"), Node);
+
+    TestEqual(TEXT("Minimal JSON"), Node.GetContentAsJson(),
+        FString(TEXT("{\"a\":1,\"b\":[\"x\",true,null],\"c\":\"2\"}")));
+    TestEqual(TEXT("Negative Indents are minimal"), Node.GetContentAsJson(-1), Node.GetContentAsJson());
+    TestEqual(TEXT("Pretty JSON"), Node["b"].GetContentAsJson(2),
+        FString(TEXT("[\n  \"x\",\n  true,\n  null\n]")));
+
+    FYamlNode Parsed;
+    TestTrue(TEXT("The JSON parses back"), UYamlParsing::ParseYaml(Node.GetContentAsJson(4), Parsed));
+    TestEqual(TEXT("The JSON keeps the Values"), Parsed.GetContentAsJson(), Node.GetContentAsJson());
+
+    FYamlJsonEmitter Emitter;
+    Emitter << YAML::EmitterManip::BeginSeq << 1 << "two" << YAML::EmitterManip::EndSeq;
+    TestEqual(TEXT("FYamlJsonEmitter writes JSON"), FString(UTF8_TO_TCHAR(Emitter.c_str())),
+        FString(TEXT("[1,\"two\"]")));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYamlNodeArchiveSinkTest, "UnrealYAML.YamlNode.ArchiveSink",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+// Emitters write into Archives through FYamlArchiveSink, and WriteYamlToFile streams Files as UTF-8 that way
+bool FYamlNodeArchiveSinkTest::RunTest(const FString& Parameters) {
+    FYamlNode Node(EYamlNodeType::Map);
+    for (int32 i = 0; i < 5000; i++) {
+        Node[FString::Printf(TEXT("key%d"), i)] = FString::Printf(TEXT("Wert %d \u00e4\u00f6\u00fc"), i);
+    }
+
+    TArray<uint8> Bytes;
+    {
+        FMemoryWriter Writer(Bytes);
+        FYamlArchiveSink Sink(Writer);
+        FYamlEmitter Emitter(Sink, 1024);
+        Emitter << "short";
+        TestEqual(TEXT("Short Output waits in the Buffer"), Bytes.Num(), 0);
+        Emitter.Flush();
+        TestEqual(TEXT("Flushed Output reaches the Archive"), Bytes.Num(), 5);
+    }
+
+    Bytes.Reset();
+    {
+        FMemoryWriter Writer(Bytes);
+        FYamlArchiveSink Sink(Writer);
+        FYamlEmitter Emitter(Sink, 1024);
+        Emitter << Node;
+    }
+    const FTCHARToUTF8 Expected(*Node.GetContent());
+    TestEqual(TEXT("The Archive gets the UTF-8 Text"), Bytes.Num(), Expected.Length());
+    TestTrue(TEXT("Byte for Byte"), FMemory::Memcmp(Bytes.GetData(), Expected.Get(), Expected.Length()) == 0);
+
+    const FString Path = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("ArchiveSink.yaml"));
+    UYamlParsing::WriteYamlToFile(Path, Node);
+    TestEqual(TEXT("The File is UTF-8"), IFileManager::Get().FileSize(*Path), int64(Expected.Length()));
+    FYamlNode Loaded;
+    TestTrue(TEXT("The File loads"), UYamlParsing::LoadYamlFromFile(Path, Loaded));
+    TestEqual(TEXT("The File keeps the Content"), Loaded.GetContent(), Node.GetContent());
+    IFileManager::Get().Delete(*Path);
+    return true;
+}
+
+#endif
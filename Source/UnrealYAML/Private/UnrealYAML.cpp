@@ -1,3 +1,34 @@
 ﻿#include "UnrealYAML.h"
 
+#include "HAL/IConsoleManager.h"
+#include "Node.h"
+
 IMPLEMENT_MODULE(FUnrealYAMLModule, UnrealYAML)
+
+
+// Tracking locks a Mutex for every Document that is loaded and destroyed, so it is off unless this is set, e.g. from
+// the ConsoleVariables Section of an Ini File to track Documents from the Start
+static TAutoConsoleVariable<bool> CVarYamlTrackDocuments(
+    TEXT("Yaml.TrackDocuments"),
+    false,
+    TEXT("Whether Yaml Documents loaded from now on are tracked for Yaml.MemoryUsage"),
+    FConsoleVariableDelegate::CreateLambda([](IConsoleVariable* Variable) {
+        YAML::SetDocumentTracking(Variable->GetBool());
+    }));
+
+// Counting walks every Node of every Document, so this only happens when the Command is run. The Documents are not
+// locked meanwhile, see FYamlMemoryUsage::ForLiveDocuments()
+static FAutoConsoleCommand YamlMemoryUsageCommand(
+    TEXT("Yaml.MemoryUsage"),
+    TEXT("Logs the Nodes and Bytes held by every live Yaml Document that was loaded while Yaml.TrackDocuments was ")
+    TEXT("set. Only for quiescent States: no other Thread may load or change Yaml Documents while it runs"),
+    FConsoleCommandDelegate::CreateLambda([] {
+        const TArray<FYamlMemoryUsage> Usages = FYamlMemoryUsage::ForLiveDocuments();
+
+        FYamlMemoryUsage Total;
+        for (int32 i = 0; i < Usages.Num(); i++) {
+            UE_LOG(LogTemp, Display, TEXT("Yaml Document %d: %s"), i, *Usages[i].ToString())
+            Total += Usages[i];
+        }
+        UE_LOG(LogTemp, Display, TEXT("%d Yaml Documents: %s"), Usages.Num(), *Total.ToString())
+    }));
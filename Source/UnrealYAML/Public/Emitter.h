@@ -1,6 +1,25 @@
 ﻿#pragma once
 
+#include "CoreMinimal.h"
 #include "yaml.h"
 
 // An Emitter used to create new YAML-Structures. You can use the "<<"-operator to add Elements to the Structure.
 using FYamlEmitter = YAML::Emitter;
+
+// An Emitter that writes JSON instead, with the same "<<"-operator. Set an Indent to pretty-print it.
+using FYamlJsonEmitter = YAML::JsonEmitter;
+
+// Lets an Emitter write into an Archive (e.g. a File from IFileManager::CreateFileWriter) while it emits, in Chunks of
+// bounded Size, instead of building the whole Output in Memory first. Pass it to the Constructor of the Emitter, which
+// must be destroyed or flushed before the Archive is closed.
+class FYamlArchiveSink final : public YAML::OutputSink {
+public:
+    explicit FYamlArchiveSink(FArchive& InArchive) : Archive(InArchive) {}
+
+    virtual void Write(const char* Data, const std::size_t Size) override {
+        Archive.Serialize(const_cast<char*>(Data), static_cast<int64>(Size));
+    }
+
+private:
+    FArchive& Archive;
+};
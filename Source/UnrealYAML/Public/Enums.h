@@ -25,6 +25,26 @@ enum class EYamlNodeType : uint8 {
 };
 
 
+// What the Value of a Scalar is in the YAML 1.2 Core Schema
+UENUM()
+enum class EYamlScalarType : uint8 {
+    // null, ~ or no Content at all
+    Null,
+
+    // true or false
+    Bool,
+
+    // A whole Number that fits into 64 Bits
+    Int,
+
+    // Any other Number, including .inf and .nan
+    Float,
+
+    // Everything else
+    String
+};
+
+
 // Different ways to align data in a list/map in a file
 UENUM()
 enum class EYamlEmitterStyle : uint8 {
@@ -0,0 +1,130 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "yaml.h"
+#include "UnrealTypes.h"
+#include "Enums.h"
+
+struct FYamlNode;
+class FYamlFrozenNode;
+
+
+/** An immutable Snapshot of a Yaml Document, created via FYamlNode::Freeze()
+ *
+ * All Nodes are stored in flat Arrays. Reading it through FYamlFrozenNode performs no Allocations or Writes to shared
+ * State, so any Number of Threads may read the same Document at once without Locking.
+ */
+class UNREALYAML_API FYamlFrozenDocument {
+    YAML::FrozenDocument Document;
+
+public:
+    /** Freezes the given Node and everything below it */
+    explicit FYamlFrozenDocument(const YAML::Node& Root) :
+        Document(Root) {}
+
+    /** Returns the Root of the Document. Stays valid as long as this Document is alive */
+    FYamlFrozenNode Root() const;
+
+    /** Returns the Number of distinct Nodes in this Document */
+    int32 Num() const;
+};
+
+
+/** A read-only View of a Node inside a FYamlFrozenDocument. Cheap to copy and safe to use from any Thread */
+class UNREALYAML_API FYamlFrozenNode {
+    friend FYamlFrozenDocument;
+
+    YAML::FrozenNode Node;
+
+    explicit FYamlFrozenNode(const YAML::FrozenNode Value) :
+        Node(Value) {}
+
+public:
+    /** Generate an Undefined Node */
+    FYamlFrozenNode() = default;
+
+    // Types ---------------------------------------------------------------------------
+    /** Returns the Type of the Contained Data */
+    EYamlNodeType Type() const;
+
+    /** If the Node exists in the Document */
+    bool IsDefined() const;
+
+    /** Equivalent to Type() == Null (No Value) */
+    bool IsNull() const;
+
+    /** Equivalent to Type() == Scalar (Singular Value) */
+    bool IsScalar() const;
+
+    /** Equivalent to Type() == Sequence (Multiple Values without Keys) */
+    bool IsSequence() const;
+
+    /** Equivalent to Type() == Map (List of Key-Value Pairs) */
+    bool IsMap() const;
+
+    explicit operator bool() const;
+    bool operator !() const;
+
+    /** Test if 2 Nodes are the same Node of the same Document */
+    bool Is(const FYamlFrozenNode& Other) const;
+
+    // Access --------------------------------------------------------------------------
+    /** Try to Convert the Contents of the Node to the Given Type. Numbers, Bools and Strings are read straight from
+     * the Document; other Types are converted from a private Copy of the Node (see Thaw()), so neither touches the
+     * shared Document
+     *
+     * @return The Converted Value, or an empty Optional if the Conversion was unsuccessful
+     */
+    template<typename T>
+    TOptional<T> AsOptional() const {
+        T Value;
+        if (!Decode(Value)) {
+            return {};
+        }
+        return Value;
+    }
+
+    /** Try to Convert the Contents of the Node to the Given Type or return the Default Value
+     * when conversion is not possible */
+    template<typename T>
+    T As(T DefaultValue = T()) const {
+        T Value;
+        if (!Decode(Value)) {
+            return DefaultValue;
+        }
+        return Value;
+    }
+
+    /** The Content of the Node if it is a Scalar */
+    FString Scalar() const;
+
+    /** Returns a mutable Copy of this Node and everything below it. Sequences and Maps are only copied once they are
+     * accessed, so changing a few Values of a large Document stays cheap. The Copy keeps the Document alive */
+    FYamlNode Thaw() const;
+
+    // Size and Indexing ---------------------------------------------------------------
+    /** Returns the Size of the Node if it is a Sequence or Map, 0 otherwise */
+    int32 Size() const;
+
+    /** Returns the Key of the Entry at the given Position if the Node is a Map */
+    FYamlFrozenNode KeyAt(const int32 Index) const;
+
+    /** Returns the Value of the Entry at the given Position if the Node is a Map,
+     * or the Element at the given Position if the Node is a Sequence */
+    FYamlFrozenNode ValueAt(const int32 Index) const;
+
+    /** Returns the Value at the given Key or Index. The Result is Undefined if there is no such Value */
+    template<typename T>
+    FYamlFrozenNode operator[](const T& Key) const {
+        return FYamlFrozenNode(Node[Key]);
+    }
+
+private:
+    template<typename T>
+    bool Decode(T& Value) const {
+        return Node.TryDecode(Value);
+    }
+
+    // Converted from the Document's Text, without the Copy convert<FString> would need
+    bool Decode(FString& Value) const;
+};
@@ -5,15 +5,66 @@
 #include "UnrealTypes.h"
 #include "Enums.h"
 #include "Emitter.h"
+#include "FrozenNode.h"
 
 #include "Node.generated.h"
 
 class FYamlIterator;
 
 
+/** What a Yaml Document takes up in Memory, see FYamlNode::GetMemoryUsage(). Nodes are counted by their current Type,
+ * including Nodes that were removed or overwritten but not compacted yet. The Bytes are close Estimates of the Heap
+ * Memory behind them */
+struct UNREALYAML_API FYamlMemoryUsage {
+    int64 UndefinedNodes = 0;
+    int64 EmptyNodes = 0;
+    int64 ScalarNodes = 0;
+    int64 SequenceNodes = 0;
+    int64 MapNodes = 0;
+    // Slots freed by Compaction and waiting to be reused
+    int64 FreeNodes = 0;
+
+    // Scalar Strings
+    int64 ScalarBytes = 0;
+    // Tag Strings
+    int64 TagBytes = 0;
+    // Element Arrays and Key Indexes of Sequences and Maps
+    int64 ContainerBytes = 0;
+    // The Node Slots themselves and their Bookkeeping
+    int64 NodeBytes = 0;
+    // Frozen Documents the Nodes still thaw Elements from. These may be shared with other Documents
+    int64 FrozenBytes = 0;
+
+    FYamlMemoryUsage() = default;
+    explicit FYamlMemoryUsage(const YAML::MemoryUsage& Usage);
+
+    int64 Nodes() const {
+        return UndefinedNodes + EmptyNodes + ScalarNodes + SequenceNodes + MapNodes;
+    }
+
+    int64 TotalBytes() const {
+        return ScalarBytes + TagBytes + ContainerBytes + NodeBytes + FrozenBytes;
+    }
+
+    FYamlMemoryUsage& operator+=(const FYamlMemoryUsage& Other);
+
+    /** Returns the Memory Usage of every live Document that was parsed (or thawed from a Frozen Document) while the
+     * Yaml.TrackDocuments Console Variable was set, one Entry per Document. Tracking is off by default, since a tracked
+     * Document locks a Mutex when it is loaded and again when it is destroyed. Only meant for quiescent States: no
+     * other Thread may load, change or merge Documents meanwhile */
+    static TArray<FYamlMemoryUsage> ForLiveDocuments();
+
+    FString ToString() const;
+};
+
+
 /** A wrapper for the Yaml Node class. Base YAML class. Stores a YAML-Structure in a Tree-like hierarchy.
  * Can therefore either hold a single value or be a Container for other Nodes.
  * Conversion from one Type to another will be done automatically as needed
+ *
+ * Any Number of Threads may read one Document through const FYamlNodes at once, as long as no Thread changes it
+ * meanwhile. Non-const Access, even operator[] with a missing Key, counts as a Change, and so does the first Access
+ * to a Container thawed from a Frozen Document. To share a Document freely, share a FYamlFrozenDocument instead
  */
 USTRUCT(BlueprintType)
 struct UNREALYAML_API FYamlNode {
@@ -66,6 +117,10 @@ public:
     /** Equivalent to Type() == Map (List of Key-Value Pairs) */
     bool IsMap() const;
 
+    /** Returns what the Scalar of the Node is in the YAML 1.2 Core Schema. It is resolved once and cached with the
+     * Node, and As<T>() takes Numbers and Booleans from it. Sequences and Maps are Strings */
+    EYamlScalarType ScalarType() const;
+
 
     // Conversion to bool and output to a Stream ---------------------------------------
     explicit operator bool() const;
@@ -87,9 +142,9 @@ public:
     /** Assign a Value to this Node. Will automatically converted */
     template<typename T>
     FYamlNode& operator=(const T& Value) {
-        try {
-            Node = Value;
-        } catch (YAML::InvalidNode e) {
+        const YAML::ErrorScope Errors;
+        Node = Value;
+        if (YAML::HasError()) {
             UE_LOG(LogTemp, Warning, TEXT("Node was Invalid, won't assign any Value!"))
         }
         return *this;
@@ -107,6 +162,31 @@ public:
      */
     bool Reset(const FYamlNode& Other = FYamlNode());
 
+    /** Returns an independent Copy of this Node and everything below it. Copying or assigning an FYamlNode only copies
+     * the Reference, so changes to either are visible in both; changes to a Clone are not.
+     * Every Node is copied, so this costs as much as the Document is large; only Parts that were thawed from a Frozen
+     * Document and not accessed since are shared. For many Copies of one Document, Freeze() it once and Thaw() each
+     * Copy from the FYamlFrozenDocument instead */
+    FYamlNode Clone() const;
+
+    /** Frees the Parts of this Node's Document that were removed or overwritten and can no longer be reached from any
+     * FYamlNode. Iterators into the freed Parts become invalid, so Documents are never compacted behind your back:
+     * call this at a Point where no Iterator is in use, e.g. when GetNodeCount() has grown well past its Value after the
+     * last Compact()
+     *
+     * @returns The Number of Bytes reclaimed
+     */
+    int64 Compact() const;
+
+    /** Counts the Nodes and Bytes of this Node's whole Document, including every Document that was merged into it by
+     * assigning Nodes between them. Walks every Node, nothing is tracked in between Queries. The Document must not
+     * change meanwhile */
+    FYamlMemoryUsage GetMemoryUsage() const;
+
+    /** The Number of Nodes in this Node's whole Document, reachable or not, as counted by GetMemoryUsage(). Kept up to
+     * date by the Document, so this takes constant Time and can be checked after every Change */
+    int64 GetNodeCount() const;
+
 
     // Access --------------------------------------------------------------------------
     /** Try to Convert the Contents of the Node to the Given Type or a nullptr when conversion is not possible
@@ -115,11 +195,11 @@ public:
      */
     template<typename T>
     TOptional<T> AsOptional() const {
-        try {
-            return Node.as<T>();
-        } catch (YAML::Exception) {
+        T Value;
+        if (!Node.TryDecode(Value)) {
             return {};
         }
+        return Value;
     }
 
     /** Try to Convert the Contents of the Node to the Given Type or return the Default Value
@@ -132,22 +212,59 @@ public:
     */
     template<typename T>
     T As(T DefaultValue = T()) const {
-        try {
-            return Node.as<T>();
-        } catch (YAML::Exception) {
+        T Value;
+        if (!Node.TryDecode(Value)) {
             return DefaultValue;
         }
+        return Value;
     }
 
-    /** Check if the given node can be converted to the given Type */
+    /** Try to Convert the Contents of the Node to the Given Type. A failed Conversion is only reported through the
+     * Result: nothing is logged or recorded as an Error, so probing a Node for several Types is cheap
+     *
+     * @return If the Conversion was successful. If not, Value is left unchanged
+     */
     template<typename T>
-    bool CanConvertTo() const {
-        try {
-            Node.as<T>();
-            return true;
-        } catch (YAML::Exception) {
+    bool TryAs(T& Value) const {
+        T Result;
+        if (!Node.TryDecode(Result)) {
             return false;
         }
+        Value = MoveTemp(Result);
+        return true;
+    }
+
+    /** Try to Convert the Value at the given Key or Index to the Given Type, like TryAs(). Unlike the Index Operator,
+     * a missing Key doesn't create an Invalid Node
+     *
+     * @return If there is a Value at the Key and its Conversion was successful. If not, Value is left unchanged
+     */
+    template<typename K, typename T>
+    bool TryGet(const K& Key, T& Value) const {
+        T Result;
+        if (!Node.TryDecode(Key, Result)) {
+            return false;
+        }
+        Value = MoveTemp(Result);
+        return true;
+    }
+
+    /** Try to Convert the Contents of the Node into an existing Value. Unlike AsOptional(), no temporary Copy is made:
+     * Arrays, Sets and Maps are refilled in place, keeping their allocated Capacity, and their Elements are decoded
+     * directly into them
+     *
+     * @return If the Conversion was successful. If not, Value may hold part of the Contents
+     */
+    template<typename T>
+    bool DecodeInto(T& Value) const {
+        return Node.TryDecode(Value);
+    }
+
+    /** Check if the given node can be converted to the given Type */
+    template<typename T>
+    bool CanConvertTo() const {
+        T Value;
+        return Node.TryDecode(Value);
     }
 
     /** Try to Content of the Node if it is a Scalar */
@@ -156,6 +273,15 @@ public:
     /** Returns the whole Content of the Node as a single FString */
     FString GetContent() const;
 
+    /** Returns the whole Content of the Node as JSON: minimal if Indent is 0, otherwise pretty-printed with Indent Spaces
+     * per Level. Scalars are resolved like YAML would (Numbers, Booleans, null, Strings), Aliases are written out in full.
+     * Returns an empty String if the Node contains itself */
+    FString GetContentAsJson(int32 Indent = 0) const;
+
+    /** Creates an immutable Snapshot of this Node and everything below it, which can be read from any Thread.
+     * Later changes to this Node are not reflected in the Snapshot */
+    TSharedRef<const FYamlFrozenDocument, ESPMode::ThreadSafe> Freeze() const;
+
     // Size and Iteration --------------------------------------------------------------
     /** Returns the Size of the Node if it is a Sequence or Map, 0 otherwise */
     int32 Size() const;
@@ -170,18 +296,18 @@ public:
     /** Converts the Node to a Sequence and adds the Element to this list */
     template<typename T>
     void Push(const T& Element) {
-        try {
-            Node.push_back(Element);
-        } catch (YAML::InvalidNode) {
+        const YAML::ErrorScope Errors;
+        Node.push_back(Element);
+        if (YAML::HasError()) {
             UE_LOG(LogTemp, Warning, TEXT("Node was Invalid, can't Push any Value onto it!"))
         }
     }
 
     /** Converts the Node to a Sequence and adds the Node to this list */
     void Push(const FYamlNode& Element) {
-        try {
-            Node.push_back(Element.Node);
-        } catch (YAML::InvalidNode) {
+        const YAML::ErrorScope Errors;
+        Node.push_back(Element.Node);
+        if (YAML::HasError()) {
             UE_LOG(LogTemp, Warning, TEXT("Node was Invalid, can't Push any Value onto it!"))
         }
     }
@@ -63,6 +63,12 @@ public:
         return Node.IsMap();
     }
 
+    /** Returns what the Scalar of the Node is in the YAML 1.2 Core Schema */
+    UFUNCTION(BlueprintPure, Category="YAML")
+    static EYamlScalarType ScalarType(const FYamlNode& Node) {
+        return Node.ScalarType();
+    }
+
     /** Returns the Style of the Node, mostly relevant for Sequences */
     UFUNCTION(BlueprintPure, Category="YAML")
     static EYamlEmitterStyle Style(const FYamlNode& Node) {
@@ -89,6 +95,13 @@ public:
         return Node.Reset();
     }
 
+    /** Returns an independent Copy of the Node and everything below it. Assigning a Node only copies the Reference,
+     * changes to a Clone don't affect the Original */
+    UFUNCTION(BlueprintPure, Category="YAML")
+    static FYamlNode Clone(const FYamlNode& Node) {
+        return Node.Clone();
+    }
+
 
     // Create Constructors and Conversion for all Types ----------------------------------------------------------------
     // Int
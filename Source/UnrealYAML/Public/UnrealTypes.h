@@ -20,6 +20,8 @@ static const TMap<FString, FColor> ColorMap = {
 };
 
 
+// The Decoders convert their Elements with TryDecode(), so probing a Node for a Type it doesn't have fails quietly,
+// without recording an Error for the Element
 namespace YAML {
 // encode and decode an FString
 template<>
@@ -29,11 +31,12 @@ struct convert<FString> {
     }
 
     static bool decode(const Node& Node, FString& Out) {
-        if (!Node.IsScalar()) {
+        std::string Value;
+        if (!Node.IsScalar() || !Node.TryDecode(Value)) {
             return false;
         }
 
-        Out = UTF8_TO_TCHAR(Node.as<std::string>().c_str());
+        Out = UTF8_TO_TCHAR(Value.c_str());
         return true;
     }
 };
@@ -47,11 +50,12 @@ struct convert<FText> {
     }
 
     static bool decode(const Node& Node, FText& Out) {
-        if (!Node.IsScalar()) {
+        FString Value;
+        if (!Node.IsScalar() || !Node.TryDecode(Value)) {
             return false;
         }
 
-        Out = FText::FromString(Node.as<FString>());
+        Out = FText::FromString(Value);
         return true;
     }
 };
@@ -71,10 +75,13 @@ struct convert<FColor> {
     }
 
     static bool decode(const Node& Node, FColor& Out) {
-        for (const auto& Pair : ColorMap) {
-            if (Node.as<FString>() == Pair.Key) {
-                Out = Pair.Value;
-                return true;
+        FString Name;
+        if (Node.IsScalar() && Node.TryDecode(Name)) {
+            for (const auto& Pair : ColorMap) {
+                if (Name == Pair.Key) {
+                    Out = Pair.Value;
+                    return true;
+                }
             }
         }
 
@@ -82,9 +89,13 @@ struct convert<FColor> {
             return false;
         }
 
+        uint8 R, G, B, A = 255;
+        if (!Node[0].TryDecode(R) || !Node[1].TryDecode(G) || !Node[2].TryDecode(B) ||
+            (Node.size() == 4 && !Node[3].TryDecode(A))) {
+            return false;
+        }
 
-        const float A = Node.size() == 4 ? Node[3].as<uint8>() : 1.f;
-        Out = FColor(Node[0].as<uint8>(), Node[1].as<uint8>(), Node[2].as<uint8>(), A);
+        Out = FColor(R, G, B, A);
         return true;
     }
 };
@@ -118,15 +129,21 @@ struct convert<FVector> {
 
     static bool decode(const Node& Node, FVector& Out) {
         if (Node.IsSequence() && Node.size() == 3) {
-            Out.X = Node[0].as<double>();
-            Out.Y = Node[1].as<double>();
-            Out.Z = Node[2].as<double>();
+            double X, Y, Z;
+            if (!Node[0].TryDecode(X) || !Node[1].TryDecode(Y) || !Node[2].TryDecode(Z)) {
+                return false;
+            }
+
+            Out.X = X;
+            Out.Y = Y;
+            Out.Z = Z;
             return true;
         }
 
         // Constant Vector
-        if (Node.IsScalar()) {
-            Out.X = Out.Y = Out.Z = Node.as<double>();
+        double Value;
+        if (Node.IsScalar() && Node.TryDecode(Value)) {
+            Out.X = Out.Y = Out.Z = Value;
         }
 
         return false;
@@ -150,16 +167,26 @@ struct convert<FQuat> {
 
     static bool decode(const Node& Node, FQuat& Out) {
         if (Node.IsSequence()) {
+            double X, Y, Z, W;
             if (Node.size() == 4) {
-                Out.X = Node[0].as<double>();
-                Out.Y = Node[1].as<double>();
-                Out.Z = Node[2].as<double>();
-                Out.W = Node[3].as<double>();
+                if (!Node[0].TryDecode(X) || !Node[1].TryDecode(Y) || !Node[2].TryDecode(Z) ||
+                    !Node[3].TryDecode(W)) {
+                    return false;
+                }
+
+                Out.X = X;
+                Out.Y = Y;
+                Out.Z = Z;
+                Out.W = W;
                 return true;
             }
 
             if (Node.size() == 3) {
-                Out = FRotator(Node[0].as<double>(), Node[1].as<double>(), Node[2].as<double>()).Quaternion();
+                if (!Node[0].TryDecode(X) || !Node[1].TryDecode(Y) || !Node[2].TryDecode(Z)) {
+                    return false;
+                }
+
+                Out = FRotator(X, Y, Z).Quaternion();
                 return true;
             }
         }
@@ -186,9 +213,15 @@ struct convert<FTransform> {
             return false;
         }
 
-        Out.SetTranslation(Node[0].as<FVector>());
-        Out.SetRotation(Node[1].as<FQuat>());
-        Out.SetScale3D(Node[2].as<FVector>());
+        FVector Translation, Scale;
+        FQuat Rotation;
+        if (!Node[0].TryDecode(Translation) || !Node[1].TryDecode(Rotation) || !Node[2].TryDecode(Scale)) {
+            return false;
+        }
+
+        Out.SetTranslation(Translation);
+        Out.SetRotation(Rotation);
+        Out.SetScale3D(Scale);
         return true;
     }
 };
@@ -210,13 +243,43 @@ struct convert<TArray<T>> {
             return false;
         }
 
-        Out = {};
+        // TArray counts its Elements with an int32
+        const std::size_t Size = Node.size();
+        if (Size > static_cast<std::size_t>(TNumericLimits<int32>::Max())) {
+            return false;
+        }
+
+        Out.Reset();
+        if (Node.Type() == NodeType::Sequence && DecodeNumbers(Node, Out, Size, conversion::is_number<T>())) {
+            return true;
+        }
+
+        Out.Reserve(static_cast<int32>(Size));
         for (const_iterator Iterator = Node.begin(); Iterator != Node.end(); ++Iterator) {
-            Out.Add(Iterator->as<T>());
+            if (!Iterator->TryDecode(Out[Out.AddDefaulted()])) {
+                return false;
+            }
         }
 
         return true;
     }
+
+private:
+    // Sequences of numbers are parsed in one pass straight into the array, falls back to the element-wise decoding
+    // if any of them is not a number
+    static bool DecodeNumbers(const Node& Node, TArray<T>& Out, const std::size_t Size, std::true_type) {
+        Out.SetNumUninitialized(static_cast<int32>(Size));
+        if (YAML::DecodeNumbers(Node, Out.GetData(), Size)) {
+            return true;
+        }
+
+        Out.Reset();
+        return false;
+    }
+
+    static bool DecodeNumbers(const Node&, TArray<T>&, std::size_t, std::false_type) {
+        return false;
+    }
 };
 
 
@@ -236,9 +299,14 @@ struct convert<TSet<T>> {
             return false;
         }
 
-        Out = {};
+        Out.Reset();
+        Out.Reserve(Node.size());
         for (const_iterator Iterator = Node.begin(); Iterator != Node.end(); ++Iterator) {
-            Out.Add(Iterator->as<T>());
+            T Element;
+            if (!Iterator->TryDecode(Element)) {
+                return false;
+            }
+            Out.Add(MoveTemp(Element));
         }
 
         return true;
@@ -263,9 +331,13 @@ struct convert<TMap<TKey, TValue>> {
             return false;
         }
 
-        Out = {};
+        Out.Reset();
+        Out.Reserve(Node.size());
         for (const_iterator Iterator = Node.begin(); Iterator != Node.end(); ++Iterator) {
-            Out.Add(Iterator->first.as<TKey>(), Iterator->second.as<TValue>());
+            TKey Key;
+            if (!Iterator->first.TryDecode(Key) || !Iterator->second.TryDecode(Out.Add(MoveTemp(Key)))) {
+                return false;
+            }
         }
 
         return true;
@@ -8,7 +8,9 @@ public class UnrealYAML : ModuleRules {
 		Type = ModuleType.CPlusPlus;
 		PublicDependencyModuleNames.AddRange(new[] {"Core", "CoreUObject", "Engine"});
 
-		bEnableExceptions = true;
+		// yaml-cpp reports its Errors through YAML::HasError() instead of throwing, see exceptions.h
+		bEnableExceptions = false;
+		PublicDefinitions.Add("YAML_CPP_NO_EXCEPTIONS=1");
 		
 		// Replace the source ExportHeader with our ExportHeader
 		PublicDefinitions.Add("YAML_CPP_API=UNREALYAML_API");
@@ -17,6 +17,26 @@ YAML_CPP_API std::string EncodeBase64(const unsigned char *data,
                                       std::size_t size);
 YAML_CPP_API std::vector<unsigned char> DecodeBase64(const std::string &input);
 
+// the characters EncodeBase64() writes for size bytes
+inline std::size_t EncodedBase64Size(std::size_t size) {
+  return (size + 2) / 3 * 4;
+}
+// the most bytes DecodeBase64() writes for size characters
+inline std::size_t DecodedBase64Size(std::size_t size) {
+  return size / 4 * 3;
+}
+
+// Encodes into out, which must hold EncodedBase64Size(size) characters, and
+// returns the end of what was written. Encoding a multiple of 3 bytes at a
+// time gives the same text as encoding them all at once.
+YAML_CPP_API char *EncodeBase64(const unsigned char *data, std::size_t size,
+                                char *out);
+// Decodes into out, which must hold DecodedBase64Size(size) bytes, skipping
+// whitespace. Returns the end of what was written, or nullptr if the input
+// has any other character that is not base64.
+YAML_CPP_API unsigned char *DecodeBase64(const char *input, std::size_t size,
+                                         unsigned char *out);
+
 class YAML_CPP_API Binary {
  public:
   Binary(const unsigned char *data_, std::size_t size_)
@@ -40,7 +40,8 @@ private:
  * construction of DepthGuard and decrements the integer upon destruction.
  *
  * If the integer would be incremented past max_depth, then an exception is
- * thrown. This is ideally geared toward guarding against deep recursion.
+ * thrown (see exceeded() without exceptions). This is ideally geared toward
+ * guarding against deep recursion.
  *
  * @param max_depth
  *  compile-time configurable maximum depth.
@@ -50,8 +51,8 @@ class DepthGuard final {
 public:
   DepthGuard(int & depth_, const Mark& mark_, const std::string& msg_) : m_depth(depth_) {
     ++m_depth;
-    if ( max_depth <= m_depth ) {
-        throw DeepRecursion{m_depth, mark_, msg_};
+    if ( exceeded() ) {
+        detail::raise(DeepRecursion{m_depth, mark_, msg_});
     }
   }
 
@@ -68,6 +69,12 @@ public:
     return m_depth;
   }
 
+  // Without exceptions, the guard is still constructed when the depth is
+  // exceeded, and the caller has to stop here.
+  bool exceeded() const {
+    return max_depth <= m_depth;
+  }
+
 private:
     int & m_depth;
 };
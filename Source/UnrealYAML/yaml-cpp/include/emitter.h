@@ -34,6 +34,9 @@ class YAML_CPP_API Emitter {
  public:
   Emitter();
   explicit Emitter(std::ostream& stream);
+  // writes through a buffer of bufferSize bytes, see OutputSink
+  explicit Emitter(OutputSink& sink,
+                   std::size_t bufferSize = ostream_wrapper::kSinkBufferSize);
   Emitter(const Emitter&) = delete;
   Emitter& operator=(const Emitter&) = delete;
   ~Emitter();
@@ -41,6 +44,9 @@ class YAML_CPP_API Emitter {
   // output
   const char* c_str() const;
   std::size_t size() const;
+  // hands what is buffered for a sink over to it, which also happens when
+  // the emitter is destroyed
+  void Flush();
 
   // state checking
   bool good() const;
@@ -82,6 +88,10 @@ class YAML_CPP_API Emitter {
 
   template <typename T>
   Emitter& WriteStreamable(T value);
+  // floats and doubles are written at the precision settings without a
+  // stream, see FormatNumber()
+  Emitter& WriteStreamable(float value);
+  Emitter& WriteStreamable(double value);
 
  private:
   template <typename T>
@@ -89,7 +99,12 @@ class YAML_CPP_API Emitter {
   std::size_t GetFloatPrecision() const;
   std::size_t GetDoublePrecision() const;
 
-  void PrepareIntegralStream(std::stringstream& stream) const;
+  // Writes an integer in the current IntFormat. bits is the value as the
+  // unsigned type of its size, which is what hex and octal show, like a
+  // stream does.
+  Emitter& WriteInteger(bool negative, unsigned long long magnitude,
+                        unsigned long long bits);
+  Emitter& WriteFloatingPoint(double value, std::size_t precision);
   void StartedScalar();
 
  private:
@@ -135,19 +150,13 @@ class YAML_CPP_API Emitter {
 
 template <typename T>
 inline Emitter& Emitter::WriteIntegralType(T value) {
-  if (!good())
-    return *this;
-
-  PrepareNode(EmitterNodeType::Scalar);
-
-  std::stringstream stream;
-  PrepareIntegralStream(stream);
-  stream << value;
-  m_stream << stream.str();
-
-  StartedScalar();
-
-  return *this;
+  using unsigned_type = typename std::make_unsigned<T>::type;
+  const bool negative = value < static_cast<T>(0);
+  return WriteInteger(
+      negative,
+      negative ? 0 - static_cast<unsigned long long>(value)
+               : static_cast<unsigned long long>(value),
+      static_cast<unsigned_type>(value));
 }
 
 template <typename T>
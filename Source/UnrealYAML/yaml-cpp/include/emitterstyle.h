@@ -8,7 +8,7 @@
 #endif
 
 namespace YAML {
-	enum class EmitterStyle { Default, Block, Flow };
+	enum class EmitterStyle : unsigned char { Default, Block, Flow };
 }
 
 #endif  // EMITTERSTYLE_H_62B23520_7C8E_11DE_8A39_0800200C9A66
@@ -87,6 +87,11 @@ const char* const INVALID_ANCHOR = "invalid anchor";
 const char* const INVALID_ALIAS = "invalid alias";
 const char* const INVALID_TAG = "invalid tag";
 const char* const BAD_FILE = "bad file";
+const char* const JSON_COLLECTION_KEY =
+    "a sequence or map can not be a JSON key";
+const char* const JSON_EXPECTED_KEY = "expected a key in a JSON map";
+const char* const JSON_EXPECTED_VALUE = "expected a value in a JSON map";
+const char* const RECURSIVE_NODE = "node contains itself";
 
 template <typename T>
 inline const std::string KEY_NOT_FOUND_WITH_KEY(
@@ -298,6 +303,95 @@ class YAML_CPP_API BadFile : public Exception {
   BadFile(const BadFile&) = default;
   ~BadFile() YAML_CPP_NOEXCEPT override;
 };
+
+// Errors without exceptions
+//
+// With YAML_CPP_NO_EXCEPTIONS, nothing is thrown. An operation that would
+// throw one of the exceptions above keeps it as the error of the thread
+// instead, unless there already is one, and carries on with a neutral result:
+// Load() returns a null Node, as<T>() a value-initialized T, an invalid Node
+// reports an Undefined type and a size of 0, and changes to it are dropped.
+// The error stays until it is cleared, so clear it before the operations whose
+// errors you want to know about, or run them in an ErrorScope.
+
+enum class ErrorCode {
+  None,
+  Parser,
+  BadFile,
+  InvalidNode,
+  BadConversion,
+  BadSubscript,
+  BadPushback,
+  BadInsert,
+  Other
+};
+
+struct YAML_CPP_API Error {
+  Error() : code(ErrorCode::None), mark(Mark::null_mark()), msg{}, what{} {}
+
+  explicit operator bool() const { return code != ErrorCode::None; }
+
+  ErrorCode code;
+  Mark mark;
+  std::string msg;
+  // with the position, like Exception::what()
+  std::string what;
+};
+
+// whether the thread has an error
+YAML_CPP_API bool HasError();
+// returns the error of the thread and clears it
+YAML_CPP_API Error TakeError();
+YAML_CPP_API void ClearError();
+
+// Sets the error of the thread aside for its lifetime, so that HasError()
+// only reports the errors of the operations in the scope, and puts it back
+// at the end. An error from the scope stays only if there was none before,
+// as the first error wins.
+class YAML_CPP_API ErrorScope {
+ public:
+  ErrorScope() : m_pending(TakeError()) {}
+  ~ErrorScope();
+  ErrorScope(const ErrorScope&) = delete;
+  ErrorScope& operator=(const ErrorScope&) = delete;
+
+ private:
+  Error m_pending;
+};
+
+namespace detail {
+inline ErrorCode error_code(const Exception&) { return ErrorCode::Other; }
+inline ErrorCode error_code(const ParserException&) {
+  return ErrorCode::Parser;
+}
+inline ErrorCode error_code(const BadFile&) { return ErrorCode::BadFile; }
+inline ErrorCode error_code(const InvalidNode&) {
+  return ErrorCode::InvalidNode;
+}
+inline ErrorCode error_code(const BadConversion&) {
+  return ErrorCode::BadConversion;
+}
+inline ErrorCode error_code(const BadSubscript&) {
+  return ErrorCode::BadSubscript;
+}
+inline ErrorCode error_code(const BadPushback&) {
+  return ErrorCode::BadPushback;
+}
+inline ErrorCode error_code(const BadInsert&) { return ErrorCode::BadInsert; }
+
+YAML_CPP_API void set_error(ErrorCode code, const Exception& exception);
+
+// Throws the exception, or without exceptions makes it the error of the
+// thread; the caller then returns a neutral result.
+template <typename E>
+inline void raise(const E& exception) {
+#ifdef YAML_CPP_NO_EXCEPTIONS
+  set_error(error_code(exception), exception);
+#else
+  throw exception;
+#endif
+}
+}  // namespace detail
 }  // namespace YAML
 
 #endif  // EXCEPTIONS_H_62B23520_7C8E_11DE_8A39_0800200C9A66
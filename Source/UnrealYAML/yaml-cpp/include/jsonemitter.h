@@ -0,0 +1,193 @@
+#ifndef JSONEMITTER_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+#define JSONEMITTER_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+
+#if defined(_MSC_VER) ||                                            \
+    (defined(__GNUC__) && (__GNUC__ == 3 && __GNUC_MINOR__ >= 4) || \
+     (__GNUC__ >= 4))  // GCC supports "pragma once" correctly since 3.4
+#pragma once
+#endif
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "binary.h"
+#include "emittermanip.h"
+#include "null.h"
+#include "ostream_wrapper.h"
+
+namespace YAML {
+class NodeView;
+}  // namespace YAML
+
+namespace YAML {
+/**
+ * Writes JSON (RFC 8259) with the interface of the {@link Emitter}, but none
+ * of its style decisions: strings are always double quoted and escaped only
+ * where JSON requires it, and the layout is either minimal or a fixed pretty
+ * form, so nothing is measured or looked ahead.
+ *
+ * Inside a map, values alternate between keys and values. Keys are always
+ * written as strings; numbers, booleans and null in key position are written
+ * as their text, and sequences and maps there are an error. Bytes of strings
+ * that are not UTF-8 are written as U+FFFD. Several top level values are
+ * written one per line.
+ */
+class YAML_CPP_API JsonEmitter {
+ public:
+  JsonEmitter();
+  explicit JsonEmitter(std::ostream& stream);
+  // writes through a buffer of bufferSize bytes, see OutputSink
+  explicit JsonEmitter(
+      OutputSink& sink,
+      std::size_t bufferSize = ostream_wrapper::kSinkBufferSize);
+  JsonEmitter(const JsonEmitter&) = delete;
+  JsonEmitter& operator=(const JsonEmitter&) = delete;
+  ~JsonEmitter();
+
+  // output
+  const char* c_str() const { return m_stream.str(); }
+  std::size_t size() const { return m_stream.pos(); }
+  // hands what is buffered for a sink over to it, which also happens when
+  // the emitter is destroyed
+  void Flush() { m_stream.flush(); }
+
+  // state checking
+  bool good() const { return m_lastError.empty(); }
+  const std::string GetLastError() const { return m_lastError; }
+
+  // 0, the default, writes no whitespace at all; otherwise every element of
+  // a non-empty sequence or map goes on its own line, indented by n spaces
+  // per level, like JSON.stringify(value, null, n).
+  bool SetIndent(std::size_t n);
+
+  // BeginSeq, EndSeq, BeginMap and EndMap open and close containers; Key and
+  // Value only check that a key or value comes next. Other manipulators are
+  // about YAML style and are ignored.
+  JsonEmitter& SetLocalValue(EmitterManip value);
+
+  // overloads of write
+  JsonEmitter& Write(const std::string& str) {
+    return Write(str.data(), str.size());
+  }
+  JsonEmitter& Write(const char* str, std::size_t size);
+  JsonEmitter& Write(bool b);
+  JsonEmitter& Write(char ch) { return Write(&ch, 1); }
+  JsonEmitter& Write(const _Null& n);
+  // as a base64 string
+  JsonEmitter& Write(const Binary& binary);
+  // the node and everything in it: see DumpJson() for how YAML maps to JSON
+  JsonEmitter& Write(const NodeView& node);
+
+  template <typename T>
+  JsonEmitter& WriteIntegralType(T value);
+  // the shortest text that parses back to the value; NaN and infinities,
+  // which JSON has no numbers for, are written as null
+  JsonEmitter& Write(float value);
+  JsonEmitter& Write(double value);
+
+ private:
+  struct Frame {
+    bool isMap;
+    bool hasElements;
+    bool expectsValue;
+  };
+
+  JsonEmitter& WriteInteger(bool negative, unsigned long long magnitude);
+  JsonEmitter& WriteNumber(const char* text, std::size_t size);
+
+  // Writes what comes before the next value: a comma, a line break and
+  // indentation, or a colon after a key. Returns false, after setting an
+  // error for containers, if the value can not go there; isKey is set if it
+  // is the key of a map entry.
+  bool PrepareValue(bool isContainer, bool& isKey);
+  void FinishValue();
+  void BeginContainer(bool isMap);
+  void EndContainer(bool isMap);
+  void WriteIndentation(std::size_t depth);
+  void WriteString(const char* str, std::size_t size);
+  void WriteNode(const NodeView& node, std::vector<NodeView>& ancestors);
+  void SetError(const std::string& error);
+
+ private:
+  ostream_wrapper m_stream;
+  std::size_t m_indent;
+  std::vector<Frame> m_frames;
+  bool m_hasTopValue;
+  std::string m_lastError;
+};
+
+template <typename T>
+inline JsonEmitter& JsonEmitter::WriteIntegralType(T value) {
+  const bool negative = value < static_cast<T>(0);
+  return WriteInteger(negative,
+                      negative ? 0 - static_cast<unsigned long long>(value)
+                               : static_cast<unsigned long long>(value));
+}
+
+// overloads of insertion
+inline JsonEmitter& operator<<(JsonEmitter& emitter, const std::string& v) {
+  return emitter.Write(v);
+}
+inline JsonEmitter& operator<<(JsonEmitter& emitter, const char* v) {
+  return emitter.Write(v, std::strlen(v));
+}
+inline JsonEmitter& operator<<(JsonEmitter& emitter, bool v) {
+  return emitter.Write(v);
+}
+inline JsonEmitter& operator<<(JsonEmitter& emitter, char v) {
+  return emitter.Write(v);
+}
+inline JsonEmitter& operator<<(JsonEmitter& emitter, unsigned char v) {
+  return emitter.Write(static_cast<char>(v));
+}
+inline JsonEmitter& operator<<(JsonEmitter& emitter, const _Null& v) {
+  return emitter.Write(v);
+}
+inline JsonEmitter& operator<<(JsonEmitter& emitter, const Binary& b) {
+  return emitter.Write(b);
+}
+inline JsonEmitter& operator<<(JsonEmitter& emitter, const NodeView& node) {
+  return emitter.Write(node);
+}
+
+inline JsonEmitter& operator<<(JsonEmitter& emitter, int v) {
+  return emitter.WriteIntegralType(v);
+}
+inline JsonEmitter& operator<<(JsonEmitter& emitter, unsigned int v) {
+  return emitter.WriteIntegralType(v);
+}
+inline JsonEmitter& operator<<(JsonEmitter& emitter, short v) {
+  return emitter.WriteIntegralType(v);
+}
+inline JsonEmitter& operator<<(JsonEmitter& emitter, unsigned short v) {
+  return emitter.WriteIntegralType(v);
+}
+inline JsonEmitter& operator<<(JsonEmitter& emitter, long v) {
+  return emitter.WriteIntegralType(v);
+}
+inline JsonEmitter& operator<<(JsonEmitter& emitter, unsigned long v) {
+  return emitter.WriteIntegralType(v);
+}
+inline JsonEmitter& operator<<(JsonEmitter& emitter, long long v) {
+  return emitter.WriteIntegralType(v);
+}
+inline JsonEmitter& operator<<(JsonEmitter& emitter, unsigned long long v) {
+  return emitter.WriteIntegralType(v);
+}
+
+inline JsonEmitter& operator<<(JsonEmitter& emitter, float v) {
+  return emitter.Write(v);
+}
+inline JsonEmitter& operator<<(JsonEmitter& emitter, double v) {
+  return emitter.Write(v);
+}
+
+inline JsonEmitter& operator<<(JsonEmitter& emitter, EmitterManip value) {
+  return emitter.SetLocalValue(value);
+}
+}  // namespace YAML
+
+#endif  // JSONEMITTER_H_62B23520_7C8E_11DE_8A39_0800200C9A66
@@ -12,11 +12,13 @@
 #include <limits>
 #include <list>
 #include <map>
+#include <string>
 #include <sstream>
 #include <type_traits>
 #include <vector>
 
 #include "binary.h"
+#include "numeric.h"
 #include "node/impl.h"
 #include "node/iterator.h"
 #include "node/node.h"
@@ -26,6 +28,7 @@
 
 namespace YAML {
 class Binary;
+class FrozenNode;
 struct _Null;
 template <typename T>
 struct convert;
@@ -97,6 +100,94 @@ struct convert<_Null> {
 };
 
 namespace conversion {
+// Integers are parsed and written through the widest type of their
+// signedness, float and double directly, see numeric.h.
+template <typename T>
+using number_type = typename std::conditional<
+    std::is_floating_point<T>::value, T,
+    typename std::conditional<std::is_signed<T>::value, long long,
+                              unsigned long long>::type>::type;
+
+template <typename T>
+std::string EncodeNumber(T rhs) {
+  char buffer[kMaxNumberSize];
+  return std::string(buffer,
+                     FormatNumber(buffer, static_cast<number_type<T>>(rhs)));
+}
+
+// the types DecodeNumbers() decodes
+template <typename T>
+struct is_number
+    : std::integral_constant<bool, (std::is_integral<T>::value &&
+                                    !std::is_same<T, bool>::value &&
+                                    !std::is_same<T, char>::value) ||
+                                       std::is_same<T, float>::value ||
+                                       std::is_same<T, double>::value> {};
+
+inline const std::string& ScalarOf(const Node& node) { return node.Scalar(); }
+inline const std::string& ScalarOf(const detail::node& node) {
+  return node.scalar();
+}
+
+template <typename N>
+bool NarrowFloat(double value, const N& /* node */, double& rhs) {
+  rhs = value;
+  return true;
+}
+
+template <typename N>
+bool NarrowFloat(double value, const N& node, float& rhs) {
+  const std::string& input = ScalarOf(node);
+  return NarrowNumber(value, input.data(), input.data() + input.size(), rhs);
+}
+// the scalars of a FrozenNode are not stored in strings
+YAML_CPP_API bool NarrowFloat(double value, const FrozenNode& node,
+                              float& rhs);
+
+// Numbers are decoded from the resolved scalar of a Node or of the data of
+// one, with the result of parsing the text with ParseNumber().
+template <typename T, typename N>
+typename std::enable_if<std::is_integral<T>::value, bool>::type
+DecodeNumber(const ResolvedScalar& scalar, const N& /* node */, T& rhs) {
+  if (scalar.type != ScalarType::Int)
+    return false;
+  if (!scalar.negative) {
+    if (scalar.magnitude >
+        static_cast<unsigned long long>((std::numeric_limits<T>::max)()))
+      return false;
+    rhs = static_cast<T>(scalar.magnitude);
+    return true;
+  }
+
+  // the magnitude of the minimum, computed without overflowing
+  const unsigned long long limit =
+      0 - static_cast<unsigned long long>((std::numeric_limits<T>::min)());
+  if (std::is_unsigned<T>::value || scalar.magnitude > limit)
+    return false;
+  rhs = static_cast<T>(
+      scalar.magnitude == 0
+          ? 0
+          : -static_cast<long long>(scalar.magnitude - 1) - 1);
+  return true;
+}
+
+template <typename T, typename N>
+typename std::enable_if<std::is_floating_point<T>::value, bool>::type
+DecodeNumber(const ResolvedScalar& scalar, const N& node, T& rhs) {
+  switch (scalar.type) {
+    case ScalarType::Int:
+      // converted directly, which rounds only once
+      rhs = static_cast<T>(scalar.magnitude);
+      if (scalar.negative)
+        rhs = -rhs;
+      return true;
+    case ScalarType::Float:
+      return NarrowFloat(scalar.floatValue, node, rhs);
+    default:
+      return false;
+  }
+}
+
 template <typename T>
 typename std::enable_if< std::is_floating_point<T>::value, void>::type
 inner_encode(const T& rhs, std::stringstream& stream){
@@ -114,108 +205,166 @@ inner_encode(const T& rhs, std::stringstream& stream){
 }
 
 template <typename T>
-typename std::enable_if<!std::is_floating_point<T>::value, void>::type
-inner_encode(const T& rhs, std::stringstream& stream){
-  stream << rhs;
+bool ConvertStreamTo(std::stringstream& stream, T& rhs) {
+  if ((stream >> std::noskipws >> rhs) && (stream >> std::ws).eof()) {
+    return true;
+  }
+  return false;
+}
 }
 
+#define YAML_DEFINE_CONVERT_NUMBER(type)                                \
+  template <>                                                           \
+  struct convert<type> {                                                \
+    static Node encode(const type& rhs) {                               \
+      return Node(conversion::EncodeNumber(rhs));                       \
+    }                                                                   \
+                                                                        \
+    static bool decode(const Node& node, type& rhs) {                   \
+      if (node.Type() != NodeType::Scalar) {                            \
+        return false;                                                   \
+      }                                                                 \
+      const std::string& input = node.Scalar();                         \
+      return decode(ResolveScalar(input.data(), input.size()), node,    \
+                    rhs);                                               \
+    }                                                                   \
+                                                                        \
+    static bool decode(const ResolvedScalar& scalar, const Node& node,  \
+                       type& rhs) {                                     \
+      return conversion::DecodeNumber(scalar, node, rhs);               \
+    }                                                                   \
+  }
+
+YAML_DEFINE_CONVERT_NUMBER(int);
+YAML_DEFINE_CONVERT_NUMBER(short);
+YAML_DEFINE_CONVERT_NUMBER(long);
+YAML_DEFINE_CONVERT_NUMBER(long long);
+YAML_DEFINE_CONVERT_NUMBER(unsigned);
+YAML_DEFINE_CONVERT_NUMBER(unsigned short);
+YAML_DEFINE_CONVERT_NUMBER(unsigned long);
+YAML_DEFINE_CONVERT_NUMBER(unsigned long long);
+
+YAML_DEFINE_CONVERT_NUMBER(signed char);
+YAML_DEFINE_CONVERT_NUMBER(unsigned char);
+
+YAML_DEFINE_CONVERT_NUMBER(float);
+YAML_DEFINE_CONVERT_NUMBER(double);
+
+#undef YAML_DEFINE_CONVERT_NUMBER
+
+// Decodes a sequence of numbers straight into values, which holds size
+// elements. Returns false if the node is not a sequence of size elements
+// that all decode as T. The elements are read in place, without a Node for
+// each, and their resolutions are cached just like as<T>() does; this is
+// what convert<std::vector<T>> uses for numbers.
 template <typename T>
-typename std::enable_if<(std::is_same<T, unsigned char>::value ||
-                         std::is_same<T, signed char>::value), bool>::type
-ConvertStreamTo(std::stringstream& stream, T& rhs) {
-  int num;
-  if ((stream >> std::noskipws >> num) && (stream >> std::ws).eof()) {
-    if (num >= (std::numeric_limits<T>::min)() &&
-        num <= (std::numeric_limits<T>::max)()) {
-      rhs = (T)num;
-      return true;
-    }
+bool DecodeNumbers(const Node& node, T* values, std::size_t size) {
+  static_assert(conversion::is_number<T>::value,
+                "DecodeNumbers() decodes integers, float and double");
+  if (node.Type() != NodeType::Sequence || node.size() != size)
+    return false;
+
+  node.m_pNode->thaw_elements(node.m_pMemory);
+  const detail::node& sequence = *node.m_pNode;
+  std::size_t i = 0;
+  for (auto it = sequence.begin(); it != sequence.end(); ++it, ++i) {
+    const detail::node& element = *(*it).pNode;
+    if (i == size || !conversion::DecodeNumber(element.resolved_scalar(),
+                                               element, values[i]))
+      return false;
   }
-  return false;
+  return i == size;
 }
 
-template <typename T>
-typename std::enable_if<!(std::is_same<T, unsigned char>::value ||
-                          std::is_same<T, signed char>::value), bool>::type
-ConvertStreamTo(std::stringstream& stream, T& rhs) {
-  if ((stream >> std::noskipws >> rhs) && (stream >> std::ws).eof()) {
+namespace conversion {
+template <typename T, typename A>
+bool DecodeNumbers(const Node& node, std::vector<T, A>& rhs,
+                   std::true_type /* is_number */) {
+  rhs.resize(node.size());
+  if (YAML::DecodeNumbers(node, rhs.data(), rhs.size()))
     return true;
-  }
+  rhs.clear();
   return false;
 }
-}
 
-#define YAML_DEFINE_CONVERT_STREAMABLE(type, negative_op)                  \
-  template <>                                                              \
-  struct convert<type> {                                                   \
-                                                                           \
-    static Node encode(const type& rhs) {                                  \
-      std::stringstream stream;                                            \
-      stream.precision(std::numeric_limits<type>::max_digits10);           \
-      conversion::inner_encode(rhs, stream);                               \
-      return Node(stream.str());                                           \
-    }                                                                      \
-                                                                           \
-    static bool decode(const Node& node, type& rhs) {                      \
-      if (node.Type() != NodeType::Scalar) {                               \
-        return false;                                                      \
-      }                                                                    \
-      const std::string& input = node.Scalar();                            \
-      std::stringstream stream(input);                                     \
-      stream.unsetf(std::ios::dec);                                        \
-      if ((stream.peek() == '-') && std::is_unsigned<type>::value) {       \
-        return false;                                                      \
-      }                                                                    \
-      if (conversion::ConvertStreamTo(stream, rhs)) {                      \
-        return true;                                                       \
-      }                                                                    \
-      if (std::numeric_limits<type>::has_infinity) {                       \
-        if (conversion::IsInfinity(input)) {                               \
-          rhs = std::numeric_limits<type>::infinity();                     \
-          return true;                                                     \
-        } else if (conversion::IsNegativeInfinity(input)) {                \
-          rhs = negative_op std::numeric_limits<type>::infinity();         \
-          return true;                                                     \
-        }                                                                  \
-      }                                                                    \
-                                                                           \
-      if (std::numeric_limits<type>::has_quiet_NaN) {                      \
-        if (conversion::IsNaN(input)) {                                    \
-          rhs = std::numeric_limits<type>::quiet_NaN();                    \
-          return true;                                                     \
-        }                                                                  \
-      }                                                                    \
-                                                                           \
-      return false;                                                        \
-    }                                                                      \
-  }
+template <typename T, typename A>
+bool DecodeNumbers(const Node& /* node */, std::vector<T, A>& /* rhs */,
+                   std::false_type /* is_number */) {
+  return false;
+}
 
-#define YAML_DEFINE_CONVERT_STREAMABLE_SIGNED(type) \
-  YAML_DEFINE_CONVERT_STREAMABLE(type, -)
+// Decodes the node into a new last element of the sequence, in place unless
+// the container has no references to its elements (std::vector<bool>).
+// Elements are decoded with TryDecode(), so a container that does not convert
+// fails as a whole, without an error for the element.
+template <typename C>
+bool DecodeBack(const Node& node, C& rhs) {
+  rhs.emplace_back();
+  return node.TryDecode(rhs.back());
+}
 
-#define YAML_DEFINE_CONVERT_STREAMABLE_UNSIGNED(type) \
-  YAML_DEFINE_CONVERT_STREAMABLE(type, +)
+template <typename A>
+bool DecodeBack(const Node& node, std::vector<bool, A>& rhs) {
+  bool value;
+  if (!node.TryDecode(value))
+    return false;
+  rhs.push_back(value);
+  return true;
+}
+}  // namespace conversion
 
-YAML_DEFINE_CONVERT_STREAMABLE_SIGNED(int);
-YAML_DEFINE_CONVERT_STREAMABLE_SIGNED(short);
-YAML_DEFINE_CONVERT_STREAMABLE_SIGNED(long);
-YAML_DEFINE_CONVERT_STREAMABLE_SIGNED(long long);
-YAML_DEFINE_CONVERT_STREAMABLE_UNSIGNED(unsigned);
-YAML_DEFINE_CONVERT_STREAMABLE_UNSIGNED(unsigned short);
-YAML_DEFINE_CONVERT_STREAMABLE_UNSIGNED(unsigned long);
-YAML_DEFINE_CONVERT_STREAMABLE_UNSIGNED(unsigned long long);
+// char is a single character, optionally followed by whitespace
+template <>
+struct convert<char> {
+  static Node encode(const char& rhs) { return Node(std::string(1, rhs)); }
 
-YAML_DEFINE_CONVERT_STREAMABLE_SIGNED(char);
-YAML_DEFINE_CONVERT_STREAMABLE_SIGNED(signed char);
-YAML_DEFINE_CONVERT_STREAMABLE_UNSIGNED(unsigned char);
+  static bool decode(const Node& node, char& rhs) {
+    if (node.Type() != NodeType::Scalar) {
+      return false;
+    }
+    const std::string& input = node.Scalar();
+    if (input.empty() ||
+        input.find_first_not_of(" \t\n\v\f\r", 1) != std::string::npos) {
+      return false;
+    }
+    rhs = input[0];
+    return true;
+  }
+};
 
-YAML_DEFINE_CONVERT_STREAMABLE_SIGNED(float);
-YAML_DEFINE_CONVERT_STREAMABLE_SIGNED(double);
-YAML_DEFINE_CONVERT_STREAMABLE_SIGNED(long double);
+// long double keeps its precision by going through a stream
+template <>
+struct convert<long double> {
+  static Node encode(const long double& rhs) {
+    std::stringstream stream;
+    stream.precision(std::numeric_limits<long double>::max_digits10);
+    conversion::inner_encode(rhs, stream);
+    return Node(stream.str());
+  }
 
-#undef YAML_DEFINE_CONVERT_STREAMABLE_SIGNED
-#undef YAML_DEFINE_CONVERT_STREAMABLE_UNSIGNED
-#undef YAML_DEFINE_CONVERT_STREAMABLE
+  static bool decode(const Node& node, long double& rhs) {
+    if (node.Type() != NodeType::Scalar) {
+      return false;
+    }
+    const std::string& input = node.Scalar();
+    std::stringstream stream(input);
+    stream.unsetf(std::ios::dec);
+    if (conversion::ConvertStreamTo(stream, rhs)) {
+      return true;
+    }
+    if (conversion::IsInfinity(input)) {
+      rhs = std::numeric_limits<long double>::infinity();
+      return true;
+    } else if (conversion::IsNegativeInfinity(input)) {
+      rhs = -std::numeric_limits<long double>::infinity();
+      return true;
+    } else if (conversion::IsNaN(input)) {
+      rhs = std::numeric_limits<long double>::quiet_NaN();
+      return true;
+    }
+    return false;
+  }
+};
 
 // bool
 template <>
@@ -223,6 +372,12 @@ struct convert<bool> {
   static Node encode(bool rhs) { return rhs ? Node("true") : Node("false"); }
 
   YAML_CPP_API static bool decode(const Node& node, bool& rhs);
+  YAML_CPP_API static bool decode(const ResolvedScalar& scalar,
+                                  const Node& node, bool& rhs);
+  // the same for the text of a scalar that is not in a Node
+  YAML_CPP_API static bool decode(const ResolvedScalar& scalar,
+                                  const char* data, std::size_t size,
+                                  bool& rhs);
 };
 
 // std::map
@@ -240,13 +395,11 @@ struct convert<std::map<K, V, C, A>> {
       return false;
 
     rhs.clear();
-    for (const auto& element : node)
-#if defined(__GNUC__) && __GNUC__ < 4
-      // workaround for GCC 3:
-      rhs[element.first.template as<K>()] = element.second.template as<V>();
-#else
-      rhs[element.first.as<K>()] = element.second.as<V>();
-#endif
+    for (const auto& element : node) {
+      K key;
+      if (!element.first.TryDecode(key) || !element.second.TryDecode(rhs[key]))
+        return false;
+    }
     return true;
   }
 };
@@ -266,13 +419,13 @@ struct convert<std::vector<T, A>> {
       return false;
 
     rhs.clear();
+    if (conversion::DecodeNumbers(node, rhs, conversion::is_number<T>()))
+      return true;
+
+    rhs.reserve(node.size());
     for (const auto& element : node)
-#if defined(__GNUC__) && __GNUC__ < 4
-      // workaround for GCC 3:
-      rhs.push_back(element.template as<T>());
-#else
-      rhs.push_back(element.as<T>());
-#endif
+      if (!conversion::DecodeBack(element, rhs))
+        return false;
     return true;
   }
 };
@@ -293,12 +446,8 @@ struct convert<std::list<T,A>> {
 
     rhs.clear();
     for (const auto& element : node)
-#if defined(__GNUC__) && __GNUC__ < 4
-      // workaround for GCC 3:
-      rhs.push_back(element.template as<T>());
-#else
-      rhs.push_back(element.as<T>());
-#endif
+      if (!conversion::DecodeBack(element, rhs))
+        return false;
     return true;
   }
 };
@@ -320,12 +469,8 @@ struct convert<std::array<T, N>> {
     }
 
     for (auto i = 0u; i < node.size(); ++i) {
-#if defined(__GNUC__) && __GNUC__ < 4
-      // workaround for GCC 3:
-      rhs[i] = node[i].template as<T>();
-#else
-      rhs[i] = node[i].as<T>();
-#endif
+      if (!node[i].TryDecode(rhs[i]))
+        return false;
     }
     return true;
   }
@@ -352,19 +497,7 @@ struct convert<std::pair<T, U>> {
     if (node.size() != 2)
       return false;
 
-#if defined(__GNUC__) && __GNUC__ < 4
-    // workaround for GCC 3:
-    rhs.first = node[0].template as<T>();
-#else
-    rhs.first = node[0].as<T>();
-#endif
-#if defined(__GNUC__) && __GNUC__ < 4
-    // workaround for GCC 3:
-    rhs.second = node[1].template as<U>();
-#else
-    rhs.second = node[1].as<U>();
-#endif
-    return true;
+    return node[0].TryDecode(rhs.first) && node[1].TryDecode(rhs.second);
   }
 };
 
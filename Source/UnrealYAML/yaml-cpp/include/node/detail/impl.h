@@ -11,6 +11,8 @@
 #include "node/detail/node_data.h"
 
 #include <algorithm>
+#include <cstring>
+#include <string>
 #include <type_traits>
 
 namespace YAML {
@@ -18,7 +20,7 @@ namespace detail {
 template <typename Key, typename Enable = void>
 struct get_idx {
   static node* get(const std::vector<node*>& /* sequence */,
-                   const Key& /* key */, shared_memory_holder /* pMemory */) {
+                   const Key& /* key */, const shared_memory_holder& /* pMemory */) {
     return nullptr;
   }
 };
@@ -28,12 +30,12 @@ struct get_idx<Key,
                typename std::enable_if<std::is_unsigned<Key>::value &&
                                        !std::is_same<Key, bool>::value>::type> {
   static node* get(const std::vector<node*>& sequence, const Key& key,
-                   shared_memory_holder /* pMemory */) {
+                   const shared_memory_holder& /* pMemory */) {
     return key < sequence.size() ? sequence[key] : nullptr;
   }
 
   static node* get(std::vector<node*>& sequence, const Key& key,
-                   shared_memory_holder pMemory) {
+                   const shared_memory_holder& pMemory) {
     if (key > sequence.size() || (key > 0 && !sequence[key - 1]->is_defined()))
       return nullptr;
     if (key == sequence.size())
@@ -45,13 +47,13 @@ struct get_idx<Key,
 template <typename Key>
 struct get_idx<Key, typename std::enable_if<std::is_signed<Key>::value>::type> {
   static node* get(const std::vector<node*>& sequence, const Key& key,
-                   shared_memory_holder pMemory) {
+                   const shared_memory_holder& pMemory) {
     return key >= 0 ? get_idx<std::size_t>::get(
                           sequence, static_cast<std::size_t>(key), pMemory)
                     : nullptr;
   }
   static node* get(std::vector<node*>& sequence, const Key& key,
-                   shared_memory_holder pMemory) {
+                   const shared_memory_holder& pMemory) {
     return key >= 0 ? get_idx<std::size_t>::get(
                           sequence, static_cast<std::size_t>(key), pMemory)
                     : nullptr;
@@ -96,8 +98,29 @@ struct remove_idx<Key,
   }
 };
 
+// String keys are matched against the scalar of the map keys directly, which
+// avoids decoding every key and lets large maps use their key index.
+inline bool string_key(const std::string& key, const char*& data,
+                       std::size_t& size) {
+  data = key.data();
+  size = key.size();
+  return true;
+}
+
+inline bool string_key(const char* key, const char*& data, std::size_t& size) {
+  data = key;
+  size = std::strlen(key);
+  return true;
+}
+
+template <typename Key>
+inline bool string_key(const Key& /* key */, const char*& /* data */,
+                       std::size_t& /* size */) {
+  return false;
+}
+
 template <typename T>
-inline bool node::equals(const T& rhs, shared_memory_holder pMemory) {
+inline bool node::equals(const T& rhs, const shared_memory_holder& pMemory) {
   T lhs;
   if (convert<T>::decode(Node(*this, pMemory), lhs)) {
     return lhs == rhs;
@@ -105,9 +128,9 @@ inline bool node::equals(const T& rhs, shared_memory_holder pMemory) {
   return false;
 }
 
-inline bool node::equals(const char* rhs, shared_memory_holder pMemory) {
+inline bool node::equals(const char* rhs, const shared_memory_holder& pMemory) {
   std::string lhs;
-  if (convert<std::string>::decode(Node(*this, std::move(pMemory)), lhs)) {
+  if (convert<std::string>::decode(Node(*this, pMemory), lhs)) {
     return lhs == rhs;
   }
   return false;
@@ -116,7 +139,8 @@ inline bool node::equals(const char* rhs, shared_memory_holder pMemory) {
 // indexing
 template <typename Key>
 inline node* node_data::get(const Key& key,
-                            shared_memory_holder pMemory) const {
+                            const shared_memory_holder& pMemory) const {
+  thaw_elements(pMemory);
   switch (m_type) {
     case NodeType::Map:
       break;
@@ -124,45 +148,64 @@ inline node* node_data::get(const Key& key,
     case NodeType::Null:
       return nullptr;
     case NodeType::Sequence:
-      if (node* pNode = get_idx<Key>::get(m_sequence, key, pMemory))
+      if (node* pNode = get_idx<Key>::get(m_sequence.nodes, key, pMemory))
         return pNode;
       return nullptr;
     case NodeType::Scalar:
-      throw BadSubscript(m_mark, key);
+      detail::raise(BadSubscript(m_mark, key));
+      return nullptr;
   }
 
-  auto it = std::find_if(m_map.begin(), m_map.end(), [&](const kv_pair m) {
-    return m.first->equals(key, pMemory);
-  });
+  const char* data;
+  std::size_t size;
+  if (string_key(key, data, size))
+    return lookup_string_key(data, size);
+
+  auto it = std::find_if(m_map.entries.begin(), m_map.entries.end(),
+                         [&](const kv_pair m) {
+                           return m.first->equals(key, pMemory);
+                         });
 
-  return it != m_map.end() ? it->second : nullptr;
+  return it != m_map.entries.end() ? it->second : nullptr;
 }
 
 template <typename Key>
-inline node& node_data::get(const Key& key, shared_memory_holder pMemory) {
+inline node& node_data::get(const Key& key, const shared_memory_holder& pMemory) {
+  thaw_elements(pMemory);
   switch (m_type) {
     case NodeType::Map:
       break;
     case NodeType::Undefined:
     case NodeType::Null:
     case NodeType::Sequence:
-      if (node* pNode = get_idx<Key>::get(m_sequence, key, pMemory)) {
-        m_type = NodeType::Sequence;
+      // an empty node may become a sequence if indexed with 0
+      if (m_type != NodeType::Sequence)
+        reset_payload(NodeType::Sequence);
+      if (node* pNode = get_idx<Key>::get(m_sequence.nodes, key, pMemory))
         return *pNode;
-      }
 
       convert_to_map(pMemory);
       break;
     case NodeType::Scalar:
-      throw BadSubscript(m_mark, key);
+      detail::raise(BadSubscript(m_mark, key));
+      // a node outside of the document, so changes to it go nowhere
+      return pMemory->create_node();
   }
 
-  auto it = std::find_if(m_map.begin(), m_map.end(), [&](const kv_pair m) {
-    return m.first->equals(key, pMemory);
-  });
+  const char* data;
+  std::size_t size;
+  if (string_key(key, data, size)) {
+    if (node* pValue = find_string_key(data, size))
+      return *pValue;
+  } else {
+    auto it = std::find_if(m_map.entries.begin(), m_map.entries.end(),
+                           [&](const kv_pair m) {
+                             return m.first->equals(key, pMemory);
+                           });
 
-  if (it != m_map.end()) {
-    return *it->second;
+    if (it != m_map.entries.end()) {
+      return *it->second;
+    }
   }
 
   node& k = convert_to_node(key, pMemory);
@@ -172,38 +215,42 @@ inline node& node_data::get(const Key& key, shared_memory_holder pMemory) {
 }
 
 template <typename Key>
-inline bool node_data::remove(const Key& key, shared_memory_holder pMemory) {
+inline bool node_data::remove(const Key& key, const shared_memory_holder& pMemory) {
+  thaw_elements(pMemory);
   if (m_type == NodeType::Sequence) {
-    return remove_idx<Key>::remove(m_sequence, key, m_seqSize);
+    std::size_t size = m_sequence.size.load(std::memory_order_relaxed);
+    const bool removed = remove_idx<Key>::remove(m_sequence.nodes, key, size);
+    m_sequence.size.store(size, std::memory_order_relaxed);
+    return removed;
   }
 
-  if (m_type == NodeType::Map) {
-    kv_pairs::iterator it = m_undefinedPairs.begin();
-    while (it != m_undefinedPairs.end()) {
-      kv_pairs::iterator jt = std::next(it);
-      if (it->first->equals(key, pMemory)) {
-        m_undefinedPairs.erase(it);
-      }
-      it = jt;
-    }
-
-    auto iter = std::find_if(m_map.begin(), m_map.end(), [&](const kv_pair m) {
-      return m.first->equals(key, pMemory);
-    });
+  if (m_type != NodeType::Map)
+    return false;
 
-    if (iter != m_map.end()) {
-      m_map.erase(iter);
-      return true;
-    }
+  std::size_t position;
+  const char* data;
+  std::size_t size;
+  if (string_key(key, data, size)) {
+    position = find_string_key_position(data, size);
+  } else {
+    position = std::find_if(m_map.entries.begin(), m_map.entries.end(),
+                            [&](const kv_pair m) {
+                              return m.first->equals(key, pMemory);
+                            }) -
+               m_map.entries.begin();
   }
 
-  return false;
+  if (position == m_map.entries.size())
+    return false;
+  erase_map_pair(position);
+  return true;
 }
 
 // map
 template <typename Key, typename Value>
 inline void node_data::force_insert(const Key& key, const Value& value,
-                                    shared_memory_holder pMemory) {
+                                    const shared_memory_holder& pMemory) {
+  thaw_elements(pMemory);
   switch (m_type) {
     case NodeType::Map:
       break;
@@ -213,7 +260,8 @@ inline void node_data::force_insert(const Key& key, const Value& value,
       convert_to_map(pMemory);
       break;
     case NodeType::Scalar:
-      throw BadInsert();
+      detail::raise(BadInsert());
+      return;
   }
 
   node& k = convert_to_node(key, pMemory);
@@ -223,7 +271,7 @@ inline void node_data::force_insert(const Key& key, const Value& value,
 
 template <typename T>
 inline node& node_data::convert_to_node(const T& rhs,
-                                        shared_memory_holder pMemory) {
+                                        const shared_memory_holder& pMemory) {
   Node value = convert<T>::encode(rhs);
   value.EnsureNodeExists();
   pMemory->merge(*value.m_pMemory);
@@ -13,6 +13,7 @@
 #include "node/ptr.h"
 #include <cstddef>
 #include <iterator>
+#include <utility>
 
 
 namespace YAML {
@@ -46,7 +47,7 @@ class iterator_base {
  public:
   iterator_base() : m_iterator(), m_pMemory() {}
   explicit iterator_base(base_type rhs, shared_memory_holder pMemory)
-      : m_iterator(rhs), m_pMemory(pMemory) {}
+      : m_iterator(rhs), m_pMemory(std::move(pMemory)) {}
 
   template <class W>
   iterator_base(const iterator_base<W>& rhs,
@@ -7,12 +7,13 @@
 #pragma once
 #endif
 
-#include <set>
-
+#include <cstddef>
+#include <vector>
 
 #include "node/ptr.h"
 
 namespace YAML {
+struct MemoryUsage;
 namespace detail {
 class node;
 }  // namespace detail
@@ -20,25 +21,90 @@ class node;
 
 namespace YAML {
 namespace detail {
-class YAML_CPP_API memory {
+// Owns every node of a document. Nodes are not allocated one by one but
+// placed into chunks of growing size, together with the node_ref and node_data
+// they start out with; all chunks are freed in one go when the memory dies.
+//
+// Merging two memories is a union-find operation: the smaller one hands its
+// chunk list over to the larger one and from then on only forwards to it.
+// Forwarded memories stay alive as long as something references them and
+// keep the memory that adopted their chunks alive in turn.
+//
+// Nodes that are removed or overwritten stay in their chunk until compact()
+// finds that no Node handle can reach them any more. Their slots are then
+// reused by create_node(), and chunks without any reachable node are freed.
+class YAML_CPP_API memory : public ref_counted {
  public:
-  memory() : m_nodes{} {}
+  memory();
+  ~memory();
+
+  // the memory that currently owns this memory's nodes
+  memory& root();
+
   node& create_node();
-  void merge(const memory& rhs);
+  void merge(memory& rhs);
+
+  // keeps a frozen document alive for as long as nodes of this memory may
+  // still thaw elements from it
+  void retain(const frozen_data& data);
+
+  // Frees everything that cannot be reached from a pinned node (see
+  // node::pin()) and returns the number of bytes reclaimed. Raw pointers into
+  // the freed nodes, as held by iterators and NodeViews, dangle afterwards.
+  std::size_t compact();
+
+  // the nodes in use, reachable or not, see GetNodeCount()
+  std::size_t size() const { return m_size; }
+  // adds what the memory holds to usage
+  void add_usage(MemoryUsage& usage) const;
+
+  // Adds the memory to the documents that listed_usage() reports on, if
+  // set_listing() turned listing on. Merging a listed memory lists the one it
+  // merges into; a memory leaves the list when it is destroyed. Both take
+  // constant time and lock one of a few mutexes; while listing is off,
+  // nothing is locked.
+  void list();
+  static void set_listing(bool enabled);
+  static bool is_listing();
+  // Only meant for when no listed document is being loaded or changed: the
+  // memories are counted while other threads may still use them.
+  static std::vector<MemoryUsage> listed_usage();
 
  private:
-  using Nodes = std::set<shared_node>;
-  Nodes m_nodes;
+  void link();
+  void unlist();
+
+  memory_chunk* m_pFirst;
+  memory_chunk* m_pLast;
+  // nodes in use, i.e. not counting the free ones
+  std::size_t m_size;
+  shared_memory m_pForward;
+  std::vector<ref_ptr<const frozen_data>> m_frozen;
+
+  // nodes whose slots compact() found unreachable, ready for reuse
+  std::vector<node*> m_free;
+  bool m_isListed;
+  memory* m_pPrevListed;
+  memory* m_pNextListed;
 };
 
-class YAML_CPP_API memory_holder {
+class YAML_CPP_API memory_holder : public ref_counted {
  public:
   memory_holder() : m_pMemory(new memory) {}
 
-  node& create_node() { return m_pMemory->create_node(); }
+  node& create_node() { return root().create_node(); }
   void merge(memory_holder& rhs);
+  void retain(const frozen_data& data) { root().retain(data); }
+
+  std::size_t compact() { return root().compact(); }
+  std::size_t size() { return root().size(); }
+
+  void add_usage(MemoryUsage& usage) { root().add_usage(usage); }
+  void list() { root().list(); }
 
  private:
+  memory& root();
+
   shared_memory m_pMemory;
 };
 }  // namespace detail
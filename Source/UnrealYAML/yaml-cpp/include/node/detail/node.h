@@ -12,24 +12,27 @@
 #include "node/detail/node_ref.h"
 #include "node/ptr.h"
 #include "node/type.h"
-#include <set>
-#include <atomic>
+#include <algorithm>
+#include <vector>
 
 namespace YAML {
 namespace detail {
 class node {
- private:
-  struct less {
-    bool operator ()(const node* l, const node* r) const {return l->m_index < r->m_index;}
-  };
-
  public:
-  node() : m_pRef(new node_ref), m_dependencies{}, m_index{} {}
+  explicit node(node_ref& ref)
+      : m_pRef(&ref), m_pDependency(nullptr), m_dependencies{}, m_pins{} {}
   node(const node&) = delete;
   node& operator=(const node&) = delete;
 
   bool is(const node& rhs) const { return m_pRef == rhs.m_pRef; }
-  const node_ref* ref() const { return m_pRef.get(); }
+  const node_ref* ref() const { return m_pRef; }
+  node_data& data() const { return m_pRef->data(); }
+
+  // Every Node handle that holds a memory pins its node; memory::compact()
+  // keeps whatever the pinned nodes can reach.
+  void pin() const { m_pins.increment(); }
+  void unpin() const { m_pins.decrement(); }
+  bool pinned() const { return m_pins.count() != 0; }
 
   bool is_defined() const { return m_pRef->is_defined(); }
   const Mark& mark() const { return m_pRef->mark(); }
@@ -39,36 +42,57 @@ class node {
   const std::string& tag() const { return m_pRef->tag(); }
   EmitterStyle style() const { return m_pRef->style(); }
 
+  ResolvedScalar resolved_scalar() const { return m_pRef->resolved_scalar(); }
+  bool get_resolved_scalar(ResolvedScalar& scalar) const {
+    return m_pRef->get_resolved_scalar(scalar);
+  }
+
   template <typename T>
-  bool equals(const T& rhs, shared_memory_holder pMemory);
-  bool equals(const char* rhs, shared_memory_holder pMemory);
+  bool equals(const T& rhs, const shared_memory_holder& pMemory);
+  bool equals(const char* rhs, const shared_memory_holder& pMemory);
 
   void mark_defined() {
     if (is_defined())
       return;
 
     m_pRef->mark_defined();
-    for (node* dependency : m_dependencies)
+
+    node* dependency = m_pDependency;
+    nodes dependencies;
+    dependencies.swap(m_dependencies);
+    m_pDependency = nullptr;
+    if (dependency)
       dependency->mark_defined();
-    m_dependencies.clear();
+    for (node* other : dependencies)
+      other->mark_defined();
   }
 
   void add_dependency(node& rhs) {
-    if (is_defined())
+    if (is_defined()) {
       rhs.mark_defined();
-    else
-      m_dependencies.insert(&rhs);
+    } else if (!m_pDependency || m_pDependency == &rhs) {
+      m_pDependency = &rhs;
+    } else if (std::find(m_dependencies.begin(), m_dependencies.end(), &rhs) ==
+               m_dependencies.end()) {
+      m_dependencies.push_back(&rhs);
+    }
   }
 
   void set_ref(const node& rhs) {
     if (rhs.is_defined())
       mark_defined();
+    node_data& data = m_pRef->data();
     m_pRef = rhs.m_pRef;
+    data.drop_key_indexes();
+    data.update_undefined_pairs(m_pRef->data());
   }
   void set_data(const node& rhs) {
     if (rhs.is_defined())
       mark_defined();
+    node_data& data = m_pRef->data();
     m_pRef->set_data(*rhs.m_pRef);
+    data.drop_key_indexes();
+    data.update_undefined_pairs(m_pRef->data());
   }
 
   void set_mark(const Mark& mark) { m_pRef->set_mark(mark); }
@@ -100,6 +124,11 @@ class node {
   // size/iterator
   std::size_t size() const { return m_pRef->size(); }
 
+  // begin() and end() skip elements that are still frozen; thaw them first
+  void thaw_elements(const shared_memory_holder& pMemory) const {
+    m_pRef->data().thaw_elements(pMemory);
+  }
+
   const_node_iterator begin() const {
     return static_cast<const node_ref&>(*m_pRef).begin();
   }
@@ -111,12 +140,11 @@ class node {
   node_iterator end() { return m_pRef->end(); }
 
   // sequence
-  void push_back(node& input, shared_memory_holder pMemory) {
+  void push_back(node& input, const shared_memory_holder& pMemory) {
     m_pRef->push_back(input, pMemory);
     input.add_dependency(*this);
-    m_index = m_amount.fetch_add(1);
   }
-  void insert(node& key, node& value, shared_memory_holder pMemory) {
+  void insert(node& key, node& value, const shared_memory_holder& pMemory) {
     m_pRef->insert(key, value, pMemory);
     key.add_dependency(*this);
     value.add_dependency(*this);
@@ -124,52 +152,60 @@ class node {
 
   // indexing
   template <typename Key>
-  node* get(const Key& key, shared_memory_holder pMemory) const {
+  node* get(const Key& key, const shared_memory_holder& pMemory) const {
     // NOTE: this returns a non-const node so that the top-level Node can wrap
     // it, and returns a pointer so that it can be nullptr (if there is no such
     // key).
     return static_cast<const node_ref&>(*m_pRef).get(key, pMemory);
   }
   template <typename Key>
-  node& get(const Key& key, shared_memory_holder pMemory) {
+  node& get(const Key& key, const shared_memory_holder& pMemory) {
     node& value = m_pRef->get(key, pMemory);
     value.add_dependency(*this);
     return value;
   }
   template <typename Key>
-  bool remove(const Key& key, shared_memory_holder pMemory) {
+  bool remove(const Key& key, const shared_memory_holder& pMemory) {
     return m_pRef->remove(key, pMemory);
   }
 
-  node* get(node& key, shared_memory_holder pMemory) const {
+  node* get(node& key, const shared_memory_holder& pMemory) const {
     // NOTE: this returns a non-const node so that the top-level Node can wrap
     // it, and returns a pointer so that it can be nullptr (if there is no such
     // key).
     return static_cast<const node_ref&>(*m_pRef).get(key, pMemory);
   }
-  node& get(node& key, shared_memory_holder pMemory) {
+  node& get(node& key, const shared_memory_holder& pMemory) {
     node& value = m_pRef->get(key, pMemory);
     key.add_dependency(*this);
     value.add_dependency(*this);
     return value;
   }
-  bool remove(node& key, shared_memory_holder pMemory) {
+  bool remove(node& key, const shared_memory_holder& pMemory) {
     return m_pRef->remove(key, pMemory);
   }
 
   // map
   template <typename Key, typename Value>
   void force_insert(const Key& key, const Value& value,
-                    shared_memory_holder pMemory) {
+                    const shared_memory_holder& pMemory) {
     m_pRef->force_insert(key, value, pMemory);
   }
 
  private:
-  shared_node_ref m_pRef;
-  using nodes = std::set<node*, less>;
+  // follows the references between nodes when compacting
+  friend class memory;
+
+  node_ref* m_pRef;
+
+  // Nodes to mark defined along with this one. Almost every undefined node
+  // has a single parent, which is kept inline; the vector only allocates
+  // when the same placeholder is reachable from several containers.
+  using nodes = std::vector<node*>;
+  node* m_pDependency;
   nodes m_dependencies;
-  size_t m_index;
-  static YAML_CPP_API std::atomic<size_t> m_amount;
+
+  mutable refcount_policy m_pins;
 };
 }  // namespace detail
 }  // namespace YAML
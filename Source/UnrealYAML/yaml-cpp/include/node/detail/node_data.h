@@ -7,8 +7,11 @@
 #pragma once
 #endif
 
-#include <list>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -18,8 +21,10 @@
 #include "node/iterator.h"
 #include "node/ptr.h"
 #include "node/type.h"
+#include "numeric.h"
 
 namespace YAML {
+class NodeView;
 namespace detail {
 class node;
 }  // namespace detail
@@ -30,6 +35,7 @@ namespace detail {
 class YAML_CPP_API node_data {
  public:
   node_data();
+  ~node_data();
   node_data(const node_data&) = delete;
   node_data& operator=(const node_data&) = delete;
 
@@ -46,10 +52,33 @@ class YAML_CPP_API node_data {
   NodeType type() const {
     return m_isDefined ? m_type : NodeType::Undefined;
   }
-  const std::string& scalar() const { return m_scalar; }
-  const std::string& tag() const { return m_tag; }
+  const std::string& scalar() const {
+    return m_type == NodeType::Scalar ? m_scalar.value : empty_scalar();
+  }
+  const std::string& tag() const;
   EmitterStyle style() const { return m_style; }
 
+  // How the scalar resolves in the core schema, see ResolveScalar(). It is
+  // computed on const access and kept until the scalar changes, published so
+  // that threads reading the same scalar at once do not race on it;
+  // get_resolved_scalar() only returns what is already there.
+  ResolvedScalar resolved_scalar() const {
+    ResolvedScalar scalar;
+    return get_resolved_scalar(scalar) ? scalar : resolve_scalar();
+  }
+  bool get_resolved_scalar(ResolvedScalar& scalar) const {
+    if (m_type != NodeType::Scalar)
+      return false;
+    const unsigned char type = m_resolvedType.load(std::memory_order_acquire);
+    if (type == 0 || type == kResolving)
+      return false;
+    scalar.type = static_cast<ScalarType>((type & ~kResolvedNegative) - 1);
+    scalar.negative = (type & kResolvedNegative) != 0;
+    std::memcpy(&scalar.magnitude, &m_scalar.resolvedValue,
+                sizeof(m_scalar.resolvedValue));
+    return true;
+  }
+
   // size/iterator
   std::size_t size() const;
 
@@ -65,11 +94,11 @@ class YAML_CPP_API node_data {
 
   // indexing
   template <typename Key>
-  node* get(const Key& key, shared_memory_holder pMemory) const;
+  node* get(const Key& key, const shared_memory_holder& pMemory) const;
   template <typename Key>
-  node& get(const Key& key, shared_memory_holder pMemory);
+  node& get(const Key& key, const shared_memory_holder& pMemory);
   template <typename Key>
-  bool remove(const Key& key, shared_memory_holder pMemory);
+  bool remove(const Key& key, const shared_memory_holder& pMemory);
 
   node* get(node& key, const shared_memory_holder& pMemory) const;
   node& get(node& key, const shared_memory_holder& pMemory);
@@ -78,48 +107,194 @@ class YAML_CPP_API node_data {
   // map
   template <typename Key, typename Value>
   void force_insert(const Key& key, const Value& value,
-                    shared_memory_holder pMemory);
+                    const shared_memory_holder& pMemory);
+
+  // Turns this data into a copy of a record of a frozen document. Scalars
+  // are copied right away; the elements of sequences and maps stay in the
+  // document until they are first needed, when thaw_elements() creates them
+  // from the records. The memory of the node must retain the document.
+  void thaw(const frozen_data& data, std::uint32_t index);
+  void thaw_elements(const shared_memory_holder& pMemory) const;
+  // if rhs is a sequence or map whose elements are still frozen, makes this
+  // data one with the same elements and returns true
+  bool share_frozen_elements(const node_data& rhs);
+  const frozen_data* frozen_document() const {
+    return m_isFrozen ? m_frozen.pData : nullptr;
+  }
+
+  // bytes allocated for the payload and side storage, roughly
+  std::size_t heap_size() const {
+    return scalar_heap_size() + container_heap_size() + tag_heap_size() +
+           side_heap_size();
+  }
+  // the same, split up: the scalar string, the element array and key index
+  // of a sequence or map, the tag string, and the rest of the side storage
+  std::size_t scalar_heap_size() const;
+  std::size_t container_heap_size() const;
+  std::size_t tag_heap_size() const;
+  std::size_t side_heap_size() const;
+
+  // undefined map entries
+  void add_undefined_pair(node_data& map, node& self, node& other);
+  void remove_undefined_pair(const node_data& map, const node& self,
+                             const node& other);
+  // Called when a node that referred to this data refers to replacement.
+  // The maps that hold this data hold the replacement from now on; if the
+  // node turned undefined, they count their undefined entries again.
+  void update_undefined_pairs(node_data& replacement);
+  void count_undefined_pairs();
+
+  // Key indexes hash the scalars of keys, so a change to the data of a key
+  // drops the index of every map that has it as a key; it is rebuilt on the
+  // next lookup. Called when a node that referred to this data refers to
+  // other data.
+  void drop_key_indexes();
 
  public:
   static const std::string& empty_scalar();
+  // the bytes a string holds outside of itself, none if it is stored inline
+  static std::size_t string_heap_size(const std::string& value);
 
  private:
-  void compute_seq_size() const;
-  void compute_map_size() const;
+  // reads the payload without filling in any of the caches
+  friend class YAML::NodeView;
+  // follows the references between nodes when compacting
+  friend class memory;
+
+  ResolvedScalar resolve_scalar() const;
+  std::size_t compute_seq_size() const;
+  void set_defined();
 
-  void reset_sequence();
-  void reset_map();
+  void reset_payload(NodeType type);
+  void destroy_payload();
 
   void insert_map_pair(node& key, node& value);
+  void erase_map_pair(std::size_t index);
+  void track_undefined_pair(node& key, node& value);
+  void release_undefined_pair(node& key, node& value);
+  node* find_string_key(const char* key, std::size_t size);
+  node* lookup_string_key(const char* key, std::size_t size) const;
+  // the position of the entry that find_string_key() and
+  // lookup_string_key() return, or the number of entries if there is none
+  std::size_t find_string_key_position(const char* key, std::size_t size);
+  std::size_t lookup_string_key_position(const char* key,
+                                         std::size_t size) const;
+  void build_key_index();
+  void index_key(std::size_t position);
+  void unindex_key(std::size_t position);
+  void drop_key_index();
+  void add_indexing_map(node_data& map);
+  void add_holding_map(node_data& map);
   void convert_to_map(const shared_memory_holder& pMemory);
   void convert_sequence_to_map(const shared_memory_holder& pMemory);
 
   template <typename T>
-  static node& convert_to_node(const T& rhs, shared_memory_holder pMemory);
+  static node& convert_to_node(const T& rhs, const shared_memory_holder& pMemory);
 
  private:
-  bool m_isDefined;
+  using node_seq = std::vector<node*>;
+  using node_map = std::vector<std::pair<node*, node*>>;
+  using kv_pair = std::pair<node*, node*>;
+
+  // hash of a scalar key -> position in the entries, built when the map
+  // grows large enough, updated when entries are added or erased and
+  // dropped when, see drop_key_indexes(), a key changes. Only the paths that
+  // change the map build it, so const lookups never write to the map.
+  //
+  // The slots are open addressed with linear probing and kept at most half
+  // full, so that building the index takes one allocation instead of one
+  // per key.
+  struct key_slot {
+    std::size_t hash;
+    // the position of the entry + 1, 0 if the slot is free
+    std::size_t position;
+  };
+  struct key_index {
+    std::size_t size;
+    // a power of two of them
+    std::vector<key_slot> slots;
+  };
+
+  struct scalar_payload {
+    std::string value;
+    // the value of the cached resolution, see m_resolvedType
+    mutable std::uint64_t resolvedValue;
+  };
+
+  struct sequence_payload {
+    node_seq nodes;
+    // length of the prefix of defined nodes, counted on const access; atomic
+    // so that threads reading the sequence at once may all update it
+    mutable std::atomic<std::size_t> size;
+  };
+
+  struct map_payload {
+    node_map entries;
+    // number of entries whose key or value is not defined yet
+    std::size_t undefinedPairs;
+    std::unique_ptr<key_index> pKeyIndex;
+  };
+
+  // a sequence or map whose elements are still in a frozen document
+  struct frozen_payload {
+    const frozen_data* pData;
+    std::uint32_t index;
+  };
+
+  // entries of other maps that wait for this node to become defined; 'self'
+  // is the key or value that refers to this data, 'other' its counterpart
+  struct undefined_pair {
+    node_data* map;
+    node* self;
+    node* other;
+  };
+
+  // the common tags set by the parser are stored without a string
+  enum class tag_kind : unsigned char { None, NonSpecific, NonPlain, Other };
+
+  // rarely needed state, allocated on first use
+  struct side_storage {
+    std::string tag;
+    std::vector<undefined_pair> waitingPairs;
+    // maps with a key index that has this data as a key, after the first
+    std::vector<node_data*> indexingMaps;
+    // maps with an entry that refers to this data, after the first
+    std::vector<node_data*> holdingMaps;
+  };
+  side_storage& side();
+
+  // kept small, so that everything up to m_resolvedType fits into 16 bytes
   Mark m_mark;
   NodeType m_type;
-  std::string m_tag;
   EmitterStyle m_style;
+  bool m_isDefined : 1;
+  bool m_isFrozen : 1;
+  tag_kind m_tagKind : 2;
+  // 0 until the scalar is resolved, then the ScalarType + 1, with
+  // kResolvedNegative set for negative Ints. The thread that resolves the
+  // scalar first claims it with kResolving, writes the value and only then
+  // stores the type, so a reader that sees the type also sees the value.
+  static const unsigned char kResolvedNegative = 0x80;
+  static const unsigned char kResolving = 0x7f;
+  mutable std::atomic<unsigned char> m_resolvedType;
 
-  // scalar
-  std::string m_scalar;
-
-  // sequence
-  using node_seq = std::vector<node *>;
-  node_seq m_sequence;
+  // the map whose key index, if it still has one, has this data as a key
+  node_data* m_pIndexingMap;
+  // a map with an entry whose key or value refers to this data, or did: maps
+  // do not unregister when an entry is erased or they stop being maps
+  node_data* m_pHoldingMap;
 
-  mutable std::size_t m_seqSize;
+  // Only the member matching m_type is alive: m_scalar for scalars,
+  // m_sequence for sequences, m_map for maps and none of them otherwise.
+  // While m_isFrozen is set, sequences and maps hold m_frozen instead.
+  union {
+    scalar_payload m_scalar;
+    sequence_payload m_sequence;
+    map_payload m_map;
+    frozen_payload m_frozen;
+  };
 
-  // map
-  using node_map = std::vector<std::pair<node*, node*>>;
-  node_map m_map;
-
-  using kv_pair = std::pair<node*, node*>;
-  using kv_pairs = std::list<kv_pair>;
-  mutable kv_pairs m_undefinedPairs;
+  std::unique_ptr<side_storage> m_pSide;
 };
 }
 }
@@ -72,18 +72,27 @@ class node_iterator_base {
   using MapIter = typename node_iterator_type<V>::map;
 
   node_iterator_base()
-      : m_type(iterator_type::NoneType), m_seqIt(), m_mapIt(), m_mapEnd() {}
+      : m_type(iterator_type::NoneType),
+        m_seqIt(),
+        m_mapIt(),
+        m_mapEnd(),
+        m_hasUndefined(false) {}
   explicit node_iterator_base(SeqIter seqIt)
       : m_type(iterator_type::Sequence),
         m_seqIt(seqIt),
         m_mapIt(),
-        m_mapEnd() {}
-  explicit node_iterator_base(MapIter mapIt, MapIter mapEnd)
+        m_mapEnd(),
+        m_hasUndefined(false) {}
+  // hasUndefined: if the map may contain entries that have to be skipped
+  explicit node_iterator_base(MapIter mapIt, MapIter mapEnd,
+                              bool hasUndefined = true)
       : m_type(iterator_type::Map),
         m_seqIt(),
         m_mapIt(mapIt),
-        m_mapEnd(mapEnd) {
-    m_mapIt = increment_until_defined(m_mapIt);
+        m_mapEnd(mapEnd),
+        m_hasUndefined(hasUndefined) {
+    if (m_hasUndefined)
+      m_mapIt = increment_until_defined(m_mapIt);
   }
 
   template <typename W>
@@ -93,7 +102,8 @@ class node_iterator_base {
       : m_type(rhs.m_type),
         m_seqIt(rhs.m_seqIt),
         m_mapIt(rhs.m_mapIt),
-        m_mapEnd(rhs.m_mapEnd) {}
+        m_mapEnd(rhs.m_mapEnd),
+        m_hasUndefined(rhs.m_hasUndefined) {}
 
   template <typename>
   friend class node_iterator_base;
@@ -128,7 +138,8 @@ class node_iterator_base {
         break;
       case iterator_type::Map:
         ++m_mapIt;
-        m_mapIt = increment_until_defined(m_mapIt);
+        if (m_hasUndefined)
+          m_mapIt = increment_until_defined(m_mapIt);
         break;
     }
     return *this;
@@ -169,6 +180,7 @@ class node_iterator_base {
 
   SeqIter m_seqIt;
   MapIter m_mapIt, m_mapEnd;
+  bool m_hasUndefined;
 };
 
 using node_iterator = node_iterator_base<node>;
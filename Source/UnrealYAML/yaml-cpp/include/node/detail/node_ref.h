@@ -16,10 +16,12 @@ namespace YAML {
 namespace detail {
 class node_ref {
  public:
-  node_ref() : m_pData(new node_data) {}
+  explicit node_ref(node_data& data) : m_pData(&data) {}
   node_ref(const node_ref&) = delete;
   node_ref& operator=(const node_ref&) = delete;
 
+  node_data& data() const { return *m_pData; }
+
   bool is_defined() const { return m_pData->is_defined(); }
   const Mark& mark() const { return m_pData->mark(); }
   NodeType type() const { return m_pData->type(); }
@@ -27,6 +29,11 @@ class node_ref {
   const std::string& tag() const { return m_pData->tag(); }
   EmitterStyle style() const { return m_pData->style(); }
 
+  ResolvedScalar resolved_scalar() const { return m_pData->resolved_scalar(); }
+  bool get_resolved_scalar(ResolvedScalar& scalar) const {
+    return m_pData->get_resolved_scalar(scalar);
+  }
+
   void mark_defined() { m_pData->mark_defined(); }
   void set_data(const node_ref& rhs) { m_pData = rhs.m_pData; }
 
@@ -51,46 +58,46 @@ class node_ref {
   node_iterator end() { return m_pData->end(); }
 
   // sequence
-  void push_back(node& node, shared_memory_holder pMemory) {
+  void push_back(node& node, const shared_memory_holder& pMemory) {
     m_pData->push_back(node, pMemory);
   }
-  void insert(node& key, node& value, shared_memory_holder pMemory) {
+  void insert(node& key, node& value, const shared_memory_holder& pMemory) {
     m_pData->insert(key, value, pMemory);
   }
 
   // indexing
   template <typename Key>
-  node* get(const Key& key, shared_memory_holder pMemory) const {
+  node* get(const Key& key, const shared_memory_holder& pMemory) const {
     return static_cast<const node_data&>(*m_pData).get(key, pMemory);
   }
   template <typename Key>
-  node& get(const Key& key, shared_memory_holder pMemory) {
+  node& get(const Key& key, const shared_memory_holder& pMemory) {
     return m_pData->get(key, pMemory);
   }
   template <typename Key>
-  bool remove(const Key& key, shared_memory_holder pMemory) {
+  bool remove(const Key& key, const shared_memory_holder& pMemory) {
     return m_pData->remove(key, pMemory);
   }
 
-  node* get(node& key, shared_memory_holder pMemory) const {
+  node* get(node& key, const shared_memory_holder& pMemory) const {
     return static_cast<const node_data&>(*m_pData).get(key, pMemory);
   }
-  node& get(node& key, shared_memory_holder pMemory) {
+  node& get(node& key, const shared_memory_holder& pMemory) {
     return m_pData->get(key, pMemory);
   }
-  bool remove(node& key, shared_memory_holder pMemory) {
+  bool remove(node& key, const shared_memory_holder& pMemory) {
     return m_pData->remove(key, pMemory);
   }
 
   // map
   template <typename Key, typename Value>
   void force_insert(const Key& key, const Value& value,
-                    shared_memory_holder pMemory) {
+                    const shared_memory_holder& pMemory) {
     m_pData->force_insert(key, value, pMemory);
   }
 
  private:
-  shared_node_data m_pData;
+  node_data* m_pData;
 };
 }
 }
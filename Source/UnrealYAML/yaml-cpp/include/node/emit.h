@@ -7,6 +7,7 @@
 #pragma once
 #endif
 
+#include <cstddef>
 #include <string>
 #include <iosfwd>
 
@@ -14,6 +15,7 @@
 
 namespace YAML {
 class Emitter;
+class JsonEmitter;
 class Node;
 
 /**
@@ -27,6 +29,25 @@ YAML_CPP_API std::ostream& operator<<(std::ostream& out, const Node& node);
 
 /** Converts the node to a YAML string. */
 YAML_CPP_API std::string Dump(const Node& node);
+
+/**
+ * Writes the node to the given {@link JsonEmitter}, see {@link DumpJson}. If
+ * the node contains itself, {@link JsonEmitter#good} will return false.
+ */
+YAML_CPP_API JsonEmitter& operator<<(JsonEmitter& out, const Node& node);
+
+/**
+ * Converts the node to a JSON string: minimal if indent is 0, and with every
+ * element on its own line, indented by indent spaces per level, otherwise.
+ *
+ * Null nodes are null, quoted scalars and those tagged !!str are strings,
+ * and plain scalars are resolved in the core schema: booleans, numbers and
+ * everything else as strings. Infinities and NaN are null. Map keys are
+ * written as their text, or as the minimal JSON of sequences and maps.
+ * Aliases are written out in full. Returns an empty string if the node
+ * contains itself.
+ */
+YAML_CPP_API std::string DumpJson(const Node& node, std::size_t indent = 0);
 }  // namespace YAML
 
 #endif  // NODE_EMIT_H_62B23520_7C8E_11DE_8A39_0800200C9A66
@@ -0,0 +1,238 @@
+#ifndef NODE_FROZEN_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+#define NODE_FROZEN_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+
+#if defined(_MSC_VER) ||                                            \
+    (defined(__GNUC__) && (__GNUC__ == 3 && __GNUC_MINOR__ >= 4) || \
+     (__GNUC__ >= 4))  // GCC supports "pragma once" correctly since 3.4
+#pragma once
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include "emitterstyle.h"
+#include "exceptions.h"
+#include "mark.h"
+#include "node/convert.h"
+#include "node/impl.h"
+#include "node/node.h"
+#include "node/ptr.h"
+#include "node/type.h"
+#include "numeric.h"
+
+namespace YAML {
+namespace detail {
+struct frozen_data;
+
+// the types FrozenNode decodes straight from the document
+template <typename T>
+struct frozen_scalar
+    : std::integral_constant<bool, conversion::is_number<T>::value ||
+                                       std::is_same<T, bool>::value ||
+                                       std::is_same<T, std::string>::value> {};
+
+template <typename Key>
+inline bool frozen_index(const Key& key, std::size_t& index, std::true_type) {
+  if (key < 0)
+    return false;
+  index = static_cast<std::size_t>(key);
+  return true;
+}
+
+template <typename Key>
+inline bool frozen_index(const Key& key, std::size_t& index, std::false_type) {
+  index = static_cast<std::size_t>(key);
+  return true;
+}
+}  // namespace detail
+
+class FrozenDocument;
+
+/**
+ * A read-only view of one node of a {@link FrozenDocument}.
+ *
+ * FrozenNodes are plain pointers into the document: copying them and every
+ * query below neither allocates nor writes to any shared state, so any
+ * number of threads may read the same document at once. A lookup that finds
+ * nothing returns an undefined node instead of throwing.
+ *
+ * The document must outlive all views into it.
+ */
+class YAML_CPP_API FrozenNode {
+ public:
+  FrozenNode() : m_pData(nullptr), m_index(0) {}
+
+  bool IsDefined() const { return m_pData != nullptr; }
+  explicit operator bool() const { return IsDefined(); }
+  bool operator!() const { return !IsDefined(); }
+
+  NodeType Type() const;
+  bool IsNull() const { return Type() == NodeType::Null; }
+  bool IsScalar() const { return Type() == NodeType::Scalar; }
+  bool IsSequence() const { return Type() == NodeType::Sequence; }
+  bool IsMap() const { return Type() == NodeType::Map; }
+
+  YAML::Mark Mark() const;
+  EmitterStyle Style() const;
+  const std::string& Tag() const;
+
+  // The scalar is stored in the document's string blob; ScalarData() points
+  // there and is not null-terminated.
+  const char* ScalarData() const;
+  std::size_t ScalarSize() const;
+  std::string Scalar() const { return std::string(ScalarData(), ScalarSize()); }
+
+  // number of elements of a sequence or entries of a map, 0 otherwise
+  std::size_t size() const;
+
+  // the i-th element of a sequence, or the key / value of the i-th map entry
+  FrozenNode at(std::size_t index) const;
+  FrozenNode key_at(std::size_t index) const;
+  FrozenNode value_at(std::size_t index) const;
+
+  // Sequences are indexed by integers. Maps are searched for a scalar key
+  // equal to the given key; integers and other types are looked up by their
+  // encoded scalar.
+  template <typename Key>
+  FrozenNode operator[](const Key& key) const;
+  FrozenNode operator[](const std::string& key) const {
+    return find(key.data(), key.size());
+  }
+  FrozenNode operator[](const char* key) const {
+    return find(key, std::strlen(key));
+  }
+
+  // Numbers, bool and std::string are decoded straight from the document,
+  // like everything above. Other types go through convert<T> on a mutable
+  // copy of this subtree, see Thaw(), which is private to the calling thread.
+  template <typename T>
+  T as() const {
+    T value;
+    if (TryDecode(value))
+      return value;
+    detail::raise(TypedBadConversion<T>(Mark()));
+    return T();
+  }
+  template <typename T, typename S>
+  T as(const S& fallback) const {
+    T value;
+    if (IsDefined() && TryDecode(value))
+      return value;
+    return fallback;
+  }
+  template <typename T>
+  bool TryDecode(T& rhs) const {
+    return decode(rhs, detail::frozen_scalar<T>());
+  }
+
+  // A mutable copy of this subtree. The copy is made lazily: the elements of
+  // a sequence or map are only copied out of the document when they are
+  // first accessed, so changing one value copies the containers on its path
+  // and leaves everything else shared with the document, which is kept alive
+  // until the copy no longer needs it. Subtrees of documents with aliases are
+  // copied right away.
+  Node Thaw() const;
+
+  bool is(const FrozenNode& rhs) const {
+    return m_pData == rhs.m_pData && m_index == rhs.m_index;
+  }
+
+ private:
+  friend class FrozenDocument;
+  friend class NodeView;
+
+  FrozenNode(const detail::frozen_data* pData, std::uint32_t index)
+      : m_pData(pData), m_index(index) {}
+
+  FrozenNode find(const char* key, std::size_t size) const;
+
+  template <typename T>
+  bool decode(T& rhs, std::true_type /* scalar */) const {
+    return decode_scalar(rhs);
+  }
+  template <typename T>
+  bool decode(T& rhs, std::false_type /* scalar */) const {
+    return Thaw().TryDecode(rhs);
+  }
+  template <typename T>
+  bool decode_scalar(T& rhs) const {
+    return IsScalar() && conversion::DecodeNumber(resolved_scalar(), *this,
+                                                  rhs);
+  }
+  bool decode_scalar(bool& rhs) const;
+  bool decode_scalar(std::string& rhs) const;
+  ResolvedScalar resolved_scalar() const {
+    return ResolveScalar(ScalarData(), ScalarSize());
+  }
+
+  template <typename Key>
+  FrozenNode get(const Key& key, std::true_type /* integral */) const;
+  template <typename Key>
+  FrozenNode get(const Key& key, std::false_type /* integral */) const;
+
+  const detail::frozen_data* m_pData;
+  std::uint32_t m_index;
+};
+
+/**
+ * An immutable copy of a node tree, stored as flat arrays: one record per
+ * node, the children of all sequences and maps in one CSR-style index array
+ * and all scalars in one string blob. Aliased nodes are stored once.
+ *
+ * Reading through {@link FrozenNode} is safe from any number of threads
+ * without locking.
+ */
+class YAML_CPP_API FrozenDocument {
+ public:
+  FrozenDocument();
+  explicit FrozenDocument(const Node& root);
+  FrozenDocument(FrozenDocument&& rhs);
+  FrozenDocument& operator=(FrozenDocument&& rhs);
+  ~FrozenDocument();
+
+  FrozenDocument(const FrozenDocument&) = delete;
+  FrozenDocument& operator=(const FrozenDocument&) = delete;
+
+  FrozenNode Root() const;
+
+  // number of distinct nodes
+  std::size_t size() const;
+
+ private:
+  detail::ref_ptr<const detail::frozen_data> m_pData;
+};
+
+/** Converts the node and everything below it into a {@link FrozenDocument}. */
+YAML_CPP_API FrozenDocument Freeze(const Node& node);
+
+template <typename Key>
+inline FrozenNode FrozenNode::operator[](const Key& key) const {
+  return get(key, std::integral_constant<bool, std::is_integral<Key>::value &&
+                                                   !std::is_same<Key, bool>::value>());
+}
+
+template <typename Key>
+inline FrozenNode FrozenNode::get(const Key& key, std::true_type) const {
+  if (Type() == NodeType::Sequence) {
+    std::size_t index;
+    if (!detail::frozen_index(key, index, std::is_signed<Key>()) ||
+        index >= size())
+      return FrozenNode();
+    return at(index);
+  }
+  return (*this)[std::to_string(key)];
+}
+
+template <typename Key>
+inline FrozenNode FrozenNode::get(const Key& key, std::false_type) const {
+  if (Type() != NodeType::Map)
+    return FrozenNode();
+  const Node encoded = convert<Key>::encode(key);
+  return encoded.IsScalar() ? (*this)[encoded.Scalar()] : FrozenNode();
+}
+}  // namespace YAML
+
+#endif  // NODE_FROZEN_H_62B23520_7C8E_11DE_8A39_0800200C9A66
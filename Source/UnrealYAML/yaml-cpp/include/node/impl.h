@@ -14,6 +14,8 @@
 #include "node/node.h"
 #include <sstream>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 namespace YAML {
 inline Node::Node()
@@ -24,6 +26,7 @@ inline Node::Node(NodeType type)
       m_invalidKey{},
       m_pMemory(new detail::memory_holder),
       m_pNode(&m_pMemory->create_node()) {
+  Pin();
   m_pNode->set_type(type);
 }
 
@@ -33,6 +36,7 @@ inline Node::Node(const T& rhs)
       m_invalidKey{},
       m_pMemory(new detail::memory_holder),
       m_pNode(&m_pMemory->create_node()) {
+  Pin();
   Assign(rhs);
 }
 
@@ -40,9 +44,17 @@ inline Node::Node(const detail::iterator_value& rhs)
     : m_isValid(rhs.m_isValid),
       m_invalidKey(rhs.m_invalidKey),
       m_pMemory(rhs.m_pMemory),
-      m_pNode(rhs.m_pNode) {}
+      m_pNode(rhs.m_pNode) {
+  Pin();
+}
 
-inline Node::Node(const Node&) = default;
+inline Node::Node(const Node& rhs)
+    : m_isValid(rhs.m_isValid),
+      m_invalidKey(rhs.m_invalidKey),
+      m_pMemory(rhs.m_pMemory),
+      m_pNode(rhs.m_pNode) {
+  Pin();
+}
 
 inline Node::Node(Zombie)
     : m_isValid(false), m_invalidKey{}, m_pMemory{}, m_pNode(nullptr) {}
@@ -51,18 +63,37 @@ inline Node::Node(Zombie, const std::string& key)
     : m_isValid(false), m_invalidKey(key), m_pMemory{}, m_pNode(nullptr) {}
 
 inline Node::Node(detail::node& node, detail::shared_memory_holder pMemory)
-    : m_isValid(true), m_invalidKey{}, m_pMemory(pMemory), m_pNode(&node) {}
+    : m_isValid(true),
+      m_invalidKey{},
+      m_pMemory(std::move(pMemory)),
+      m_pNode(&node) {
+  Pin();
+}
 
-inline Node::~Node() = default;
+inline Node::~Node() { Unpin(); }
 
-inline void Node::EnsureNodeExists() const {
-  if (!m_isValid)
-    throw InvalidNode(m_invalidKey);
+inline void Node::Pin() const {
+  if (m_pNode && m_pMemory)
+    m_pNode->pin();
+}
+
+inline void Node::Unpin() const {
+  if (m_pNode && m_pMemory)
+    m_pNode->unpin();
+}
+
+inline bool Node::EnsureNodeExists() const {
+  if (!m_isValid) {
+    detail::raise(InvalidNode(m_invalidKey));
+    return false;
+  }
   if (!m_pNode) {
     m_pMemory.reset(new detail::memory_holder);
     m_pNode = &m_pMemory->create_node();
+    Pin();
     m_pNode->set_null();
   }
+  return true;
 }
 
 inline bool Node::IsDefined() const {
@@ -74,20 +105,62 @@ inline bool Node::IsDefined() const {
 
 inline Mark Node::Mark() const {
   if (!m_isValid) {
-    throw InvalidNode(m_invalidKey);
+    detail::raise(InvalidNode(m_invalidKey));
+    return Mark::null_mark();
   }
   return m_pNode ? m_pNode->mark() : Mark::null_mark();
 }
 
 inline NodeType Node::Type() const {
-  if (!m_isValid)
-    throw InvalidNode(m_invalidKey);
+  if (!m_isValid) {
+    detail::raise(InvalidNode(m_invalidKey));
+    return NodeType::Undefined;
+  }
   return m_pNode ? m_pNode->type() : NodeType::Null;
 }
 
 // access
 
 // template helpers
+namespace detail {
+// convert<T> specializations that also decode from the resolved scalar of
+// the node, with decode(const ResolvedScalar&, const Node&, T&)
+template <typename T, typename = void>
+struct decodes_resolved_scalar : std::false_type {};
+
+template <typename T>
+struct decodes_resolved_scalar<
+    T, decltype(void(convert<T>::decode(std::declval<const ResolvedScalar&>(),
+                                        std::declval<const Node&>(),
+                                        std::declval<T&>())))>
+    : std::true_type {};
+
+template <typename T>
+inline bool decode_node(const Node& node, const detail::node& data, T& value,
+                        std::true_type /* resolved */) {
+  return convert<T>::decode(data.resolved_scalar(), node, value);
+}
+
+template <typename T>
+inline bool decode_node(const Node& node, const detail::node& /* data */,
+                        T& value, std::false_type /* resolved */) {
+  return convert<T>::decode(node, value);
+}
+
+template <typename T>
+inline bool decode_resolved(const ResolvedScalar& scalar, const Node& node,
+                            T& value, std::true_type /* resolved */) {
+  return convert<T>::decode(scalar, node, value);
+}
+
+template <typename T>
+inline bool decode_resolved(const ResolvedScalar& /* scalar */,
+                            const Node& node, T& value,
+                            std::false_type /* resolved */) {
+  return convert<T>::decode(node, value);
+}
+}  // namespace detail
+
 template <typename T, typename S>
 struct as_if {
   explicit as_if(const Node& node_) : node(node_) {}
@@ -98,7 +171,8 @@ struct as_if {
       return fallback;
 
     T t;
-    if (convert<T>::decode(node, t))
+    if (detail::decode_node(node, *node.m_pNode, t,
+                            detail::decodes_resolved_scalar<T>()))
       return t;
     return fallback;
   }
@@ -124,13 +198,25 @@ struct as_if<T, void> {
   const Node& node;
 
   T operator()() const {
-    if (!node.m_pNode)
-      throw TypedBadConversion<T>(node.Mark());
-
     T t;
-    if (convert<T>::decode(node, t))
+    if ((*this)(t))
       return t;
-    throw TypedBadConversion<T>(node.Mark());
+    return T();
+  }
+
+  bool operator()(T& t) const {
+    if (!decode(t)) {
+      detail::raise(TypedBadConversion<T>(node.Mark()));
+      return false;
+    }
+    return true;
+  }
+
+  // the conversion alone, which raises nothing
+  bool decode(T& t) const {
+    return node.m_pNode &&
+           detail::decode_node(node, *node.m_pNode, t,
+                               detail::decodes_resolved_scalar<T>());
   }
 };
 
@@ -142,17 +228,39 @@ struct as_if<std::string, void> {
   std::string operator()() const {
     if (node.Type() == NodeType::Null)
       return "null";
-    if (node.Type() != NodeType::Scalar)
-      throw TypedBadConversion<std::string>(node.Mark());
+    if (node.Type() != NodeType::Scalar) {
+      detail::raise(TypedBadConversion<std::string>(node.Mark()));
+      return std::string();
+    }
     return node.Scalar();
   }
+
+  bool operator()(std::string& t) const {
+    if (!decode(t)) {
+      detail::raise(TypedBadConversion<std::string>(node.Mark()));
+      return false;
+    }
+    return true;
+  }
+
+  bool decode(std::string& t) const {
+    if (node.Type() == NodeType::Null)
+      t = "null";
+    else if (node.Type() == NodeType::Scalar)
+      t = node.Scalar();
+    else
+      return false;
+    return true;
+  }
 };
 
 // access functions
 template <typename T>
 inline T Node::as() const {
-  if (!m_isValid)
-    throw InvalidNode(m_invalidKey);
+  if (!m_isValid) {
+    detail::raise(InvalidNode(m_invalidKey));
+    return T();
+  }
   return as_if<T, void>(*this)();
 }
 
@@ -163,38 +271,72 @@ inline T Node::as(const S& fallback) const {
   return as_if<T, S>(*this)(fallback);
 }
 
+template <typename T>
+inline void Node::DecodeInto(T& rhs) const {
+  if (!m_isValid) {
+    detail::raise(InvalidNode(m_invalidKey));
+    return;
+  }
+  as_if<T, void>(*this)(rhs);
+}
+
+template <typename T>
+inline bool Node::TryDecode(T& rhs) const {
+  return m_isValid && as_if<T, void>(*this).decode(rhs);
+}
+
+template <typename Key, typename T>
+inline bool Node::TryDecode(const Key& key, T& rhs) const {
+  // a scalar can't be indexed, see operator[]
+  if (!m_isValid || !m_pNode || m_pNode->type() == NodeType::Scalar)
+    return false;
+  detail::node* value =
+      static_cast<const detail::node&>(*m_pNode).get(key, m_pMemory);
+  return value && Node(*value, m_pMemory).TryDecode(rhs);
+}
+
 inline const std::string& Node::Scalar() const {
-  if (!m_isValid)
-    throw InvalidNode(m_invalidKey);
+  if (!m_isValid) {
+    detail::raise(InvalidNode(m_invalidKey));
+    return detail::node_data::empty_scalar();
+  }
   return m_pNode ? m_pNode->scalar() : detail::node_data::empty_scalar();
 }
 
 inline const std::string& Node::Tag() const {
-  if (!m_isValid)
-    throw InvalidNode(m_invalidKey);
+  if (!m_isValid) {
+    detail::raise(InvalidNode(m_invalidKey));
+    return detail::node_data::empty_scalar();
+  }
   return m_pNode ? m_pNode->tag() : detail::node_data::empty_scalar();
 }
 
 inline void Node::SetTag(const std::string& tag) {
-  EnsureNodeExists();
+  if (!EnsureNodeExists())
+    return;
   m_pNode->set_tag(tag);
 }
 
 inline EmitterStyle Node::Style() const {
-  if (!m_isValid)
-    throw InvalidNode(m_invalidKey);
+  if (!m_isValid) {
+    detail::raise(InvalidNode(m_invalidKey));
+    return EmitterStyle::Default;
+  }
   return m_pNode ? m_pNode->style() : EmitterStyle::Default;
 }
 
 inline void Node::SetStyle(EmitterStyle style) {
-  EnsureNodeExists();
+  if (!EnsureNodeExists())
+    return;
   m_pNode->set_style(style);
 }
 
 // assignment
 inline bool Node::is(const Node& rhs) const {
-  if (!m_isValid || !rhs.m_isValid)
-    throw InvalidNode(m_invalidKey);
+  if (!m_isValid || !rhs.m_isValid) {
+    detail::raise(InvalidNode(m_invalidKey));
+    return false;
+  }
   if (!m_pNode || !rhs.m_pNode)
     return false;
   return m_pNode->is(*rhs.m_pNode);
@@ -214,102 +356,124 @@ inline Node& Node::operator=(const Node& rhs) {
 }
 
 inline void Node::reset(const YAML::Node& rhs) {
-  if (!m_isValid || !rhs.m_isValid)
-    throw InvalidNode(m_invalidKey);
+  if (!m_isValid || !rhs.m_isValid) {
+    detail::raise(InvalidNode(m_invalidKey));
+    return;
+  }
+  rhs.Pin();
+  Unpin();
   m_pMemory = rhs.m_pMemory;
   m_pNode = rhs.m_pNode;
 }
 
 template <typename T>
 inline void Node::Assign(const T& rhs) {
-  if (!m_isValid)
-    throw InvalidNode(m_invalidKey);
+  if (!m_isValid) {
+    detail::raise(InvalidNode(m_invalidKey));
+    return;
+  }
   AssignData(convert<T>::encode(rhs));
 }
 
 template <>
 inline void Node::Assign(const std::string& rhs) {
-  EnsureNodeExists();
+  if (!EnsureNodeExists())
+    return;
   m_pNode->set_scalar(rhs);
 }
 
 inline void Node::Assign(const char* rhs) {
-  EnsureNodeExists();
+  if (!EnsureNodeExists())
+    return;
   m_pNode->set_scalar(rhs);
 }
 
 inline void Node::Assign(char* rhs) {
-  EnsureNodeExists();
+  if (!EnsureNodeExists())
+    return;
   m_pNode->set_scalar(rhs);
 }
 
 inline void Node::AssignData(const Node& rhs) {
-  EnsureNodeExists();
-  rhs.EnsureNodeExists();
+  if (!EnsureNodeExists() || !rhs.EnsureNodeExists())
+    return;
 
   m_pNode->set_data(*rhs.m_pNode);
   m_pMemory->merge(*rhs.m_pMemory);
 }
 
 inline void Node::AssignNode(const Node& rhs) {
-  if (!m_isValid)
-    throw InvalidNode(m_invalidKey);
-  rhs.EnsureNodeExists();
+  if (!m_isValid) {
+    detail::raise(InvalidNode(m_invalidKey));
+    return;
+  }
+  if (!rhs.EnsureNodeExists())
+    return;
 
   if (!m_pNode) {
     m_pNode = rhs.m_pNode;
     m_pMemory = rhs.m_pMemory;
+    Pin();
     return;
   }
 
   m_pNode->set_ref(*rhs.m_pNode);
   m_pMemory->merge(*rhs.m_pMemory);
+  rhs.Pin();
+  Unpin();
   m_pNode = rhs.m_pNode;
 }
 
 // size/iterator
 inline std::size_t Node::size() const {
-  if (!m_isValid)
-    throw InvalidNode(m_invalidKey);
+  if (!m_isValid) {
+    detail::raise(InvalidNode(m_invalidKey));
+    return 0;
+  }
   return m_pNode ? m_pNode->size() : 0;
 }
 
 inline const_iterator Node::begin() const {
-  if (!m_isValid)
+  if (!m_isValid || !m_pNode)
     return const_iterator();
-  return m_pNode ? const_iterator(m_pNode->begin(), m_pMemory)
-                 : const_iterator();
+  m_pNode->thaw_elements(m_pMemory);
+  return const_iterator(m_pNode->begin(), m_pMemory);
 }
 
 inline iterator Node::begin() {
-  if (!m_isValid)
+  if (!m_isValid || !m_pNode)
     return iterator();
-  return m_pNode ? iterator(m_pNode->begin(), m_pMemory) : iterator();
+  m_pNode->thaw_elements(m_pMemory);
+  return iterator(m_pNode->begin(), m_pMemory);
 }
 
 inline const_iterator Node::end() const {
-  if (!m_isValid)
+  if (!m_isValid || !m_pNode)
     return const_iterator();
-  return m_pNode ? const_iterator(m_pNode->end(), m_pMemory) : const_iterator();
+  m_pNode->thaw_elements(m_pMemory);
+  return const_iterator(m_pNode->end(), m_pMemory);
 }
 
 inline iterator Node::end() {
-  if (!m_isValid)
+  if (!m_isValid || !m_pNode)
     return iterator();
-  return m_pNode ? iterator(m_pNode->end(), m_pMemory) : iterator();
+  m_pNode->thaw_elements(m_pMemory);
+  return iterator(m_pNode->end(), m_pMemory);
 }
 
 // sequence
 template <typename T>
 inline void Node::push_back(const T& rhs) {
-  if (!m_isValid)
-    throw InvalidNode(m_invalidKey);
+  if (!m_isValid) {
+    detail::raise(InvalidNode(m_invalidKey));
+    return;
+  }
   push_back(Node(rhs));
 }
 
 inline void Node::push_back(const Node& rhs) {
-  EnsureNodeExists();
-  rhs.EnsureNodeExists();
+  if (!EnsureNodeExists() || !rhs.EnsureNodeExists())
+    return;
 
   m_pNode->push_back(*rhs.m_pNode, m_pMemory);
   m_pMemory->merge(*rhs.m_pMemory);
@@ -323,7 +487,8 @@ std::string key_to_string(const Key& key) {
 // indexing
 template <typename Key>
 inline const Node Node::operator[](const Key& key) const {
-  EnsureNodeExists();
+  if (!EnsureNodeExists())
+    return Node(ZombieNode, m_invalidKey);
   detail::node* value =
       static_cast<const detail::node&>(*m_pNode).get(key, m_pMemory);
   if (!value) {
@@ -334,20 +499,22 @@ inline const Node Node::operator[](const Key& key) const {
 
 template <typename Key>
 inline Node Node::operator[](const Key& key) {
-  EnsureNodeExists();
+  if (!EnsureNodeExists())
+    return Node(ZombieNode, m_invalidKey);
   detail::node& value = m_pNode->get(key, m_pMemory);
   return Node(value, m_pMemory);
 }
 
 template <typename Key>
 inline bool Node::remove(const Key& key) {
-  EnsureNodeExists();
+  if (!EnsureNodeExists())
+    return false;
   return m_pNode->remove(key, m_pMemory);
 }
 
 inline const Node Node::operator[](const Node& key) const {
-  EnsureNodeExists();
-  key.EnsureNodeExists();
+  if (!EnsureNodeExists() || !key.EnsureNodeExists())
+    return Node(ZombieNode, m_invalidKey);
   m_pMemory->merge(*key.m_pMemory);
   detail::node* value =
       static_cast<const detail::node&>(*m_pNode).get(*key.m_pNode, m_pMemory);
@@ -358,23 +525,24 @@ inline const Node Node::operator[](const Node& key) const {
 }
 
 inline Node Node::operator[](const Node& key) {
-  EnsureNodeExists();
-  key.EnsureNodeExists();
+  if (!EnsureNodeExists() || !key.EnsureNodeExists())
+    return Node(ZombieNode, m_invalidKey);
   m_pMemory->merge(*key.m_pMemory);
   detail::node& value = m_pNode->get(*key.m_pNode, m_pMemory);
   return Node(value, m_pMemory);
 }
 
 inline bool Node::remove(const Node& key) {
-  EnsureNodeExists();
-  key.EnsureNodeExists();
+  if (!EnsureNodeExists() || !key.EnsureNodeExists())
+    return false;
   return m_pNode->remove(*key.m_pNode, m_pMemory);
 }
 
 // map
 template <typename Key, typename Value>
 inline void Node::force_insert(const Key& key, const Value& value) {
-  EnsureNodeExists();
+  if (!EnsureNodeExists())
+    return;
   m_pNode->force_insert(key, value, m_pMemory);
 }
 
@@ -0,0 +1,81 @@
+#ifndef NODE_MEMORY_USAGE_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+#define NODE_MEMORY_USAGE_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+
+#if defined(_MSC_VER) ||                                            \
+    (defined(__GNUC__) && (__GNUC__ == 3 && __GNUC_MINOR__ >= 4) || \
+     (__GNUC__ >= 4))  // GCC supports "pragma once" correctly since 3.4
+#pragma once
+#endif
+
+#include <cstddef>
+#include <vector>
+
+namespace YAML {
+class Node;
+
+// What a document takes up in memory. Nodes are counted by the type of their
+// current data, including nodes that are no longer reachable until the
+// document is compacted (see Compact()); the bytes are close estimates of the
+// heap memory behind them.
+struct YAML_CPP_API MemoryUsage {
+  MemoryUsage();
+
+  std::size_t undefinedNodes;
+  std::size_t nullNodes;
+  std::size_t scalarNodes;
+  std::size_t sequenceNodes;
+  std::size_t mapNodes;
+  // slots freed by compaction and waiting to be reused
+  std::size_t freeNodes;
+
+  // scalar strings
+  std::size_t scalarBytes;
+  // tag strings
+  std::size_t tagBytes;
+  // element arrays and key indexes of sequences and maps
+  std::size_t containerBytes;
+  // the node slots themselves and their bookkeeping
+  std::size_t nodeBytes;
+  // frozen documents the nodes still thaw elements from; these may be shared
+  // with other documents and with their FrozenDocument
+  std::size_t frozenBytes;
+
+  std::size_t nodes() const {
+    return undefinedNodes + nullNodes + scalarNodes + sequenceNodes + mapNodes;
+  }
+  std::size_t totalBytes() const {
+    return scalarBytes + tagBytes + containerBytes + nodeBytes + frozenBytes;
+  }
+
+  MemoryUsage& operator+=(const MemoryUsage& rhs);
+};
+
+// Counts the memory that owns the node: its whole document, together with
+// every document that was merged into it by assigning nodes between them.
+// Nothing is tracked in between queries, so this walks every node of the
+// memory. The document must not change while it runs.
+YAML_CPP_API MemoryUsage GetMemoryUsage(const Node& node);
+
+// The number of nodes in the memory that owns the node, the same as
+// GetMemoryUsage(node).nodes(): reachable or not, until Compact() frees them.
+// The memory keeps the count as it creates and merges nodes, so this takes
+// constant time and suits a growth threshold, checked at a point where no
+// iterator or NodeView is in use, for when to call Compact().
+YAML_CPP_API std::size_t GetNodeCount(const Node& node);
+
+// The memory usage of every live document that came out of the parser (or
+// FrozenNode::Thaw) while SetDocumentTracking() was on, one entry per memory.
+// This is only meant for quiescent states: no document may be loaded, changed
+// or merged by another thread while it runs.
+YAML_CPP_API std::vector<MemoryUsage> GetDocumentMemoryUsage();
+
+// Whether documents that are loaded or thawed from now on are tracked for
+// GetDocumentMemoryUsage(). Off by default: a tracked document locks one of a
+// few mutexes when it is loaded and again when it is destroyed, while an
+// untracked one locks nothing. Turning tracking off keeps the documents that
+// are already tracked until they are destroyed.
+YAML_CPP_API void SetDocumentTracking(bool enabled);
+YAML_CPP_API bool IsDocumentTracking();
+}  // namespace YAML
+
+#endif  // NODE_MEMORY_USAGE_H_62B23520_7C8E_11DE_8A39_0800200C9A66
@@ -7,6 +7,7 @@
 #pragma once
 #endif
 
+#include <cstddef>
 #include <stdexcept>
 #include <string>
 
@@ -18,18 +19,37 @@
 #include "node/type.h"
 
 namespace YAML {
+struct MemoryUsage;
+struct ResolvedScalar;
 namespace detail {
 class node;
 class node_data;
 struct iterator_value;
+template <typename T>
+struct reflected_convert;
 }  // namespace detail
 }  // namespace YAML
 
 namespace YAML {
+// Any number of threads may read one document through const Nodes at once,
+// as long as no thread changes it meanwhile: lookups only read, and the
+// sequence sizes and resolved scalars that const access caches are published
+// atomically. Sequences and maps thawed from a FrozenDocument (see
+// FrozenNode::Thaw) are the exception, as they fill in their elements on
+// first access; read them through a NodeView instead. Non-const access, even
+// operator[] with a missing key, changes the document.
 class YAML_CPP_API Node {
  public:
   friend class NodeBuilder;
   friend class NodeEvents;
+  friend class FrozenDocument;
+  friend class FrozenNode;
+  friend class NodeView;
+  friend YAML_CPP_API Node Clone(const Node& node);
+  friend YAML_CPP_API std::size_t Compact(const Node& node);
+  friend YAML_CPP_API MemoryUsage GetMemoryUsage(const Node& node);
+  friend YAML_CPP_API std::size_t GetNodeCount(const Node& node);
+  friend YAML_CPP_API ResolvedScalar ResolveScalar(const Node& node);
   friend struct detail::iterator_value;
   friend class detail::node;
   friend class detail::node_data;
@@ -37,6 +57,10 @@ class YAML_CPP_API Node {
   friend class detail::iterator_base;
   template <typename T, typename S>
   friend struct as_if;
+  template <typename T>
+  friend bool DecodeNumbers(const Node& node, T* values, std::size_t size);
+  template <typename T>
+  friend struct detail::reflected_convert;
 
   using iterator = YAML::iterator;
   using const_iterator = YAML::const_iterator;
@@ -66,6 +90,20 @@ class YAML_CPP_API Node {
   T as() const;
   template <typename T, typename S>
   T as(const S& fallback) const;
+  // Decodes like as<T>(), but into rhs: containers are refilled in place,
+  // keeping their capacity, and their elements are decoded into them instead
+  // of being built and copied in. When it fails, rhs may hold part of the
+  // value.
+  template <typename T>
+  void DecodeInto(T& rhs) const;
+  // Decodes like DecodeInto(), but only returns whether the node converts:
+  // nothing is raised and no exception or error is built when it does not,
+  // so probing for types is cheap. The second form decodes the value at the
+  // key, if there is one, like operator[] followed by TryDecode().
+  template <typename T>
+  bool TryDecode(T& rhs) const;
+  template <typename Key, typename T>
+  bool TryDecode(const Key& key, T& rhs) const;
   const std::string& Scalar() const;
 
   const std::string& Tag() const;
@@ -119,7 +157,13 @@ class YAML_CPP_API Node {
   explicit Node(Zombie, const std::string&);
   explicit Node(detail::node& node, detail::shared_memory_holder pMemory);
 
-  void EnsureNodeExists() const;
+  // false if the node is invalid, see exceptions.h
+  bool EnsureNodeExists() const;
+
+  // A handle that holds a memory pins its node, which keeps everything the
+  // node can reach alive when the document is compacted.
+  void Pin() const;
+  void Unpin() const;
 
   template <typename T>
   void Assign(const T& rhs);
@@ -139,8 +183,26 @@ class YAML_CPP_API Node {
 
 YAML_CPP_API bool operator==(const Node& lhs, const Node& rhs);
 
+// A deep copy of the node and everything below it. Every live node is
+// copied, so this takes time and memory in the size of the subtree; only
+// containers that are still frozen (see FrozenNode::Thaw) are shared. To
+// make many cheap copies of one document, freeze it once and thaw a copy for
+// each instead.
 YAML_CPP_API Node Clone(const Node& node);
 
+// Frees the nodes of the node's document that no Node can reach any more,
+// neither directly nor through the nodes it contains, and returns the number
+// of bytes reclaimed. Iterators and NodeViews into the freed nodes dangle,
+// which is why nothing else in yaml-cpp ever compacts; GetNodeCount() tells
+// callers cheaply when a document has grown enough to be worth it.
+YAML_CPP_API std::size_t Compact(const Node& node);
+
+// How the node's scalar resolves in the core schema (see numeric.h), computed
+// on first use and kept with the node until its scalar changes. as<T>() takes
+// its numbers and booleans from here. Null nodes resolve as Null, sequences
+// and maps as String.
+YAML_CPP_API ResolvedScalar ResolveScalar(const Node& node);
+
 template <typename T>
 struct convert;
 }
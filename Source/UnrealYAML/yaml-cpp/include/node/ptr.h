@@ -8,7 +8,15 @@
 #endif
 
 
-#include <memory>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+// Documents that are shared between threads need atomic reference counts.
+// Define this to 0 if Nodes never cross threads to make copying them cheaper.
+#ifndef YAML_CPP_THREADSAFE_REFCOUNT
+#define YAML_CPP_THREADSAFE_REFCOUNT 1
+#endif
 
 namespace YAML {
 namespace detail {
@@ -17,12 +25,104 @@ class node_ref;
 class node_data;
 class memory;
 class memory_holder;
+class memory_chunk;
+struct frozen_data;
+
+// reference count policies
+struct atomic_refcount {
+  atomic_refcount() : m_count(0) {}
+
+  void increment() { m_count.fetch_add(1, std::memory_order_relaxed); }
+  bool decrement() {
+    return m_count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+  }
+  std::size_t count() const { return m_count.load(std::memory_order_acquire); }
+
+  std::atomic<std::size_t> m_count;
+};
+
+struct plain_refcount {
+  plain_refcount() : m_count(0) {}
+
+  void increment() { ++m_count; }
+  bool decrement() { return --m_count == 0; }
+  std::size_t count() const { return m_count; }
+
+  std::size_t m_count;
+};
+
+#if YAML_CPP_THREADSAFE_REFCOUNT
+using refcount_policy = atomic_refcount;
+#else
+using refcount_policy = plain_refcount;
+#endif
+
+// Base for everything owned through a ref_ptr. The reference count lives in
+// the object itself, so there is no separately allocated control block.
+class YAML_CPP_API ref_counted {
+ public:
+  ref_counted() : m_refCount{} {}
+  ref_counted(const ref_counted&) = delete;
+  ref_counted& operator=(const ref_counted&) = delete;
+
+ protected:
+  ~ref_counted() = default;
+
+ private:
+  template <typename>
+  friend class ref_ptr;
+
+  // mutable, so that read-only objects can be shared as ref_ptr<const T>
+  mutable refcount_policy m_refCount;
+};
+
+template <typename T>
+class ref_ptr {
+ public:
+  ref_ptr() : m_ptr(nullptr) {}
+  ref_ptr(std::nullptr_t) : m_ptr(nullptr) {}
+  explicit ref_ptr(T* ptr) : m_ptr(ptr) { acquire(); }
+  ref_ptr(const ref_ptr& rhs) : m_ptr(rhs.m_ptr) { acquire(); }
+  ref_ptr(ref_ptr&& rhs) noexcept : m_ptr(rhs.m_ptr) { rhs.m_ptr = nullptr; }
+  ~ref_ptr() { release(); }
+
+  ref_ptr& operator=(const ref_ptr& rhs) {
+    ref_ptr(rhs).swap(*this);
+    return *this;
+  }
+  ref_ptr& operator=(ref_ptr&& rhs) noexcept {
+    ref_ptr(std::move(rhs)).swap(*this);
+    return *this;
+  }
+
+  void reset() { ref_ptr().swap(*this); }
+  void reset(T* ptr) { ref_ptr(ptr).swap(*this); }
+  void swap(ref_ptr& rhs) noexcept { std::swap(m_ptr, rhs.m_ptr); }
+
+  T* get() const { return m_ptr; }
+  T& operator*() const { return *m_ptr; }
+  T* operator->() const { return m_ptr; }
+  explicit operator bool() const { return m_ptr != nullptr; }
+
+  bool operator==(const ref_ptr& rhs) const { return m_ptr == rhs.m_ptr; }
+  bool operator!=(const ref_ptr& rhs) const { return m_ptr != rhs.m_ptr; }
+  bool operator<(const ref_ptr& rhs) const { return m_ptr < rhs.m_ptr; }
+
+ private:
+  void acquire() {
+    if (m_ptr)
+      m_ptr->m_refCount.increment();
+  }
+  void release() {
+    if (m_ptr && m_ptr->m_refCount.decrement())
+      delete m_ptr;
+  }
+
+  T* m_ptr;
+};
 
-using shared_node = std::shared_ptr<node>;
-using shared_node_ref = std::shared_ptr<node_ref>;
-using shared_node_data = std::shared_ptr<node_data>;
-using shared_memory_holder = std::shared_ptr<memory_holder>;
-using shared_memory = std::shared_ptr<memory>;
+using shared_memory_holder = ref_ptr<memory_holder>;
+using shared_memory = ref_ptr<memory>;
 }
 }
 
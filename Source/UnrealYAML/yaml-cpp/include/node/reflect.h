@@ -0,0 +1,539 @@
+#ifndef NODE_REFLECT_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+#define NODE_REFLECT_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+
+#if defined(_MSC_VER) ||                                            \
+    (defined(__GNUC__) && (__GNUC__ == 3 && __GNUC_MINOR__ >= 4) || \
+     (__GNUC__ >= 4))  // GCC supports "pragma once" correctly since 3.4
+#pragma once
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "emitter.h"
+#include "node/convert.h"
+#include "node/detail/node.h"
+#include "node/emit.h"
+#include "node/impl.h"
+#include "node/iterator.h"
+#include "node/node.h"
+
+/**
+ * Declares the fields of a plain struct or class once, and generates its
+ * convert<Type> and an operator<< that writes it to an Emitter, both as a map
+ * of the field names to their values:
+ *
+ *   namespace game {
+ *   struct Spawn {
+ *     std::string name;
+ *     int count = 1;
+ *     std::vector<float> at;
+ *   };
+ *   }
+ *   YAML_CPP_REFLECT(game::Spawn, name, count, at)
+ *
+ * It must be used at global scope, with the fully qualified name of the type,
+ * for up to 64 public data members. The fields are decoded with TryDecode()
+ * and written with their own operator<<, or through convert<T>::encode() if
+ * there is none, so they can be any type that converts, including other
+ * reflected types.
+ *
+ * Decoding walks the map once and finds the field of each key through a
+ * perfect hash of the field names that is built at compile time. Keys that
+ * are not fields are ignored and fields without a key keep their value, so
+ * as<Type>() leaves them default-constructed; the decode fails if the node
+ * is not a map or any field does not convert.
+ */
+#define YAML_CPP_REFLECT(Type, ...)                                           \
+  namespace YAML {                                                            \
+  template <>                                                                 \
+  struct reflect<Type> {                                                      \
+    static constexpr auto fields() {                                          \
+      return std::make_tuple(YAML_CPP_REFLECT_FIELDS(Type, __VA_ARGS__));     \
+    }                                                                         \
+  };                                                                          \
+  template <>                                                                 \
+  struct convert<Type> : detail::reflected_convert<Type> {};                  \
+  inline Emitter& operator<<(Emitter& emitter, const Type& value) {           \
+    return detail::emit_reflected(emitter, value);                            \
+  }                                                                           \
+  }
+
+// the field list, one reflected_field per name; EXPAND makes MSVC's
+// traditional preprocessor split __VA_ARGS__ into arguments
+#define YAML_CPP_REFLECT_EXPAND(x) x
+#define YAML_CPP_REFLECT_CAT(a, b) YAML_CPP_REFLECT_CAT_(a, b)
+#define YAML_CPP_REFLECT_CAT_(a, b) a##b
+#define YAML_CPP_REFLECT_FIELD(Type, field) \
+  ::YAML::detail::make_reflected_field(#field, &Type::field)
+#define YAML_CPP_REFLECT_FIELDS(Type, ...)                                    \
+  YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_CAT(                               \
+      YAML_CPP_REFLECT_FIELDS_, YAML_CPP_REFLECT_COUNT(__VA_ARGS__))(         \
+      Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_COUNT_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10,      \
+    _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24,     \
+    _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38,     \
+    _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52,     \
+    _53, _54, _55, _56, _57, _58, _59, _60, _61, _62, _63, _64, N, ...) N
+#define YAML_CPP_REFLECT_COUNT(...)                                           \
+  YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_COUNT_(__VA_ARGS__, 64, 63, 62,    \
+      61, 60, 59, 58, 57, 56, 55, 54, 53, 52, 51, 50, 49, 48, 47, 46, 45,     \
+      44, 43, 42, 41, 40, 39, 38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28,     \
+      27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11,     \
+      10, 9, 8, 7, 6, 5, 4, 3, 2, 1))
+#define YAML_CPP_REFLECT_FIELDS_1(Type, field)                                \
+  YAML_CPP_REFLECT_FIELD(Type, field)
+#define YAML_CPP_REFLECT_FIELDS_2(Type, field, ...)                           \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_1(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_3(Type, field, ...)                           \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_2(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_4(Type, field, ...)                           \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_3(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_5(Type, field, ...)                           \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_4(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_6(Type, field, ...)                           \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_5(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_7(Type, field, ...)                           \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_6(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_8(Type, field, ...)                           \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_7(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_9(Type, field, ...)                           \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_8(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_10(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_9(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_11(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_10(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_12(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_11(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_13(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_12(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_14(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_13(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_15(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_14(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_16(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_15(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_17(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_16(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_18(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_17(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_19(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_18(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_20(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_19(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_21(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_20(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_22(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_21(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_23(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_22(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_24(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_23(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_25(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_24(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_26(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_25(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_27(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_26(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_28(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_27(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_29(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_28(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_30(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_29(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_31(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_30(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_32(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_31(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_33(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_32(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_34(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_33(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_35(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_34(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_36(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_35(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_37(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_36(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_38(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_37(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_39(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_38(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_40(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_39(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_41(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_40(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_42(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_41(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_43(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_42(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_44(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_43(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_45(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_44(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_46(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_45(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_47(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_46(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_48(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_47(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_49(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_48(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_50(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_49(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_51(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_50(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_52(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_51(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_53(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_52(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_54(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_53(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_55(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_54(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_56(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_55(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_57(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_56(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_58(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_57(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_59(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_58(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_60(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_59(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_61(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_60(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_62(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_61(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_63(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_62(Type, __VA_ARGS__))
+#define YAML_CPP_REFLECT_FIELDS_64(Type, field, ...)                          \
+  YAML_CPP_REFLECT_FIELD(Type, field),                                        \
+      YAML_CPP_REFLECT_EXPAND(YAML_CPP_REFLECT_FIELDS_63(Type, __VA_ARGS__))
+
+namespace YAML {
+// The fields of a type declared by YAML_CPP_REFLECT: fields() returns a tuple
+// of detail::reflected_field.
+template <typename T>
+struct reflect;
+
+namespace detail {
+template <typename C, typename M>
+struct reflected_field {
+  const char* name;
+  std::size_t size;
+  M C::*member;
+};
+
+template <typename C, typename M, std::size_t N>
+constexpr reflected_field<C, M> make_reflected_field(const char (&name)[N],
+                                                     M C::*member) {
+  return {name, N - 1, member};
+}
+
+// FNV-1a, which also picks the bucket of a name in reflected_keys
+constexpr std::uint64_t reflected_hash(const char* name, std::size_t size) {
+  std::uint64_t hash = 0xcbf29ce484222325ull;
+  for (std::size_t i = 0; i < size; i++)
+    hash = (hash ^ static_cast<unsigned char>(name[i])) * 0x100000001b3ull;
+  return hash;
+}
+
+// the slot of a hash for a displacement, mixed so that it depends on all bits
+constexpr std::uint64_t reflected_slot(std::uint64_t hash,
+                                       std::uint32_t displacement) {
+  hash += displacement * 0x9e3779b97f4a7c15ull;
+  hash = (hash ^ (hash >> 33)) * 0xff51afd7ed558ccdull;
+  hash = (hash ^ (hash >> 33)) * 0xc4ceb9fe1a85ec53ull;
+  return hash ^ (hash >> 33);
+}
+
+constexpr std::size_t reflected_buckets(std::size_t count) {
+  std::size_t buckets = 1;
+  while (buckets < count)
+    buckets *= 2;
+  return buckets;
+}
+
+// Only called, and so only compiled, if two fields have the same name (or
+// hash), which makes building the keys fail to be a constant expression.
+inline void reflected_fields_collide() {}
+
+/**
+ * A perfect hash of the N field names, by hash and displace: the names are
+ * spread over buckets by their hash, and the names of each bucket are placed
+ * into free slots with the first displacement that fits them all, filling
+ * the largest buckets first. It is not minimal: there are twice as many
+ * slots as buckets, at least 2N, so that displacements are found in few
+ * tries. A lookup is one hash of the key, one probe and one comparison with
+ * the name found.
+ */
+template <std::size_t N>
+struct reflected_keys {
+  static constexpr std::size_t kBuckets = reflected_buckets(N);
+  static constexpr std::size_t kSlots = 2 * kBuckets;
+
+  const char* names[N] = {};
+  std::size_t sizes[N] = {};
+  std::uint32_t displacements[kBuckets] = {};
+  // the field index + 1 of each slot, 0 if it is free
+  unsigned char slots[kSlots] = {};
+
+  constexpr reflected_keys(const char* const (&fieldNames)[N],
+                           const std::size_t (&fieldSizes)[N]) {
+    std::uint64_t hashes[N] = {};
+    std::size_t bucketSizes[kBuckets] = {};
+    for (std::size_t i = 0; i < N; i++) {
+      names[i] = fieldNames[i];
+      sizes[i] = fieldSizes[i];
+      hashes[i] = reflected_hash(names[i], sizes[i]);
+      bucketSizes[hashes[i] % kBuckets]++;
+    }
+
+    for (std::size_t size = N; size > 0; size--) {
+      for (std::size_t bucket = 0; bucket < kBuckets; bucket++) {
+        if (bucketSizes[bucket] != size)
+          continue;
+        for (std::uint32_t displacement = 1;; displacement++) {
+          if (displacement > 1000000)
+            reflected_fields_collide();
+          if (place(hashes, bucket, displacement)) {
+            displacements[bucket] = displacement;
+            break;
+          }
+        }
+      }
+    }
+  }
+
+  // the index of the field with the given name, or N if there is none
+  std::size_t find(const char* name, std::size_t size) const {
+    const std::uint64_t hash = reflected_hash(name, size);
+    const std::size_t slot =
+        reflected_slot(hash, displacements[hash % kBuckets]) % kSlots;
+    const std::size_t index = slots[slot] ? slots[slot] - 1 : N;
+    if (index == N || sizes[index] != size ||
+        std::memcmp(names[index], name, size) != 0)
+      return N;
+    return index;
+  }
+
+ private:
+  // fills the slots of the bucket's names, or leaves them all free
+  constexpr bool place(const std::uint64_t (&hashes)[N], std::size_t bucket,
+                       std::uint32_t displacement) {
+    for (std::size_t i = 0; i < N; i++) {
+      if (hashes[i] % kBuckets != bucket)
+        continue;
+      const std::size_t slot = reflected_slot(hashes[i], displacement) % kSlots;
+      if (slots[slot]) {
+        for (std::size_t j = 0; j < i; j++) {
+          if (hashes[j] % kBuckets == bucket &&
+              slots[reflected_slot(hashes[j], displacement) % kSlots] == j + 1)
+            slots[reflected_slot(hashes[j], displacement) % kSlots] = 0;
+        }
+        return false;
+      }
+      slots[slot] = static_cast<unsigned char>(i + 1);
+    }
+    return true;
+  }
+};
+
+template <typename T>
+using reflected_fields = decltype(reflect<T>::fields());
+
+template <typename T>
+using reflected_indices =
+    std::make_index_sequence<std::tuple_size<reflected_fields<T>>::value>;
+
+template <typename T, std::size_t... I>
+constexpr reflected_keys<sizeof...(I)> make_reflected_keys(
+    std::index_sequence<I...>) {
+  return reflected_keys<sizeof...(I)>(
+      {std::get<I>(reflect<T>::fields()).name...},
+      {std::get<I>(reflect<T>::fields()).size...});
+}
+
+template <typename T>
+struct reflected_lookup {
+  static constexpr std::size_t kCount =
+      std::tuple_size<reflected_fields<T>>::value;
+  static constexpr reflected_keys<kCount> keys =
+      make_reflected_keys<T>(reflected_indices<T>());
+};
+
+template <typename T>
+constexpr reflected_keys<reflected_lookup<T>::kCount> reflected_lookup<T>::keys;
+
+template <typename T, std::size_t I>
+bool decode_reflected_field(const Node& value, T& rhs) {
+  return value.TryDecode(rhs.*(std::get<I>(reflect<T>::fields()).member));
+}
+
+template <typename T, std::size_t... I>
+bool decode_reflected_field(std::size_t index, const Node& value, T& rhs,
+                            std::index_sequence<I...>) {
+  using decoder = bool (*)(const Node&, T&);
+  static const decoder decoders[] = {&decode_reflected_field<T, I>...};
+  return decoders[index](value, rhs);
+}
+
+// whether the value can be written with operator<<, or must be encoded into
+// a Node first
+template <typename T, typename = void>
+struct is_emittable : std::false_type {};
+template <typename T>
+struct is_emittable<T, decltype(void(std::declval<Emitter&>()
+                                     << std::declval<const T&>()))>
+    : std::true_type {};
+
+template <typename T>
+void emit_reflected_value(Emitter& emitter, const T& value, std::true_type) {
+  emitter << value;
+}
+template <typename T>
+void emit_reflected_value(Emitter& emitter, const T& value, std::false_type) {
+  emitter << Node(value);
+}
+
+template <typename T, std::size_t... I>
+void emit_reflected_fields(Emitter& emitter, const T& value,
+                           std::index_sequence<I...>) {
+  const auto fields = reflect<T>::fields();
+  const int expand[] = {
+      0, (emitter << EmitterManip::Key
+                  << std::string(std::get<I>(fields).name,
+                                 std::get<I>(fields).size)
+                  << EmitterManip::Value,
+          emit_reflected_value(
+              emitter, value.*(std::get<I>(fields).member),
+              is_emittable<typename std::decay<decltype(
+                  value.*(std::get<I>(fields).member))>::type>()),
+          0)...};
+  (void)expand;
+}
+
+template <typename T>
+Emitter& emit_reflected(Emitter& emitter, const T& value) {
+  emitter << EmitterManip::BeginMap;
+  emit_reflected_fields(emitter, value, reflected_indices<T>());
+  return emitter << EmitterManip::EndMap;
+}
+
+template <typename T, std::size_t... I>
+void encode_reflected_fields(Node& node, const T& value,
+                             std::index_sequence<I...>) {
+  const auto fields = reflect<T>::fields();
+  const int expand[] = {
+      0, (node.force_insert(std::string(std::get<I>(fields).name,
+                                        std::get<I>(fields).size),
+                            value.*(std::get<I>(fields).member)),
+          0)...};
+  (void)expand;
+}
+
+template <typename T>
+struct reflected_convert {
+  static Node encode(const T& rhs) {
+    Node node(NodeType::Map);
+    encode_reflected_fields(node, rhs, reflected_indices<T>());
+    return node;
+  }
+
+  // The entries are read in place, like DecodeNumbers() does, with a Node
+  // only for the values of fields.
+  static bool decode(const Node& node, T& rhs) {
+    if (!node.IsMap())
+      return false;
+
+    const auto& keys = reflected_lookup<T>::keys;
+    node.m_pNode->thaw_elements(node.m_pMemory);
+    const detail::node& map = *node.m_pNode;
+    for (auto it = map.begin(); it != map.end(); ++it) {
+      const detail::node& key = *(*it).first;
+      if (key.type() != NodeType::Scalar)
+        continue;
+      const std::string& name = key.scalar();
+      const std::size_t index = keys.find(name.data(), name.size());
+      if (index == reflected_lookup<T>::kCount)
+        continue;
+      const Node value(const_cast<detail::node&>(*(*it).second),
+                       node.m_pMemory);
+      if (!decode_reflected_field(index, value, rhs, reflected_indices<T>()))
+        return false;
+    }
+    return true;
+  }
+};
+}  // namespace detail
+}  // namespace YAML
+
+#endif  // NODE_REFLECT_H_62B23520_7C8E_11DE_8A39_0800200C9A66
@@ -8,7 +8,7 @@
 #endif
 
 namespace YAML {
-	enum class NodeType {Undefined, Null, Scalar, Sequence, Map};
+	enum class NodeType : unsigned char {Undefined, Null, Scalar, Sequence, Map};
 }
 
 #endif  // VALUE_TYPE_H_62B23520_7C8E_11DE_8A39_0800200C9A66
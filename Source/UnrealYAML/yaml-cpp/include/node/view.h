@@ -0,0 +1,359 @@
+#ifndef NODE_VIEW_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+#define NODE_VIEW_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+
+#if defined(_MSC_VER) ||                                            \
+    (defined(__GNUC__) && (__GNUC__ == 3 && __GNUC_MINOR__ >= 4) || \
+     (__GNUC__ >= 4))  // GCC supports "pragma once" correctly since 3.4
+#pragma once
+#endif
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <list>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "emitterstyle.h"
+#include "exceptions.h"
+#include "mark.h"
+#include "node/convert.h"
+#include "node/detail/node.h"
+#include "node/frozen.h"
+#include "node/impl.h"
+#include "node/node.h"
+#include "node/type.h"
+
+namespace YAML {
+/**
+ * A read-only view of a node of a live document.
+ *
+ * Reading through const Nodes is thread-safe except where it thaws frozen
+ * elements (see Node), and copying a Node touches a shared reference count.
+ * A NodeView is a plain pointer into the document whose queries never write
+ * to it, so any number of threads may read the same document through views
+ * at once, as long as no thread changes it or thaws it through a Node in the
+ * meantime. A lookup that finds nothing returns an
+ * undefined view instead of a node that remembers the key.
+ *
+ * Sequences and maps thawed from a FrozenDocument (see FrozenNode::Thaw) are
+ * read straight from the document.
+ *
+ * The document must outlive all views into it.
+ */
+class YAML_CPP_API NodeView {
+ public:
+  class const_iterator;
+
+  NodeView() : m_pNode(nullptr), m_frozen{}, m_isEmpty(false) {}
+  explicit NodeView(const Node& node);
+
+  bool IsDefined() const;
+  explicit operator bool() const { return IsDefined(); }
+  bool operator!() const { return !IsDefined(); }
+
+  NodeType Type() const;
+  bool IsNull() const { return Type() == NodeType::Null; }
+  bool IsScalar() const { return Type() == NodeType::Scalar; }
+  bool IsSequence() const { return Type() == NodeType::Sequence; }
+  bool IsMap() const { return Type() == NodeType::Map; }
+
+  YAML::Mark Mark() const;
+  EmitterStyle Style() const;
+  const std::string& Tag() const;
+
+  // ScalarData() is not null-terminated for scalars of frozen elements
+  const char* ScalarData() const;
+  std::size_t ScalarSize() const;
+  std::string Scalar() const { return std::string(ScalarData(), ScalarSize()); }
+
+  // number of elements of a sequence or entries of a map, 0 otherwise
+  std::size_t size() const;
+
+  // the i-th element of a sequence, or the key / value of the i-th map entry
+  NodeView at(std::size_t index) const;
+  NodeView key_at(std::size_t index) const;
+  NodeView value_at(std::size_t index) const;
+  // The key and value of the i-th map entry, or an undefined key and the
+  // i-th element of a sequence. Takes constant time, unless some entries of
+  // the map are not defined yet; walking all entries is linear either way
+  // through begin() and end().
+  std::pair<NodeView, NodeView> entry_at(std::size_t index) const;
+
+  // the entries, as returned by entry_at(), in order
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  // Sequences are indexed by integers. Maps are searched for a scalar key
+  // equal to the given key; integers and other types are looked up by their
+  // encoded scalar.
+  template <typename Key>
+  NodeView operator[](const Key& key) const;
+  NodeView operator[](const std::string& key) const {
+    return find(key.data(), key.size());
+  }
+  NodeView operator[](const char* key) const {
+    return find(key, std::strlen(key));
+  }
+
+  // Scalars are decoded in place. std::vector, std::list, std::array,
+  // std::pair and std::map are filled by walking the view, element by
+  // element, so decoding them writes nothing to the document either. Other
+  // types are converted from a private copy of the subtree, see Clone(),
+  // which takes time in the size of the subtree.
+  template <typename T>
+  T as() const {
+    T value;
+    if (decode(value))
+      return value;
+    detail::raise(TypedBadConversion<T>(Mark()));
+    return T();
+  }
+  template <typename T, typename S>
+  T as(const S& fallback) const {
+    T value;
+    return decode(value) ? value : fallback;
+  }
+
+  // a mutable copy of this subtree that is private to the calling thread
+  Node Clone() const;
+
+  bool is(const NodeView& rhs) const;
+
+ private:
+  explicit NodeView(const detail::node& node);
+  explicit NodeView(const FrozenNode& frozen)
+      : m_pNode(nullptr), m_frozen(frozen), m_isEmpty(false) {}
+
+  // a live node whose elements are still frozen is read through m_frozen
+  bool is_live() const { return m_pNode && !m_frozen.IsDefined(); }
+  const detail::node_data& data() const { return m_pNode->data(); }
+
+  NodeView find(const char* key, std::size_t size) const;
+
+  // Positions count all elements of a sequence or entries of a map, also the
+  // entries of a live map that are not defined yet, which next_position()
+  // skips.
+  std::size_t next_position(std::size_t position) const;
+  std::size_t end_position() const;
+  std::pair<NodeView, NodeView> entry(std::size_t position) const;
+
+  template <typename Key>
+  NodeView get(const Key& key, std::true_type /* integral */) const;
+  template <typename Key>
+  NodeView get(const Key& key, std::false_type /* integral */) const;
+
+  template <typename T>
+  bool decode(T& value) const;
+  bool decode(std::string& value) const;
+  template <typename T, typename A>
+  bool decode(std::vector<T, A>& value) const;
+  template <typename T, typename A>
+  bool decode(std::list<T, A>& value) const;
+  template <typename T, std::size_t N>
+  bool decode(std::array<T, N>& value) const;
+  template <typename T, typename U>
+  bool decode(std::pair<T, U>& value) const;
+  template <typename K, typename V, typename C, typename A>
+  bool decode(std::map<K, V, C, A>& value) const;
+
+  // decodes the elements of a sequence into a new last element each
+  template <typename S>
+  bool decode_elements(S& value) const;
+  template <typename S>
+  static bool decode_back(const NodeView& element, S& value);
+  template <typename A>
+  static bool decode_back(const NodeView& element, std::vector<bool, A>& value);
+
+  const detail::node* m_pNode;
+  FrozenNode m_frozen;
+  // a view of an empty Node, which reads as null
+  bool m_isEmpty;
+};
+
+class NodeView::const_iterator {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = std::pair<NodeView, NodeView>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const value_type*;
+  using reference = value_type;
+
+  const_iterator() : m_parent{}, m_position(0) {}
+
+  value_type operator*() const { return m_parent.entry(m_position); }
+
+  const_iterator& operator++() {
+    m_position = m_parent.next_position(m_position + 1);
+    return *this;
+  }
+  const_iterator operator++(int) {
+    const_iterator it(*this);
+    ++*this;
+    return it;
+  }
+
+  // only iterators of the same view compare
+  bool operator==(const const_iterator& rhs) const {
+    return m_position == rhs.m_position;
+  }
+  bool operator!=(const const_iterator& rhs) const { return !(*this == rhs); }
+
+ private:
+  friend class NodeView;
+  const_iterator(const NodeView& parent, std::size_t position)
+      : m_parent(parent), m_position(position) {}
+
+  NodeView m_parent;
+  std::size_t m_position;
+};
+
+inline NodeView::const_iterator NodeView::begin() const {
+  return const_iterator(*this, next_position(0));
+}
+
+inline NodeView::const_iterator NodeView::end() const {
+  return const_iterator(*this, end_position());
+}
+
+template <typename Key>
+inline NodeView NodeView::operator[](const Key& key) const {
+  return get(key, std::integral_constant<bool, std::is_integral<Key>::value &&
+                                                   !std::is_same<Key, bool>::value>());
+}
+
+template <typename Key>
+inline NodeView NodeView::get(const Key& key, std::true_type) const {
+  if (Type() == NodeType::Sequence) {
+    std::size_t index;
+    if (!detail::frozen_index(key, index, std::is_signed<Key>()))
+      return NodeView();
+    return at(index);
+  }
+  return (*this)[std::to_string(key)];
+}
+
+template <typename Key>
+inline NodeView NodeView::get(const Key& key, std::false_type) const {
+  if (Type() != NodeType::Map)
+    return NodeView();
+  const Node encoded = convert<Key>::encode(key);
+  return encoded.IsScalar() ? (*this)[encoded.Scalar()] : NodeView();
+}
+
+template <typename T>
+inline bool NodeView::decode(T& value) const {
+  if (!IsDefined())
+    return false;
+
+  if (is_live() && !std::is_same<T, Node>::value &&
+      (IsScalar() || IsNull())) {
+    const Node node(const_cast<detail::node&>(*m_pNode),
+                    detail::shared_memory_holder());
+    // the cached resolution is only read, never stored
+    ResolvedScalar scalar;
+    if (detail::decodes_resolved_scalar<T>::value &&
+        m_pNode->get_resolved_scalar(scalar))
+      return detail::decode_resolved(scalar, node, value,
+                                     detail::decodes_resolved_scalar<T>());
+    return convert<T>::decode(node, value);
+  }
+  if (!is_live() && m_frozen.IsDefined())
+    return m_frozen.TryDecode(value);
+  return convert<T>::decode(Clone(), value);
+}
+
+template <typename T, typename A>
+inline bool NodeView::decode(std::vector<T, A>& value) const {
+  value.clear();
+  value.reserve(size());
+  return decode_elements(value);
+}
+
+template <typename T, typename A>
+inline bool NodeView::decode(std::list<T, A>& value) const {
+  value.clear();
+  return decode_elements(value);
+}
+
+template <typename T, std::size_t N>
+inline bool NodeView::decode(std::array<T, N>& value) const {
+  if (!IsSequence() || size() != N)
+    return false;
+
+  std::size_t i = 0;
+  for (const auto entry : *this) {
+    if (!entry.second.decode(value[i++]))
+      return false;
+  }
+  return true;
+}
+
+template <typename T, typename U>
+inline bool NodeView::decode(std::pair<T, U>& value) const {
+  if (!IsSequence() || size() != 2)
+    return false;
+  return at(0).decode(value.first) && at(1).decode(value.second);
+}
+
+template <typename K, typename V, typename C, typename A>
+inline bool NodeView::decode(std::map<K, V, C, A>& value) const {
+  if (!IsMap())
+    return false;
+
+  value.clear();
+  for (const auto entry : *this) {
+    K key;
+    if (!entry.first.decode(key) || !entry.second.decode(value[key]))
+      return false;
+  }
+  return true;
+}
+
+template <typename S>
+inline bool NodeView::decode_elements(S& value) const {
+  if (!IsSequence())
+    return false;
+
+  for (const auto entry : *this) {
+    if (!decode_back(entry.second, value))
+      return false;
+  }
+  return true;
+}
+
+template <typename S>
+inline bool NodeView::decode_back(const NodeView& element, S& value) {
+  value.emplace_back();
+  return element.decode(value.back());
+}
+
+template <typename A>
+inline bool NodeView::decode_back(const NodeView& element,
+                                  std::vector<bool, A>& value) {
+  bool flag;
+  if (!element.decode(flag))
+    return false;
+  value.push_back(flag);
+  return true;
+}
+
+inline bool NodeView::decode(std::string& value) const {
+  switch (Type()) {
+    case NodeType::Null:
+      value = "null";
+      return true;
+    case NodeType::Scalar:
+      value.assign(ScalarData(), ScalarSize());
+      return true;
+    default:
+      return false;
+  }
+}
+}  // namespace YAML
+
+#endif  // NODE_VIEW_H_62B23520_7C8E_11DE_8A39_0800200C9A66
@@ -15,4 +15,13 @@
     #define YAML_CPP_NOEXCEPT noexcept
 #endif
 
+// Without exceptions, errors are reported through an error state instead of
+// being thrown, see exceptions.h. This is the case when the compiler has
+// exceptions turned off, or when YAML_CPP_NO_EXCEPTIONS is defined; it must be
+// the same wherever yaml-cpp's headers are included.
+#if !defined(YAML_CPP_NO_EXCEPTIONS) && !defined(__cpp_exceptions) && \
+    !defined(__EXCEPTIONS) && !defined(_CPPUNWIND)
+    #define YAML_CPP_NO_EXCEPTIONS
+#endif
+
 #endif
@@ -0,0 +1,82 @@
+#ifndef NUMERIC_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+#define NUMERIC_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+
+#if defined(_MSC_VER) ||                                            \
+    (defined(__GNUC__) && (__GNUC__ == 3 && __GNUC_MINOR__ >= 4) || \
+     (__GNUC__ >= 4))  // GCC supports "pragma once" correctly since 3.4
+#pragma once
+#endif
+
+#include <cstddef>
+
+namespace YAML {
+// Scalars of the YAML 1.2 core schema: what their text resolves to, and
+// conversions between numbers and their text, without streams and independent
+// of the locale.
+
+// What a plain scalar is in the core schema.
+enum class ScalarType { Null, Bool, Int, Float, String };
+
+struct ResolvedScalar {
+  ScalarType type;
+  // the sign of an Int, whose absolute value is in magnitude
+  bool negative;
+  union {
+    bool boolValue;
+    unsigned long long magnitude;
+    double floatValue;
+  };
+};
+
+// Resolves the text in a single pass, without allocating: null, Null, NULL, ~
+// and the empty string are Null; true and false (also Capitalized and
+// UPPERCASE) are Bool; the integers of ParseNumber() below are Int as long as
+// they fit into a long long or unsigned long long, and any other number it
+// accepts is Float. Everything else is a String, including numbers out of the
+// range of a double.
+YAML_CPP_API ResolvedScalar ResolveScalar(const char* data, std::size_t size);
+
+// the most characters FormatNumber() writes
+const std::size_t kMaxNumberSize = 32;
+
+// Parses all of [begin, end) as an integer: decimal with an optional sign,
+// 0x followed by hex digits, or 0o followed by octal digits. Returns false if
+// the text is anything else or the value is out of range.
+YAML_CPP_API bool ParseNumber(const char* begin, const char* end,
+                              long long& value);
+YAML_CPP_API bool ParseNumber(const char* begin, const char* end,
+                              unsigned long long& value);
+
+// Parses all of [begin, end) as a floating point number: a decimal with an
+// optional sign, fraction and exponent, [-+].inf, .nan in any of their
+// spellings (.inf, .Inf, .INF), or any of the integers above. The result is
+// correctly rounded; returns false if the text is anything else or out of
+// range.
+YAML_CPP_API bool ParseNumber(const char* begin, const char* end,
+                              double& value);
+YAML_CPP_API bool ParseNumber(const char* begin, const char* end,
+                              float& value);
+
+// Rounds a double that was parsed from [begin, end) to a float, with the
+// result of parsing the text as a float. The text is only read again in the
+// rare cases where rounding twice could differ.
+YAML_CPP_API bool NarrowNumber(double value, const char* begin,
+                               const char* end, float& result);
+
+// Writes the value to buffer, which must hold kMaxNumberSize characters, and
+// returns the end of what was written. Floating point numbers are written
+// with the fewest digits that parse back to the same value, in scientific
+// notation if they are very large or small.
+YAML_CPP_API char* FormatNumber(char* buffer, long long value);
+YAML_CPP_API char* FormatNumber(char* buffer, unsigned long long value);
+YAML_CPP_API char* FormatNumber(char* buffer, double value);
+YAML_CPP_API char* FormatNumber(char* buffer, float value);
+
+// Writes the value like printf's %.*g with the given number of significant
+// digits, from 1 to 17, and with .nan and .inf as above. This is how the
+// Emitter writes floats and doubles at its precision settings.
+YAML_CPP_API char* FormatNumber(char* buffer, double value,
+                                std::size_t precision);
+}  // namespace YAML
+
+#endif  // NUMERIC_H_62B23520_7C8E_11DE_8A39_0800200C9A66
@@ -7,16 +7,34 @@
 #pragma once
 #endif
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
 
 
 namespace YAML {
+/**
+ * Where an {@link Emitter} writes to in bounded chunks, like a file or a
+ * socket. The output is collected in a buffer of fixed size that is handed to
+ * the sink whenever it is full, and when the emitter flushes or is destroyed,
+ * so the whole output never has to be in memory at once.
+ */
+class YAML_CPP_API OutputSink {
+ public:
+  virtual ~OutputSink() = default;
+  virtual void Write(const char* data, std::size_t size) = 0;
+};
+
 class YAML_CPP_API ostream_wrapper {
  public:
+  // the size of the buffer in front of a sink, by default
+  static const std::size_t kSinkBufferSize = 64 * 1024;
+
   ostream_wrapper();
   explicit ostream_wrapper(std::ostream& stream);
+  explicit ostream_wrapper(OutputSink& sink,
+                           std::size_t bufferSize = kSinkBufferSize);
   ostream_wrapper(const ostream_wrapper&) = delete;
   ostream_wrapper(ostream_wrapper&&) = delete;
   ostream_wrapper& operator=(const ostream_wrapper&) = delete;
@@ -28,8 +46,11 @@ class YAML_CPP_API ostream_wrapper {
 
   void set_comment() { m_comment = true; }
 
+  // hands what is buffered for a sink over to it
+  void flush();
+
   const char* str() const {
-    if (m_pStream) {
+    if (m_pStream || m_pSink) {
       return nullptr;
     } else {
       m_buffer[m_pos] = '\0';
@@ -43,11 +64,16 @@ class YAML_CPP_API ostream_wrapper {
   bool comment() const { return m_comment; }
 
  private:
-  void update_pos(char ch);
+  void update_pos(const char* str, std::size_t size);
 
  private:
   mutable std::vector<char> m_buffer;
   std::ostream* const m_pStream;
+  OutputSink* const m_pSink;
+  // the most m_buffer holds for m_pSink, and how much of it is not flushed
+  // to it yet
+  const std::size_t m_sinkBufferSize;
+  std::size_t m_buffered;
 
   std::size_t m_pos;
   std::size_t m_row, m_col;
@@ -52,7 +52,8 @@ class YAML_CPP_API Parser {
    * Handles the next document by calling events on the {@code eventHandler}.
    *
    * @throw a ParserException on error.
-   * @return false if there are no more documents
+   * @return false if there are no more documents, or without exceptions, if
+   *         the document has an error (see exceptions.h)
    */
   bool HandleNextDocument(EventHandler& eventHandler);
 
@@ -9,6 +9,7 @@
 
 #include "parser.h"
 #include "emitter.h"
+#include "jsonemitter.h"
 #include "emitterstyle.h"
 #include "stlemitter.h"
 #include "exceptions.h"
@@ -20,5 +21,9 @@
 #include "node/detail/impl.h"
 #include "node/parse.h"
 #include "node/emit.h"
+#include "node/frozen.h"
+#include "node/view.h"
+#include "node/reflect.h"
+#include "node/memory_usage.h"
 
 #endif  // YAML_H_62B23520_7C8E_11DE_8A39_0800200C9A66
@@ -1,17 +1,155 @@
 #include "binary.h"
 
-#include <cctype>
+#include <cstring>
+
+// The codec below handles 12 bytes / 16 characters at a time with SSSE3 on
+// x86 processors that have it, checked once at run time, and falls back to
+// the scalar loops everywhere else and for the tails.
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || \
+    defined(_M_IX86)
+#define YAML_CPP_BASE64_SSSE3
+#include <tmmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#if defined(__GNUC__) || defined(__clang__)
+#define YAML_CPP_TARGET_SSSE3 __attribute__((target("ssse3")))
+#else
+#define YAML_CPP_TARGET_SSSE3
+#endif
+#endif
 
 namespace YAML {
 static const char encoding[] =
     "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
-std::string EncodeBase64(const unsigned char *data, std::size_t size) {
+// the value of each base64 character; kSpace for the whitespace that is
+// skipped (as by std::isspace() in the C locale), 255 for anything else
+static const unsigned char kSpace = 254;
+static const unsigned char decoding[] = {
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 254, 254, 254, 254, 254, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 254, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 62,  255,
+    255, 255, 63,  52,  53,  54,  55,  56,  57,  58,  59,  60,  61,  255, 255,
+    255, 0,   255, 255, 255, 0,   1,   2,   3,   4,   5,   6,   7,   8,   9,
+    10,  11,  12,  13,  14,  15,  16,  17,  18,  19,  20,  21,  22,  23,  24,
+    25,  255, 255, 255, 255, 255, 255, 26,  27,  28,  29,  30,  31,  32,  33,
+    34,  35,  36,  37,  38,  39,  40,  41,  42,  43,  44,  45,  46,  47,  48,
+    49,  50,  51,  255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255,
+};
+
+#ifdef YAML_CPP_BASE64_SSSE3
+static bool HasSSSE3() {
+#if defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 1);
+  return (info[2] & (1 << 9)) != 0;
+#else
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("ssse3");
+#endif
+}
+
+static bool UseSSSE3() {
+  static const bool use = HasSSSE3();
+  return use;
+}
+
+// Encodes the first 12 of the 16 bytes at data into 16 characters.
+YAML_CPP_TARGET_SSSE3 static void EncodeBlock(const unsigned char *data,
+                                              char *out) {
+  __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+  // each 32-bit lane gets the three bytes of one group, then their four
+  // 6-bit values are moved into a byte each
+  in = _mm_shuffle_epi8(
+      in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+  const __m128i hi =
+      _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)),
+                      _mm_set1_epi32(0x04000040));
+  const __m128i lo =
+      _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003f03f0)),
+                      _mm_set1_epi32(0x01000010));
+  const __m128i values = _mm_or_si128(hi, lo);
+
+  // values 0..25 map to 13, 26..51 to 0 and 52..63 to 1..12, which selects
+  // the offset to add to get their character
+  __m128i range = _mm_subs_epu8(values, _mm_set1_epi8(51));
+  const __m128i upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), values);
+  range = _mm_or_si128(range, _mm_and_si128(upper, _mm_set1_epi8(13)));
+  const __m128i offsets = _mm_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+  const __m128i chars =
+      _mm_add_epi8(values, _mm_shuffle_epi8(offsets, range));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out), chars);
+}
+
+YAML_CPP_TARGET_SSSE3 static __m128i InRange(__m128i in, char first,
+                                             char last) {
+  return _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8(first - 1)),
+                       _mm_cmplt_epi8(in, _mm_set1_epi8(last + 1)));
+}
+
+// Decodes 16 characters into 12 bytes; returns false, without writing
+// anything, if any of them is not a base64 digit.
+YAML_CPP_TARGET_SSSE3 static bool DecodeBlock(const char *input,
+                                              unsigned char *out) {
+  const __m128i in =
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(input));
+  const __m128i upper = InRange(in, 'A', 'Z');
+  const __m128i lower = InRange(in, 'a', 'z');
+  const __m128i digit = InRange(in, '0', '9');
+  const __m128i plus = _mm_cmpeq_epi8(in, _mm_set1_epi8('+'));
+  const __m128i slash = _mm_cmpeq_epi8(in, _mm_set1_epi8('/'));
+  const __m128i valid =
+      _mm_or_si128(_mm_or_si128(upper, lower),
+                   _mm_or_si128(_mm_or_si128(digit, plus), slash));
+  if (_mm_movemask_epi8(valid) != 0xffff)
+    return false;
+
+  const __m128i offsets = _mm_or_si128(
+      _mm_or_si128(_mm_and_si128(upper, _mm_set1_epi8(-'A')),
+                   _mm_and_si128(lower, _mm_set1_epi8(26 - 'a'))),
+      _mm_or_si128(
+          _mm_and_si128(digit, _mm_set1_epi8(52 - '0')),
+          _mm_or_si128(_mm_and_si128(plus, _mm_set1_epi8(62 - '+')),
+                       _mm_and_si128(slash, _mm_set1_epi8(63 - '/')))));
+  const __m128i values = _mm_add_epi8(in, offsets);
+
+  // merge pairs of 6-bit values into 12 bits, then pairs of those into the
+  // 24 bits of a group, and put the groups' bytes in order
+  const __m128i pairs =
+      _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+  const __m128i groups = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+  const __m128i bytes = _mm_shuffle_epi8(
+      groups,
+      _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+  unsigned char buffer[16];
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(buffer), bytes);
+  std::memcpy(out, buffer, 12);
+  return true;
+}
+#endif
+
+char *EncodeBase64(const unsigned char *data, std::size_t size, char *out) {
   const char PAD = '=';
 
-  std::string ret;
-  ret.resize(4 * size / 3 + 3);
-  char *out = &ret[0];
+#ifdef YAML_CPP_BASE64_SSSE3
+  if (UseSSSE3()) {
+    // the block reads 16 bytes but only uses 12
+    for (; size >= 16; size -= 12, data += 12, out += 16)
+      EncodeBlock(data, out);
+  }
+#endif
 
   std::size_t chunks = size / 3;
   std::size_t remainder = size % 3;
@@ -40,61 +178,73 @@ std::string EncodeBase64(const unsigned char *data, std::size_t size) {
       break;
   }
 
-  ret.resize(out - &ret[0]);
-  return ret;
+  return out;
 }
 
-static const unsigned char decoding[] = {
-    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
-    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
-    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 62,  255,
-    255, 255, 63,  52,  53,  54,  55,  56,  57,  58,  59,  60,  61,  255, 255,
-    255, 0,   255, 255, 255, 0,   1,   2,   3,   4,   5,   6,   7,   8,   9,
-    10,  11,  12,  13,  14,  15,  16,  17,  18,  19,  20,  21,  22,  23,  24,
-    25,  255, 255, 255, 255, 255, 255, 26,  27,  28,  29,  30,  31,  32,  33,
-    34,  35,  36,  37,  38,  39,  40,  41,  42,  43,  44,  45,  46,  47,  48,
-    49,  50,  51,  255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
-    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
-    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
-    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
-    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
-    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
-    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
-    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
-    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
-    255,
-};
+std::string EncodeBase64(const unsigned char *data, std::size_t size) {
+  std::string ret;
+  ret.resize(EncodedBase64Size(size));
+  if (size > 0)
+    EncodeBase64(data, size, &ret[0]);
+  return ret;
+}
 
-std::vector<unsigned char> DecodeBase64(const std::string &input) {
-  using ret_type = std::vector<unsigned char>;
-  if (input.empty())
-    return ret_type();
+unsigned char *DecodeBase64(const char *input, std::size_t size,
+                            unsigned char *out) {
+  const char *const begin = input;
+  const char *const end = input + size;
 
-  ret_type ret(3 * input.size() / 4 + 1);
-  unsigned char *out = &ret[0];
+#ifdef YAML_CPP_BASE64_SSSE3
+  const bool useSSSE3 = UseSSSE3();
+#endif
 
   unsigned value = 0;
-  for (std::size_t i = 0, cnt = 0; i < input.size(); i++) {
-    if (std::isspace(input[i])) {
+  for (std::size_t cnt = 0; input != end; ++input) {
+#ifdef YAML_CPP_BASE64_SSSE3
+    // whole blocks of digits between groups; anything else, like
+    // whitespace or padding, goes through the loop below
+    if (useSSSE3 && cnt % 4 == 0) {
+      while (end - input >= 16 && DecodeBlock(input, out)) {
+        input += 16;
+        out += 12;
+      }
+      if (input == end)
+        break;
+    }
+#endif
+    unsigned char d = decoding[static_cast<unsigned char>(*input)];
+    if (d == kSpace) {
       // skip newlines
       continue;
     }
-    unsigned char d = decoding[static_cast<unsigned char>(input[i])];
     if (d == 255)
-      return ret_type();
+      return nullptr;
 
     value = (value << 6) | d;
     if (cnt % 4 == 3) {
       *out++ = value >> 16;
-      if (i > 0 && input[i - 1] != '=')
+      if (input != begin && input[-1] != '=')
         *out++ = value >> 8;
-      if (input[i] != '=')
+      if (*input != '=')
         *out++ = value;
     }
     ++cnt;
   }
 
-  ret.resize(out - &ret[0]);
+  return out;
+}
+
+std::vector<unsigned char> DecodeBase64(const std::string &input) {
+  using ret_type = std::vector<unsigned char>;
+  if (input.empty())
+    return ret_type();
+
+  ret_type ret(DecodedBase64Size(input.size()));
+  unsigned char *out = DecodeBase64(input.data(), input.size(), ret.data());
+  if (!out)
+    return ret_type();
+
+  ret.resize(out - ret.data());
   return ret;
 }
 }  // namespace YAML
@@ -1,39 +1,31 @@
 #include "node/convert.h"
 
-#include <algorithm>
+#include <cstring>
 
 namespace {
 // we're not gonna mess with the mess that is all the isupper/etc. functions
 bool IsLower(char ch) { return 'a' <= ch && ch <= 'z'; }
-bool IsUpper(char ch) { return 'A' <= ch && ch <= 'Z'; }
-char ToLower(char ch) { return IsUpper(ch) ? ch + 'a' - 'A' : ch; }
-
-std::string tolower(const std::string& str) {
-  std::string s(str);
-  std::transform(s.begin(), s.end(), s.begin(), ToLower);
-  return s;
-}
-
-template <typename T>
-bool IsEntirely(const std::string& str, T func) {
-  return std::all_of(str.begin(), str.end(), [=](char ch) { return func(ch); });
-}
+char ToUpper(char ch) { return IsLower(ch) ? ch - 'a' + 'A' : ch; }
 
 // IsFlexibleCase
-// . Returns true if 'str' is:
+// . Returns true if 'str' is 'name' (given in lowercase) in:
 //   . UPPERCASE
 //   . lowercase
 //   . Capitalized
-bool IsFlexibleCase(const std::string& str) {
-  if (str.empty())
-    return true;
+bool IsFlexibleCase(const char* str, std::size_t size, const char* name) {
+  if (size != std::strlen(name))
+    return false;
 
-  if (IsEntirely(str, IsLower))
-    return true;
+  const bool firstcaps = str[0] == ToUpper(name[0]);
+  if (!firstcaps && str[0] != name[0])
+    return false;
 
-  bool firstcaps = IsUpper(str[0]);
-  std::string rest = str.substr(1);
-  return firstcaps && (IsEntirely(rest, IsLower) || IsEntirely(rest, IsUpper));
+  const bool allcaps = firstcaps && size > 1 && str[1] == ToUpper(name[1]);
+  for (std::size_t i = 1; i < size; i++) {
+    if (str[i] != (allcaps ? ToUpper(name[i]) : name[i]))
+      return false;
+  }
+  return true;
 }
 }  // namespace
 
@@ -41,29 +33,50 @@ namespace YAML {
 bool convert<bool>::decode(const Node& node, bool& rhs) {
   if (!node.IsScalar())
     return false;
+  const std::string& input = node.Scalar();
+  return decode(ResolveScalar(input.data(), input.size()), node, rhs);
+}
+
+bool convert<bool>::decode(const ResolvedScalar& scalar, const Node& node,
+                           bool& rhs) {
+  if (scalar.type == ScalarType::Bool) {
+    rhs = scalar.boolValue;
+    return true;
+  }
+  if (scalar.type != ScalarType::String || !node.IsScalar())
+    return false;
 
-  // we can't use iostream bool extraction operators as they don't
-  // recognize all possible values in the table below (taken from
+  const std::string& input = node.Scalar();
+  return decode(scalar, input.data(), input.size(), rhs);
+}
+
+bool convert<bool>::decode(const ResolvedScalar& scalar, const char* data,
+                           std::size_t size, bool& rhs) {
+  if (scalar.type == ScalarType::Bool) {
+    rhs = scalar.boolValue;
+    return true;
+  }
+  if (scalar.type != ScalarType::String)
+    return false;
+
+  // besides true and false, YAML 1.1 spells booleans as below (taken from
   // http://yaml.org/type/bool.html)
   static const struct {
-    std::string truename, falsename;
+    const char* truename;
+    const char* falsename;
   } names[] = {
       {"y", "n"},
       {"yes", "no"},
-      {"true", "false"},
       {"on", "off"},
   };
 
-  if (!IsFlexibleCase(node.Scalar()))
-    return false;
-
   for (const auto& name : names) {
-    if (name.truename == tolower(node.Scalar())) {
+    if (IsFlexibleCase(data, size, name.truename)) {
       rhs = true;
       return true;
     }
 
-    if (name.falsename == tolower(node.Scalar())) {
+    if (IsFlexibleCase(data, size, name.falsename)) {
       rhs = false;
       return true;
     }
@@ -1,9 +1,28 @@
 #include "node/emit.h"
+
+#include <ostream>
+
 #include "nodeevents.h"
 #include "emitfromevents.h"
 #include "emitter.h"
+#include "jsonemitter.h"
+#include "node/view.h"
 
 namespace YAML {
+namespace {
+// passes the output of an Emitter on to a stream in large writes
+class StreamSink : public OutputSink {
+ public:
+  explicit StreamSink(std::ostream& stream) : m_stream(stream) {}
+  void Write(const char* data, std::size_t size) override {
+    m_stream.write(data, static_cast<std::streamsize>(size));
+  }
+
+ private:
+  std::ostream& m_stream;
+};
+}  // namespace
+
 Emitter& operator<<(Emitter& out, const Node& node) {
   EmitFromEvents emitFromEvents(out);
   NodeEvents events(node);
@@ -12,8 +31,10 @@ Emitter& operator<<(Emitter& out, const Node& node) {
 }
 
 std::ostream& operator<<(std::ostream& out, const Node& node) {
-  Emitter emitter(out);
+  StreamSink sink(out);
+  Emitter emitter(sink);
   emitter << node;
+  emitter.Flush();
   return out;
 }
 
@@ -22,4 +43,17 @@ std::string Dump(const Node& node) {
   emitter << node;
   return emitter.c_str();
 }
+
+JsonEmitter& operator<<(JsonEmitter& out, const Node& node) {
+  return out.Write(NodeView(node));
+}
+
+std::string DumpJson(const Node& node, std::size_t indent) {
+  JsonEmitter emitter;
+  emitter.SetIndent(indent);
+  emitter << node;
+  if (!emitter.good())
+    return std::string();
+  return std::string(emitter.c_str(), emitter.size());
+}
 }  // namespace YAML
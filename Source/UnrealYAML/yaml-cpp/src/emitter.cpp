@@ -1,5 +1,6 @@
 #include "emitter.h"
 
+#include <cstring>
 #include <sstream>
 
 #include "emitterutils.h"
@@ -7,6 +8,7 @@
 #include "emitterdef.h"
 #include "emittermanip.h"
 #include "exceptions.h"  // IWYU pragma: keep
+#include "numeric.h"
 
 namespace YAML {
 class Binary;
@@ -17,12 +19,17 @@ Emitter::Emitter() : m_pState(new EmitterState), m_stream{} {}
 Emitter::Emitter(std::ostream& stream)
     : m_pState(new EmitterState), m_stream(stream) {}
 
+Emitter::Emitter(OutputSink& sink, std::size_t bufferSize)
+    : m_pState(new EmitterState), m_stream(sink, bufferSize) {}
+
 Emitter::~Emitter() = default;
 
 const char* Emitter::c_str() const { return m_stream.str(); }
 
 std::size_t Emitter::size() const { return m_stream.pos(); }
 
+void Emitter::Flush() { m_stream.flush(); }
+
 // state checking
 bool Emitter::good() const { return m_pState->good(); }
 
@@ -679,23 +686,68 @@ void Emitter::SpaceOrIndentTo(bool requireSpace, std::size_t indent) {
   m_stream << IndentTo(indent);
 }
 
-void Emitter::PrepareIntegralStream(std::stringstream& stream) const {
+Emitter& Emitter::WriteInteger(bool negative, unsigned long long magnitude,
+                               unsigned long long bits) {
+  if (!good())
+    return *this;
 
+  PrepareNode(EmitterNodeType::Scalar);
+
+  char buffer[kMaxNumberSize];
+  char* p = buffer;
   switch (m_pState->GetIntFormat()) {
     case EmitterManip::Dec:
-      stream << std::dec;
+      if (negative)
+        *p++ = '-';
+      p = FormatNumber(p, magnitude);
       break;
     case EmitterManip::Hex:
-      stream << "0x";
-      stream << std::hex;
-      break;
-    case EmitterManip::Oct:
-      stream << "0";
-      stream << std::oct;
+    case EmitterManip::Oct: {
+      const bool hex = m_pState->GetIntFormat() == EmitterManip::Hex;
+      *p++ = '0';
+      if (hex)
+        *p++ = 'x';
+      char digits[24];
+      char* first = digits + sizeof(digits);
+      do {
+        *--first = "0123456789abcdef"[hex ? bits & 0xf : bits & 0x7];
+        bits >>= hex ? 4 : 3;
+      } while (bits != 0);
+      const std::size_t size = digits + sizeof(digits) - first;
+      std::memcpy(p, first, size);
+      p += size;
       break;
+    }
     default:
       assert(false);
   }
+  m_stream.write(buffer, p - buffer);
+
+  StartedScalar();
+
+  return *this;
+}
+
+Emitter& Emitter::WriteFloatingPoint(double value, std::size_t precision) {
+  if (!good())
+    return *this;
+
+  PrepareNode(EmitterNodeType::Scalar);
+
+  char buffer[kMaxNumberSize];
+  m_stream.write(buffer, FormatNumber(buffer, value, precision) - buffer);
+
+  StartedScalar();
+
+  return *this;
+}
+
+Emitter& Emitter::WriteStreamable(float value) {
+  return WriteFloatingPoint(value, GetFloatPrecision());
+}
+
+Emitter& Emitter::WriteStreamable(double value) {
+  return WriteFloatingPoint(value, GetDoublePrecision());
 }
 
 void Emitter::StartedScalar() { m_pState->StartedScalar(); }
@@ -490,8 +490,23 @@ bool WriteTagWithPrefix(ostream_wrapper& out, const std::string& prefix,
 }
 
 bool WriteBinary(ostream_wrapper& out, const Binary& binary) {
-  WriteDoubleQuotedString(out, EncodeBase64(binary.data(), binary.size()),
-                          StringEscaping::None);
+  // The text is the same as that of WriteDoubleQuotedString(), since base64
+  // needs no escapes, but it is encoded in chunks straight into the output
+  // rather than into one string for the whole blob.
+  const std::size_t chunkSize = 3 * 1024;
+  char buffer[4 * 1024];
+
+  const unsigned char* data = binary.data();
+  std::size_t size = binary.size();
+  out.write("\"", 1);
+  while (size > 0) {
+    const std::size_t chunk = std::min(size, chunkSize);
+    const char* end = EncodeBase64(data, chunk, buffer);
+    out.write(buffer, end - buffer);
+    data += chunk;
+    size -= chunk;
+  }
+  out.write("\"", 1);
   return true;
 }
 }  // namespace Utils
@@ -1,6 +1,8 @@
 #include "exceptions.h"
 #include "noexcept.h"
 
+#include <utility>
+
 namespace YAML {
 
 // These destructors are defined out-of-line so the vtable is only emitted once.
@@ -17,4 +19,45 @@ BadPushback::~BadPushback() YAML_CPP_NOEXCEPT = default;
 BadInsert::~BadInsert() YAML_CPP_NOEXCEPT = default;
 EmitterException::~EmitterException() YAML_CPP_NOEXCEPT = default;
 BadFile::~BadFile() YAML_CPP_NOEXCEPT = default;
+
+namespace {
+// the error itself is only touched when there is one
+thread_local bool hasError = false;
+thread_local Error threadError;
+}  // namespace
+
+bool HasError() { return hasError; }
+
+Error TakeError() {
+  if (!hasError)
+    return Error();
+  hasError = false;
+  Error taken;
+  std::swap(taken, threadError);
+  return taken;
+}
+
+void ClearError() {
+  if (hasError)
+    TakeError();
+}
+
+ErrorScope::~ErrorScope() {
+  if (!m_pending)
+    return;
+  threadError = std::move(m_pending);
+  hasError = true;
+}
+
+namespace detail {
+void set_error(ErrorCode code, const Exception& exception) {
+  if (hasError)
+    return;
+  threadError.code = code;
+  threadError.mark = exception.mark;
+  threadError.msg = exception.msg;
+  threadError.what = exception.what();
+  hasError = true;
+}
+}  // namespace detail
 }  // namespace YAML
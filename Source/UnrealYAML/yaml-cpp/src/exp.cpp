@@ -11,7 +11,7 @@ struct Mark;
 
 namespace YAML {
 namespace Exp {
-unsigned ParseHex(const std::string& str, const Mark& mark) {
+unsigned ParseHex(const std::string& str, Stream& in) {
   unsigned value = 0;
   for (char ch : str) {
     int digit = 0;
@@ -21,8 +21,10 @@ unsigned ParseHex(const std::string& str, const Mark& mark) {
       digit = ch - 'A' + 10;
     else if ('0' <= ch && ch <= '9')
       digit = ch - '0';
-    else
-      throw ParserException(mark, ErrorMsg::INVALID_HEX);
+    else {
+      in.fail(in.mark(), ErrorMsg::INVALID_HEX);
+      return 0;
+    }
 
     value = (value << 4) + digit;
   }
@@ -35,7 +37,7 @@ std::string Str(unsigned ch) { return std::string(1, static_cast<char>(ch)); }
 // Escape
 // . Translates the next 'codeLength' characters into a hex number and returns
 // the result.
-// . Throws if it's not actually hex.
+// . Fails the stream if it's not actually hex.
 std::string Escape(Stream& in, int codeLength) {
   // grab string
   std::string str;
@@ -43,13 +45,16 @@ std::string Escape(Stream& in, int codeLength) {
     str += in.get();
 
   // get the value
-  unsigned value = ParseHex(str, in.mark());
+  unsigned value = ParseHex(str, in);
+  if (in.failed())
+    return "";
 
   // legal unicode?
   if ((value >= 0xD800 && value <= 0xDFFF) || value > 0x10FFFF) {
     std::stringstream msg;
     msg << ErrorMsg::INVALID_UNICODE << value;
-    throw ParserException(in.mark(), msg.str());
+    in.fail(in.mark(), msg.str());
+    return "";
   }
 
   // now break it up into chars
@@ -71,7 +76,7 @@ std::string Escape(Stream& in, int codeLength) {
 // . Escapes the sequence starting 'in' (it must begin with a '\' or single
 // quote)
 //   and returns the result.
-// . Throws if it's an unknown escape character.
+// . Fails the stream if it's an unknown escape character.
 std::string Escape(Stream& in) {
   // eat slash
   char escape = in.get();
@@ -131,8 +136,8 @@ std::string Escape(Stream& in) {
       return Escape(in, 8);
   }
 
-  std::stringstream msg;
-  throw ParserException(in.mark(), std::string(ErrorMsg::INVALID_ESCAPE) + ch);
+  in.fail(in.mark(), std::string(ErrorMsg::INVALID_ESCAPE) + ch);
+  return "";
 }
 }  // namespace Exp
 }  // namespace YAML
@@ -0,0 +1,373 @@
+#include "node/frozen.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#include "eventhandler.h"
+#include "frozendata.h"
+#include "node/detail/node.h"
+#include "node/detail/node_iterator.h"
+#include "nodebuilder.h"
+
+namespace YAML {
+namespace detail {
+namespace {
+// maps with fewer entries are searched linearly
+const std::size_t kKeyIndexThreshold = 16;
+const std::uint32_t kNoKeyIndex = static_cast<std::uint32_t>(-1);
+
+class frozen_builder {
+ public:
+  frozen_builder(frozen_data& data, const shared_memory_holder& pMemory)
+      : m_data(data), m_pMemory(pMemory) {}
+
+  std::uint32_t add(const node& node) {
+    auto found = m_indices.find(node.ref());
+    if (found != m_indices.end()) {
+      m_data.nodes[found->second].aliased = true;
+      m_data.hasAliases = true;
+      return found->second;
+    }
+
+    const std::uint32_t index = static_cast<std::uint32_t>(m_data.nodes.size());
+    m_indices.emplace(node.ref(), index);
+    node.thaw_elements(m_pMemory);
+    m_data.nodes.push_back({node.type(), node.style(), 0, 0, add_tag(node.tag()),
+                            kNoKeyIndex, false, node.mark()});
+
+    switch (node.type()) {
+      case NodeType::Scalar:
+        m_data.nodes[index].first =
+            static_cast<std::uint32_t>(m_data.blob.size());
+        m_data.nodes[index].count =
+            static_cast<std::uint32_t>(node.scalar().size());
+        m_data.blob += node.scalar();
+        break;
+      case NodeType::Sequence:
+        add_sequence(node, index);
+        break;
+      case NodeType::Map:
+        add_map(node, index);
+        break;
+      case NodeType::Undefined:
+      case NodeType::Null:
+        break;
+    }
+    return index;
+  }
+
+ private:
+  // The children of a node are reserved before descending, so that they end
+  // up next to each other.
+  std::uint32_t reserve_children(std::uint32_t index, std::size_t count,
+                                 std::size_t perElement) {
+    const std::size_t first = m_data.children.size();
+    m_data.children.resize(first + count * perElement);
+    m_data.nodes[index].first = static_cast<std::uint32_t>(first);
+    m_data.nodes[index].count = static_cast<std::uint32_t>(count);
+    return static_cast<std::uint32_t>(first);
+  }
+
+  void add_sequence(const node& sequence, std::uint32_t index) {
+    std::size_t count = 0;
+    for (auto element : sequence) {
+      if ((*element).is_defined())
+        count++;
+    }
+
+    std::uint32_t child = reserve_children(index, count, 1);
+    for (auto element : sequence) {
+      if ((*element).is_defined()) {
+        const std::uint32_t value = add(*element);
+        m_data.children[child++] = value;
+      }
+    }
+  }
+
+  void add_map(const node& map, std::uint32_t index) {
+    std::size_t count = 0;
+    for (auto element : map) {
+      (void)element;
+      count++;
+    }
+
+    const std::uint32_t first = reserve_children(index, count, 2);
+    std::uint32_t child = first;
+    for (auto element : map) {
+      const std::uint32_t key = add(*element.first);
+      m_data.children[child++] = key;
+      const std::uint32_t value = add(*element.second);
+      m_data.children[child++] = value;
+    }
+
+    if (count >= kKeyIndexThreshold)
+      add_key_index(index, first, count);
+  }
+
+  void add_key_index(std::uint32_t index, std::uint32_t first,
+                     std::size_t count) {
+    std::vector<std::uint32_t> entries(count);
+    for (std::uint32_t i = 0; i < count; i++)
+      entries[i] = i;
+
+    // stable, so that the first of several equal keys is found first
+    const frozen_data& data = m_data;
+    std::stable_sort(entries.begin(), entries.end(),
+                     [&](std::uint32_t lhs, std::uint32_t rhs) {
+                       const frozen_record& key =
+                           data.nodes[data.children[first + 2 * rhs]];
+                       if (key.type != NodeType::Scalar)
+                         return data.nodes[data.children[first + 2 * lhs]]
+                                    .type == NodeType::Scalar;
+                       return data.key_less(data.children[first + 2 * lhs],
+                                            data.scalar(key), key.count);
+                     });
+
+    m_data.nodes[index].keyIndex =
+        static_cast<std::uint32_t>(m_data.sortedKeys.size());
+    m_data.sortedKeys.insert(m_data.sortedKeys.end(), entries.begin(),
+                             entries.end());
+  }
+
+  std::uint32_t add_tag(const std::string& tag) {
+    auto found = m_tags.find(tag);
+    if (found != m_tags.end())
+      return found->second;
+
+    const std::uint32_t index = static_cast<std::uint32_t>(m_data.tags.size());
+    m_data.tags.push_back(tag);
+    m_tags.emplace(tag, index);
+    return index;
+  }
+
+  frozen_data& m_data;
+  const shared_memory_holder& m_pMemory;
+  std::unordered_map<const node_ref*, std::uint32_t> m_indices;
+  std::unordered_map<std::string, std::uint32_t> m_tags;
+};
+
+// Replays a frozen subtree as parser events, so that NodeBuilder can turn it
+// back into nodes.
+class frozen_events {
+ public:
+  explicit frozen_events(const frozen_data& data) : m_data(data) {}
+
+  void emit(std::uint32_t index, EventHandler& handler) {
+    const frozen_record& record = m_data.nodes[index];
+
+    anchor_t anchor = NullAnchor;
+    if (record.aliased) {
+      auto found = m_anchors.find(index);
+      if (found != m_anchors.end()) {
+        handler.OnAlias(record.mark, found->second);
+        return;
+      }
+      anchor = static_cast<anchor_t>(m_anchors.size() + 1);
+      m_anchors.emplace(index, anchor);
+    }
+
+    const std::string& tag = m_data.tags[record.tag];
+    switch (record.type) {
+      case NodeType::Undefined:
+        break;
+      case NodeType::Null:
+        handler.OnNull(record.mark, anchor);
+        break;
+      case NodeType::Scalar:
+        handler.OnScalar(record.mark, tag, anchor,
+                         std::string(m_data.scalar(record), record.count));
+        break;
+      case NodeType::Sequence:
+        handler.OnSequenceStart(record.mark, tag, anchor, record.style);
+        for (std::uint32_t i = 0; i < record.count; i++)
+          emit(m_data.children[record.first + i], handler);
+        handler.OnSequenceEnd();
+        break;
+      case NodeType::Map:
+        handler.OnMapStart(record.mark, tag, anchor, record.style);
+        for (std::uint32_t i = 0; i < 2 * record.count; i++)
+          emit(m_data.children[record.first + i], handler);
+        handler.OnMapEnd();
+        break;
+    }
+  }
+
+ private:
+  const frozen_data& m_data;
+  std::unordered_map<std::uint32_t, anchor_t> m_anchors;
+};
+}  // namespace
+}  // namespace detail
+
+NodeType FrozenNode::Type() const {
+  return m_pData ? m_pData->nodes[m_index].type : NodeType::Undefined;
+}
+
+Mark FrozenNode::Mark() const {
+  return m_pData ? m_pData->nodes[m_index].mark : YAML::Mark::null_mark();
+}
+
+EmitterStyle FrozenNode::Style() const {
+  return m_pData ? m_pData->nodes[m_index].style : EmitterStyle::Default;
+}
+
+const std::string& FrozenNode::Tag() const {
+  return m_pData ? m_pData->tags[m_pData->nodes[m_index].tag]
+                 : detail::node_data::empty_scalar();
+}
+
+const char* FrozenNode::ScalarData() const {
+  if (Type() != NodeType::Scalar)
+    return "";
+  return m_pData->scalar(m_pData->nodes[m_index]);
+}
+
+std::size_t FrozenNode::ScalarSize() const {
+  return Type() == NodeType::Scalar ? m_pData->nodes[m_index].count : 0;
+}
+
+bool FrozenNode::decode_scalar(bool& rhs) const {
+  return IsScalar() && convert<bool>::decode(resolved_scalar(), ScalarData(),
+                                             ScalarSize(), rhs);
+}
+
+// as Node does, null decodes as the string "null"
+bool FrozenNode::decode_scalar(std::string& rhs) const {
+  switch (Type()) {
+    case NodeType::Null:
+      rhs = "null";
+      return true;
+    case NodeType::Scalar:
+      rhs.assign(ScalarData(), ScalarSize());
+      return true;
+    default:
+      return false;
+  }
+}
+
+namespace conversion {
+bool NarrowFloat(double value, const FrozenNode& node, float& rhs) {
+  const char* input = node.ScalarData();
+  return NarrowNumber(value, input, input + node.ScalarSize(), rhs);
+}
+}  // namespace conversion
+
+std::size_t FrozenNode::size() const {
+  switch (Type()) {
+    case NodeType::Sequence:
+    case NodeType::Map:
+      return m_pData->nodes[m_index].count;
+    default:
+      return 0;
+  }
+}
+
+FrozenNode FrozenNode::at(std::size_t index) const {
+  if (Type() != NodeType::Sequence || index >= size())
+    return FrozenNode();
+  const detail::frozen_record& record = m_pData->nodes[m_index];
+  return FrozenNode(m_pData, m_pData->children[record.first + index]);
+}
+
+FrozenNode FrozenNode::key_at(std::size_t index) const {
+  if (Type() != NodeType::Map || index >= size())
+    return FrozenNode();
+  const detail::frozen_record& record = m_pData->nodes[m_index];
+  return FrozenNode(m_pData, m_pData->children[record.first + 2 * index]);
+}
+
+FrozenNode FrozenNode::value_at(std::size_t index) const {
+  if (Type() != NodeType::Map || index >= size())
+    return FrozenNode();
+  const detail::frozen_record& record = m_pData->nodes[m_index];
+  return FrozenNode(m_pData, m_pData->children[record.first + 2 * index + 1]);
+}
+
+FrozenNode FrozenNode::find(const char* key, std::size_t size) const {
+  if (Type() != NodeType::Map)
+    return FrozenNode();
+
+  const detail::frozen_data& data = *m_pData;
+  const detail::frozen_record& record = data.nodes[m_index];
+  const std::uint32_t* entries = &data.children[record.first];
+
+  if (record.keyIndex == detail::kNoKeyIndex) {
+    for (std::uint32_t i = 0; i < record.count; i++) {
+      if (data.key_equals(entries[2 * i], key, size))
+        return FrozenNode(m_pData, entries[2 * i + 1]);
+    }
+    return FrozenNode();
+  }
+
+  const std::uint32_t* begin = &data.sortedKeys[record.keyIndex];
+  const std::uint32_t* end = begin + record.count;
+  const std::uint32_t* found =
+      std::lower_bound(begin, end, key, [&](std::uint32_t entry, const char*) {
+        return data.key_less(entries[2 * entry], key, size);
+      });
+  if (found != end && data.key_equals(entries[2 * *found], key, size))
+    return FrozenNode(m_pData, entries[2 * *found + 1]);
+  return FrozenNode();
+}
+
+Node FrozenNode::Thaw() const {
+  if (!m_pData || Type() == NodeType::Undefined)
+    return Node();
+
+  if (!m_pData->hasAliases) {
+    detail::shared_memory_holder pMemory(new detail::memory_holder);
+    detail::node& root = pMemory->create_node();
+    root.data().thaw(*m_pData, m_index);
+    pMemory->retain(*m_pData);
+    pMemory->list();
+    return Node(root, pMemory);
+  }
+
+  // Aliases must stay aliases, which needs all of the subtree at once.
+  NodeBuilder builder;
+  detail::frozen_events events(*m_pData);
+  builder.OnDocumentStart(YAML::Mark());
+  events.emit(m_index, builder);
+  builder.OnDocumentEnd();
+  return builder.Root();
+}
+
+FrozenDocument::FrozenDocument() : m_pData{} {}
+
+FrozenDocument::FrozenDocument(const Node& root) : m_pData{} {
+  // without exceptions, an invalid node is frozen as null
+  if (!root.m_isValid)
+    detail::raise(InvalidNode(root.m_invalidKey));
+
+  detail::ref_ptr<detail::frozen_data> pData(new detail::frozen_data);
+  if (root.m_pNode) {
+    detail::frozen_builder builder(*pData, root.m_pMemory);
+    builder.add(*root.m_pNode);
+  } else {
+    pData->tags.emplace_back();
+    pData->nodes.push_back({NodeType::Null, EmitterStyle::Default, 0, 0, 0,
+                            detail::kNoKeyIndex, false,
+                            YAML::Mark::null_mark()});
+  }
+  m_pData.reset(pData.get());
+}
+
+FrozenDocument::FrozenDocument(FrozenDocument&& rhs) = default;
+
+FrozenDocument& FrozenDocument::operator=(FrozenDocument&& rhs) = default;
+
+FrozenDocument::~FrozenDocument() = default;
+
+FrozenNode FrozenDocument::Root() const {
+  if (!m_pData || m_pData->nodes.empty())
+    return FrozenNode();
+  return FrozenNode(m_pData.get(), 0);
+}
+
+std::size_t FrozenDocument::size() const {
+  return m_pData ? m_pData->nodes.size() : 0;
+}
+
+FrozenDocument Freeze(const Node& node) { return FrozenDocument(node); }
+}  // namespace YAML
@@ -0,0 +1,73 @@
+#ifndef NODE_FROZENDATA_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+#define NODE_FROZENDATA_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+
+#if defined(_MSC_VER) ||                                            \
+    (defined(__GNUC__) && (__GNUC__ == 3 && __GNUC_MINOR__ >= 4) || \
+     (__GNUC__ >= 4))  // GCC supports "pragma once" correctly since 3.4
+#pragma once
+#endif
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "emitterstyle.h"
+#include "mark.h"
+#include "node/ptr.h"
+#include "node/type.h"
+
+namespace YAML {
+namespace detail {
+struct frozen_record {
+  NodeType type;
+  EmitterStyle style;
+  // scalars: position and size in the blob; sequences and maps: position of
+  // the first child in the children array and the number of elements or
+  // entries (each map entry takes two children, key and value)
+  std::uint32_t first;
+  std::uint32_t count;
+  std::uint32_t tag;
+  // large maps: position of their entries, sorted by key, in the sorted key
+  // array
+  std::uint32_t keyIndex;
+  // referenced from more than one place
+  bool aliased;
+  Mark mark;
+};
+
+// The contents of a FrozenDocument. Nodes thawed from it share it as long as
+// they have elements that were not thawed yet, see node_data::thaw().
+struct frozen_data : public ref_counted {
+  frozen_data() : hasAliases(false) {}
+
+  std::vector<frozen_record> nodes;
+  std::vector<std::uint32_t> children;
+  std::vector<std::uint32_t> sortedKeys;
+  std::vector<std::string> tags;
+  std::string blob;
+  // any record is aliased
+  bool hasAliases;
+
+  const char* scalar(const frozen_record& record) const {
+    return blob.data() + record.first;
+  }
+  // orders scalar keys by size, then bytes; other keys come last
+  bool key_less(std::uint32_t key, const char* data, std::size_t size) const {
+    const frozen_record& record = nodes[key];
+    if (record.type != NodeType::Scalar)
+      return false;
+    if (record.count != size)
+      return record.count < size;
+    return std::memcmp(scalar(record), data, size) < 0;
+  }
+  bool key_equals(std::uint32_t key, const char* data, std::size_t size) const {
+    const frozen_record& record = nodes[key];
+    return record.type == NodeType::Scalar && record.count == size &&
+           std::memcmp(scalar(record), data, size) == 0;
+  }
+};
+}  // namespace detail
+}  // namespace YAML
+
+#endif  // NODE_FROZENDATA_H_62B23520_7C8E_11DE_8A39_0800200C9A66
@@ -13,6 +13,16 @@
 #include "ostream_wrapper.h"
 
 namespace YAML {
+// Writes n spaces a run at a time, rather than one by one.
+inline void WriteSpaces(ostream_wrapper& out, std::size_t n) {
+  static const char spaces[] =
+      "                                                                ";
+  const std::size_t run = sizeof(spaces) - 1;
+  for (; n > run; n -= run)
+    out.write(spaces, run);
+  out.write(spaces, n);
+}
+
 struct Indentation {
   Indentation(std::size_t n_) : n(n_) {}
   std::size_t n;
@@ -20,8 +30,7 @@ struct Indentation {
 
 inline ostream_wrapper& operator<<(ostream_wrapper& out,
                                    const Indentation& indent) {
-  for (std::size_t i = 0; i < indent.n; i++)
-    out << ' ';
+  WriteSpaces(out, indent.n);
   return out;
 }
 
@@ -32,8 +41,8 @@ struct IndentTo {
 
 inline ostream_wrapper& operator<<(ostream_wrapper& out,
                                    const IndentTo& indent) {
-  while (out.col() < indent.n)
-    out << ' ';
+  if (out.col() < indent.n)
+    WriteSpaces(out, indent.n - out.col());
   return out;
 }
 }
@@ -0,0 +1,469 @@
+#include "jsonemitter.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "exceptions.h"
+#include "indentation.h"
+#include "node/view.h"
+#include "numeric.h"
+
+namespace YAML {
+namespace {
+const char kReplacementCharacter[] = "\xEF\xBF\xBD";
+
+bool IsDigit(char ch) { return ch >= '0' && ch <= '9'; }
+
+// -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][-+]?[0-9]+)?
+bool IsJsonNumber(const char* str, std::size_t size) {
+  const char* const end = str + size;
+  if (str != end && *str == '-')
+    ++str;
+  if (str == end || !IsDigit(*str))
+    return false;
+  if (*str++ != '0') {
+    while (str != end && IsDigit(*str))
+      ++str;
+  }
+  if (str != end && *str == '.') {
+    const char* const digits = ++str;
+    while (str != end && IsDigit(*str))
+      ++str;
+    if (str == digits)
+      return false;
+  }
+  if (str != end && (*str == 'e' || *str == 'E')) {
+    ++str;
+    if (str != end && (*str == '+' || *str == '-'))
+      ++str;
+    const char* const digits = str;
+    while (str != end && IsDigit(*str))
+      ++str;
+    if (str == digits)
+      return false;
+  }
+  return str == end;
+}
+
+// Whether any of the 8 bytes is a control character, '"', '\\' or not ASCII,
+// which all need a closer look; the others are copied as they are.
+bool NeedsEscaping(std::uint64_t bytes) {
+  const std::uint64_t ones = 0x0101010101010101ull;
+  const std::uint64_t highs = 0x8080808080808080ull;
+  const std::uint64_t quotes = bytes ^ (ones * '"');
+  const std::uint64_t backslashes = bytes ^ (ones * '\\');
+  const std::uint64_t controls = (bytes - ones * 0x20) & ~bytes;
+  return ((controls | ((quotes - ones) & ~quotes) |
+           ((backslashes - ones) & ~backslashes) | bytes) &
+          highs) != 0;
+}
+
+// The length of the well-formed UTF-8 sequence at str, or 0 if there is none
+// (RFC 3629: no overlong forms, surrogates or code points above U+10FFFF).
+std::size_t Utf8SequenceSize(const unsigned char* str,
+                             const unsigned char* end) {
+  const unsigned char lead = str[0];
+  std::size_t size;
+  unsigned char low = 0x80, high = 0xBF;
+  if (lead >= 0xC2 && lead <= 0xDF) {
+    size = 2;
+  } else if (lead >= 0xE0 && lead <= 0xEF) {
+    size = 3;
+    if (lead == 0xE0)
+      low = 0xA0;
+    else if (lead == 0xED)
+      high = 0x9F;
+  } else if (lead >= 0xF0 && lead <= 0xF4) {
+    size = 4;
+    if (lead == 0xF0)
+      low = 0x90;
+    else if (lead == 0xF4)
+      high = 0x8F;
+  } else {
+    return 0;
+  }
+
+  if (static_cast<std::size_t>(end - str) < size || str[1] < low ||
+      str[1] > high)
+    return 0;
+  for (std::size_t i = 2; i < size; i++) {
+    if ((str[i] & 0xC0) != 0x80)
+      return 0;
+  }
+  return size;
+}
+}  // namespace
+
+JsonEmitter::JsonEmitter()
+    : m_stream{}, m_indent(0), m_frames{}, m_hasTopValue(false) {}
+
+JsonEmitter::JsonEmitter(std::ostream& stream)
+    : m_stream(stream), m_indent(0), m_frames{}, m_hasTopValue(false) {}
+
+JsonEmitter::JsonEmitter(OutputSink& sink, std::size_t bufferSize)
+    : m_stream(sink, bufferSize),
+      m_indent(0),
+      m_frames{},
+      m_hasTopValue(false) {}
+
+JsonEmitter::~JsonEmitter() = default;
+
+bool JsonEmitter::SetIndent(std::size_t n) {
+  m_indent = n;
+  return true;
+}
+
+JsonEmitter& JsonEmitter::SetLocalValue(EmitterManip value) {
+  if (!good())
+    return *this;
+
+  const bool inMap = !m_frames.empty() && m_frames.back().isMap;
+  switch (value) {
+    case EmitterManip::BeginSeq:
+      BeginContainer(false);
+      break;
+    case EmitterManip::EndSeq:
+      EndContainer(false);
+      break;
+    case EmitterManip::BeginMap:
+      BeginContainer(true);
+      break;
+    case EmitterManip::EndMap:
+      EndContainer(true);
+      break;
+    case EmitterManip::Key:
+      if (!inMap || m_frames.back().expectsValue)
+        SetError(ErrorMsg::JSON_EXPECTED_VALUE);
+      break;
+    case EmitterManip::Value:
+      if (inMap && !m_frames.back().expectsValue)
+        SetError(ErrorMsg::JSON_EXPECTED_KEY);
+      break;
+    default:
+      break;
+  }
+  return *this;
+}
+
+JsonEmitter& JsonEmitter::Write(const char* str, std::size_t size) {
+  bool isKey;
+  if (!PrepareValue(false, isKey))
+    return *this;
+
+  WriteString(str, size);
+  FinishValue();
+  return *this;
+}
+
+JsonEmitter& JsonEmitter::Write(bool b) {
+  return b ? WriteNumber("true", 4) : WriteNumber("false", 5);
+}
+
+JsonEmitter& JsonEmitter::Write(const _Null& /*null*/) {
+  return WriteNumber("null", 4);
+}
+
+JsonEmitter& JsonEmitter::Write(const Binary& binary) {
+  bool isKey;
+  if (!PrepareValue(false, isKey))
+    return *this;
+
+  // base64 needs no escaping
+  std::string text(EncodedBase64Size(binary.size()) + 2, '"');
+  EncodeBase64(binary.data(), binary.size(), &text[1]);
+  m_stream.write(text);
+  FinishValue();
+  return *this;
+}
+
+JsonEmitter& JsonEmitter::Write(const NodeView& node) {
+  std::vector<NodeView> ancestors;
+  WriteNode(node, ancestors);
+  return *this;
+}
+
+JsonEmitter& JsonEmitter::Write(float value) {
+  if (!std::isfinite(value))
+    return Write(Null);
+
+  char buffer[kMaxNumberSize];
+  return WriteNumber(buffer, FormatNumber(buffer, value) - buffer);
+}
+
+JsonEmitter& JsonEmitter::Write(double value) {
+  if (!std::isfinite(value))
+    return Write(Null);
+
+  char buffer[kMaxNumberSize];
+  return WriteNumber(buffer, FormatNumber(buffer, value) - buffer);
+}
+
+JsonEmitter& JsonEmitter::WriteInteger(bool negative,
+                                       unsigned long long magnitude) {
+  char buffer[kMaxNumberSize + 1];
+  buffer[0] = '-';
+  char* const digits = buffer + 1;
+  const char* const end = FormatNumber(digits, magnitude);
+  return negative ? WriteNumber(buffer, end - buffer)
+                  : WriteNumber(digits, end - digits);
+}
+
+// numbers, booleans and null; in key position, they are written as strings
+JsonEmitter& JsonEmitter::WriteNumber(const char* text, std::size_t size) {
+  bool isKey;
+  if (!PrepareValue(false, isKey))
+    return *this;
+
+  if (isKey)
+    WriteString(text, size);
+  else
+    m_stream.write(text, size);
+  FinishValue();
+  return *this;
+}
+
+bool JsonEmitter::PrepareValue(bool isContainer, bool& isKey) {
+  isKey = false;
+  if (!good())
+    return false;
+
+  if (m_frames.empty()) {
+    if (m_hasTopValue)
+      m_stream.write("\n", 1);
+    return true;
+  }
+
+  const Frame& frame = m_frames.back();
+  if (frame.isMap && frame.expectsValue) {
+    m_stream.write(": ", m_indent > 0 ? 2 : 1);
+    return true;
+  }
+  if (frame.isMap && isContainer) {
+    SetError(ErrorMsg::JSON_COLLECTION_KEY);
+    return false;
+  }
+
+  if (frame.hasElements)
+    m_stream.write(",", 1);
+  if (m_indent > 0)
+    WriteIndentation(m_frames.size());
+  isKey = frame.isMap;
+  return true;
+}
+
+void JsonEmitter::FinishValue() {
+  if (m_frames.empty()) {
+    m_hasTopValue = true;
+    return;
+  }
+
+  Frame& frame = m_frames.back();
+  frame.hasElements = true;
+  if (frame.isMap)
+    frame.expectsValue = !frame.expectsValue;
+}
+
+void JsonEmitter::BeginContainer(bool isMap) {
+  bool isKey;
+  if (!PrepareValue(true, isKey))
+    return;
+
+  m_stream.write(isMap ? "{" : "[", 1);
+  m_frames.push_back({isMap, false, false});
+}
+
+void JsonEmitter::EndContainer(bool isMap) {
+  if (m_frames.empty() || m_frames.back().isMap != isMap) {
+    SetError(isMap ? ErrorMsg::UNEXPECTED_END_MAP
+                   : ErrorMsg::UNEXPECTED_END_SEQ);
+    return;
+  }
+  if (m_frames.back().expectsValue) {
+    SetError(ErrorMsg::JSON_EXPECTED_VALUE);
+    return;
+  }
+
+  const bool hasElements = m_frames.back().hasElements;
+  m_frames.pop_back();
+  if (hasElements && m_indent > 0)
+    WriteIndentation(m_frames.size());
+  m_stream.write(isMap ? "}" : "]", 1);
+  FinishValue();
+}
+
+void JsonEmitter::WriteIndentation(std::size_t depth) {
+  m_stream.write("\n", 1);
+  WriteSpaces(m_stream, depth * m_indent);
+}
+
+// Runs of characters that need no escaping are found 8 bytes at a time and
+// written at once.
+void JsonEmitter::WriteString(const char* str, std::size_t size) {
+  const unsigned char* it = reinterpret_cast<const unsigned char*>(str);
+  const unsigned char* const end = it + size;
+  const unsigned char* run = it;
+
+  m_stream.write("\"", 1);
+  while (it != end) {
+    if (end - it >= 8) {
+      std::uint64_t bytes;
+      std::memcpy(&bytes, it, sizeof(bytes));
+      if (!NeedsEscaping(bytes)) {
+        it += 8;
+        continue;
+      }
+    }
+
+    const unsigned char ch = *it;
+    if (ch >= 0x20 && ch != '"' && ch != '\\' && ch < 0x80) {
+      ++it;
+      continue;
+    }
+    if (ch >= 0x80) {
+      const std::size_t sequence = Utf8SequenceSize(it, end);
+      if (sequence > 0) {
+        it += sequence;
+        continue;
+      }
+    }
+
+    m_stream.write(reinterpret_cast<const char*>(run), it - run);
+    switch (ch) {
+      case '"':
+        m_stream.write("\\\"", 2);
+        break;
+      case '\\':
+        m_stream.write("\\\\", 2);
+        break;
+      case '\b':
+        m_stream.write("\\b", 2);
+        break;
+      case '\f':
+        m_stream.write("\\f", 2);
+        break;
+      case '\n':
+        m_stream.write("\\n", 2);
+        break;
+      case '\r':
+        m_stream.write("\\r", 2);
+        break;
+      case '\t':
+        m_stream.write("\\t", 2);
+        break;
+      default:
+        if (ch < 0x20) {
+          static const char hexDigits[] = "0123456789abcdef";
+          const char escape[] = {'\\', 'u', '0', '0', hexDigits[ch >> 4],
+                                 hexDigits[ch & 0xF]};
+          m_stream.write(escape, sizeof(escape));
+        } else {
+          m_stream.write(kReplacementCharacter,
+                         sizeof(kReplacementCharacter) - 1);
+        }
+        break;
+    }
+    run = ++it;
+  }
+  m_stream.write(reinterpret_cast<const char*>(run), it - run);
+  m_stream.write("\"", 1);
+}
+
+// Scalars that were quoted or are tagged !!str are strings, like null nodes
+// are null. Plain scalars resolve in the core schema (see ResolveScalar()),
+// except that those resolving to null stay strings, since only null nodes
+// are null; numbers are written as they are if their text is a JSON number,
+// and formatted otherwise, with infinities and NaN as null. Aliases are
+// written out in full, so a node that contains itself is an error.
+void JsonEmitter::WriteNode(const NodeView& node,
+                            std::vector<NodeView>& ancestors) {
+  if (!good())
+    return;
+
+  switch (node.Type()) {
+    case NodeType::Undefined:
+    case NodeType::Null:
+      Write(Null);
+      return;
+    case NodeType::Scalar:
+      break;
+    case NodeType::Sequence:
+    case NodeType::Map:
+      for (const NodeView& ancestor : ancestors) {
+        if (ancestor.is(node)) {
+          SetError(ErrorMsg::RECURSIVE_NODE);
+          return;
+        }
+      }
+      ancestors.push_back(node);
+      if (node.IsSequence()) {
+        BeginContainer(false);
+        for (auto it = node.begin(), end = node.end(); it != end && good();
+             ++it)
+          WriteNode((*it).second, ancestors);
+        EndContainer(false);
+      } else {
+        BeginContainer(true);
+        for (auto it = node.begin(), end = node.end(); it != end && good();
+             ++it) {
+          const std::pair<NodeView, NodeView> entry = *it;
+          // keys are written as their text; sequences and maps, as the
+          // minimal JSON of them
+          const NodeView& key = entry.first;
+          if (key.IsScalar()) {
+            Write(key.ScalarData(), key.ScalarSize());
+          } else if (key.IsSequence() || key.IsMap()) {
+            JsonEmitter json;
+            json.WriteNode(key, ancestors);
+            if (!json.good())
+              SetError(json.GetLastError());
+            else
+              Write(json.c_str(), json.size());
+          } else {
+            Write(Null);
+          }
+          WriteNode(entry.second, ancestors);
+        }
+        EndContainer(true);
+      }
+      ancestors.pop_back();
+      return;
+  }
+
+  const char* const data = node.ScalarData();
+  const std::size_t size = node.ScalarSize();
+  const std::string& tag = node.Tag();
+  if (tag == "!" || tag == "tag:yaml.org,2002:str") {
+    Write(data, size);
+    return;
+  }
+
+  const ResolvedScalar scalar = ResolveScalar(data, size);
+  switch (scalar.type) {
+    case ScalarType::Bool:
+      Write(scalar.boolValue);
+      break;
+    case ScalarType::Int:
+      if (IsJsonNumber(data, size))
+        WriteNumber(data, size);
+      else
+        WriteInteger(scalar.negative, scalar.magnitude);
+      break;
+    case ScalarType::Float:
+      if (IsJsonNumber(data, size))
+        WriteNumber(data, size);
+      else
+        Write(scalar.floatValue);
+      break;
+    case ScalarType::Null:
+    case ScalarType::String:
+      Write(data, size);
+      break;
+  }
+}
+
+void JsonEmitter::SetError(const std::string& error) {
+  if (good())
+    m_lastError = error;
+}
+}  // namespace YAML
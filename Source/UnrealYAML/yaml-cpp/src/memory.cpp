@@ -1,26 +1,578 @@
 #include "node/detail/memory.h"
+#include "frozendata.h"  // IWYU pragma: keep
 #include "node/detail/node.h"  // IWYU pragma: keep
+#include "node/memory_usage.h"
 #include "node/ptr.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <utility>
+
 namespace YAML {
 namespace detail {
+namespace {
+// Chunks start small, since many documents (e.g. the ones created by
+// convert<T>::encode) only ever hold a single node, and double in size with
+// every new chunk up to this limit.
+const std::size_t kMinChunkSize = 1;
+const std::size_t kMaxChunkSize = 512;
+
+// what compact() found reachable in a slot, and slots that were already free
+const unsigned char kNodeMarked = 1;
+const unsigned char kRefMarked = 2;
+const unsigned char kDataMarked = 4;
+const unsigned char kFreeSlot = 8;
+
+// The memories of live documents, see memory::list(), linked through the
+// memories themselves. They are spread over a few lists so that documents
+// loaded on different threads rarely wait for each other.
+struct listed_shard {
+  std::mutex mutex;
+  memory* pFirst = nullptr;
+};
+
+const std::size_t kListedShards = 16;
+
+// see memory::set_listing()
+std::atomic<bool> listing(false);
+
+// Never destroyed, since documents held by other static objects may die after
+// them.
+listed_shard* listed_shards() {
+  static listed_shard* pShards = new listed_shard[kListedShards];
+  return pShards;
+}
+
+listed_shard& listed_shard_of(const memory& memory) {
+  // memories are heap objects, so the low bits of their address say little
+  const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(&memory);
+  return listed_shards()[(address >> 6) % kListedShards];
+}
+
+std::size_t frozen_heap_size(const frozen_data& data) {
+  std::size_t size = sizeof(frozen_data) +
+                     data.nodes.capacity() * sizeof(frozen_record) +
+                     data.children.capacity() * sizeof(std::uint32_t) +
+                     data.sortedKeys.capacity() * sizeof(std::uint32_t) +
+                     data.tags.capacity() * sizeof(std::string) +
+                     node_data::string_heap_size(data.blob);
+  for (const std::string& tag : data.tags)
+    size += node_data::string_heap_size(tag);
+  return size;
+}
+}  // namespace
+
+class memory_chunk {
+ public:
+  explicit memory_chunk(std::size_t capacity)
+      : m_pNext(nullptr),
+        m_slots(static_cast<slot*>(::operator new(capacity * sizeof(slot)))),
+        m_size(0),
+        m_capacity(capacity) {}
+  memory_chunk(const memory_chunk&) = delete;
+  memory_chunk& operator=(const memory_chunk&) = delete;
+  ~memory_chunk() {
+    while (m_size > 0)
+      m_slots[--m_size].~slot();
+    ::operator delete(m_slots);
+  }
+
+  bool full() const { return m_size == m_capacity; }
+  std::size_t size() const { return m_size; }
+  std::size_t capacity() const { return m_capacity; }
+
+  node& create_node() {
+    slot* pSlot = new (&m_slots[m_size]) slot;
+    m_size++;
+    return pSlot->m_node;
+  }
+
+  // a node together with the node_ref and node_data it is created with
+  struct slot {
+    slot() : m_data{}, m_ref(m_data), m_node(m_ref) {}
+
+    node_data m_data;
+    node_ref m_ref;
+    node m_node;
+  };
+
+  slot& operator[](std::size_t index) { return m_slots[index]; }
+
+  const char* begin() const { return reinterpret_cast<const char*>(m_slots); }
+
+  // destroys the contents of a slot and leaves a fresh node in it
+  void reset(std::size_t index) {
+    m_slots[index].~slot();
+    new (&m_slots[index]) slot;
+  }
+
+  // next chunk owned by the same memory
+  memory_chunk* m_pNext;
+
+ private:
+  slot* m_slots;
+  std::size_t m_size;
+  std::size_t m_capacity;
+};
+
+// Mark bits for every slot of a memory, found by the address of the node,
+// node_ref or node_data inside it. The marks of the chunks are kept in the
+// order the chunks were added in, and the chunks themselves are only looked
+// at by add(), so they may be freed while the marks are still in use.
+class slot_marks {
+ public:
+  slot_marks() : m_chunks{}, m_marks{} {}
+
+  void add(const memory_chunk& chunk) {
+    if (chunk.size() == 0)
+      return;
+    m_chunks.push_back({chunk.begin(), chunk.size(), m_marks.size()});
+    m_marks.resize(m_marks.size() + chunk.size());
+  }
+
+  // after all chunks have been added
+  void seal() {
+    std::sort(m_chunks.begin(), m_chunks.end(),
+              [](const chunk_range& lhs, const chunk_range& rhs) {
+                return std::less<const char*>()(lhs.pBegin, rhs.pBegin);
+              });
+  }
+
+  // Returns true if the mark was not set yet. Objects outside of the memory
+  // are never marked.
+  bool mark(const void* p, unsigned char mark) {
+    unsigned char* pMarks = find(static_cast<const char*>(p));
+    if (!pMarks || (*pMarks & mark))
+      return false;
+    *pMarks |= mark;
+    return true;
+  }
+
+  bool marked(const void* p, unsigned char mark) {
+    const unsigned char* pMarks = find(static_cast<const char*>(p));
+    return pMarks && (*pMarks & mark);
+  }
+
+  // the marks of the slots of all chunks, in the order they were added in
+  const std::vector<unsigned char>& marks() const { return m_marks; }
+
+ private:
+  struct chunk_range {
+    const char* pBegin;
+    std::size_t size;
+    // of the chunk's first slot in m_marks
+    std::size_t offset;
+  };
+
+  unsigned char* find(const char* p) {
+    // the last chunk whose slots start at or before p
+    auto it = std::upper_bound(
+        m_chunks.begin(), m_chunks.end(), p,
+        [](const char* p, const chunk_range& range) {
+          return std::less<const char*>()(p, range.pBegin);
+        });
+    if (it == m_chunks.begin())
+      return nullptr;
+    --it;
+    const std::size_t index = (p - it->pBegin) / sizeof(memory_chunk::slot);
+    return index < it->size ? &m_marks[it->offset + index] : nullptr;
+  }
+
+  std::vector<chunk_range> m_chunks;
+  std::vector<unsigned char> m_marks;
+};
+
+memory& memory_holder::root() {
+  memory& root = m_pMemory->root();
+  if (m_pMemory.get() != &root)
+    m_pMemory.reset(&root);
+  return root;
+}
 
 void memory_holder::merge(memory_holder& rhs) {
-  if (m_pMemory == rhs.m_pMemory)
+  memory& lhsRoot = root();
+  memory& rhsRoot = rhs.root();
+  if (&lhsRoot == &rhsRoot)
     return;
 
-  m_pMemory->merge(*rhs.m_pMemory);
+  lhsRoot.merge(rhsRoot);
   rhs.m_pMemory = m_pMemory;
 }
 
+memory::memory()
+    : m_pFirst(nullptr),
+      m_pLast(nullptr),
+      m_size(0),
+      m_pForward{},
+      m_frozen{},
+      m_free{},
+      m_isListed(false),
+      m_pPrevListed(nullptr),
+      m_pNextListed(nullptr) {}
+
+memory::~memory() {
+  if (m_isListed)
+    unlist();
+  while (m_pFirst) {
+    memory_chunk* pNext = m_pFirst->m_pNext;
+    delete m_pFirst;
+    m_pFirst = pNext;
+  }
+}
+
+memory& memory::root() {
+  memory* pRoot = this;
+  while (pRoot->m_pForward)
+    pRoot = pRoot->m_pForward.get();
+
+  // path compression; the next memory in the chain is held on to, since
+  // re-pointing the current one may drop its last reference, and is only let
+  // go of once it has been re-pointed in turn
+  shared_memory pHeld;
+  for (memory* pMemory = this; pMemory != pRoot;) {
+    shared_memory pNext = pMemory->m_pForward;
+    if (pNext.get() != pRoot)
+      pMemory->m_pForward.reset(pRoot);
+    pMemory = pNext.get();
+    pHeld = std::move(pNext);
+  }
+  return *pRoot;
+}
+
 node& memory::create_node() {
-  shared_node pNode(new node);
-  m_nodes.insert(pNode);
-  return *pNode;
+  if (!m_free.empty()) {
+    node* pNode = m_free.back();
+    m_free.pop_back();
+    m_size++;
+    return *pNode;
+  }
+
+  if (!m_pFirst || m_pFirst->full()) {
+    const std::size_t capacity =
+        m_pFirst ? std::min(m_pFirst->capacity() * 2, kMaxChunkSize)
+                 : kMinChunkSize;
+    memory_chunk* pChunk = new memory_chunk(capacity);
+    pChunk->m_pNext = m_pFirst;
+    m_pFirst = pChunk;
+    if (!m_pLast)
+      m_pLast = pChunk;
+  }
+  m_size++;
+  return m_pFirst->create_node();
+}
+
+// Both memories must be roots. The chunks of the smaller one are spliced
+// onto the larger one, which keeps forwarding chains logarithmic.
+void memory::merge(memory& rhs) {
+  memory* pTo = this;
+  memory* pFrom = &rhs;
+  if (pTo->m_size < pFrom->m_size)
+    std::swap(pTo, pFrom);
+
+  if (pFrom->m_pFirst) {
+    if (pTo->m_pLast)
+      pTo->m_pLast->m_pNext = pFrom->m_pFirst;
+    else
+      pTo->m_pFirst = pFrom->m_pFirst;
+    pTo->m_pLast = pFrom->m_pLast;
+  }
+  pTo->m_size += pFrom->m_size;
+  pFrom->m_pFirst = pFrom->m_pLast = nullptr;
+  pFrom->m_size = 0;
+
+  pTo->m_free.insert(pTo->m_free.end(), pFrom->m_free.begin(),
+                     pFrom->m_free.end());
+  pFrom->m_free.clear();
+
+  for (const ref_ptr<const frozen_data>& pData : pFrom->m_frozen)
+    pTo->retain(*pData);
+  pFrom->m_frozen.clear();
+
+  if (pFrom->m_isListed) {
+    pFrom->unlist();
+    pTo->link();
+  }
+  pFrom->m_pForward.reset(pTo);
+}
+
+void memory::retain(const frozen_data& data) {
+  // a memory rarely holds on to more than a few documents
+  for (const ref_ptr<const frozen_data>& pData : m_frozen) {
+    if (pData.get() == &data)
+      return;
+  }
+  m_frozen.emplace_back(&data);
+}
+
+// Marks every node, node_ref and node_data reachable from the pinned nodes,
+// then resets the slots that have nothing marked and frees the chunks that
+// have no marked slot at all. Of the slots that are partly reachable, the
+// payloads of unreachable node_data and the dependency lists of unreachable
+// nodes are released.
+std::size_t memory::compact() {
+  slot_marks marks;
+  std::vector<const node*> nodes;
+  std::vector<const node_data*> datas;
+  for (memory_chunk* pChunk = m_pFirst; pChunk; pChunk = pChunk->m_pNext) {
+    marks.add(*pChunk);
+    for (std::size_t i = 0; i < pChunk->size(); i++) {
+      const node& node = (*pChunk)[i].m_node;
+      if (node.pinned())
+        nodes.push_back(&node);
+    }
+  }
+  marks.seal();
+  for (node* pNode : m_free)
+    marks.mark(pNode, kFreeSlot);
+
+  std::vector<const frozen_data*> frozen;
+  while (!nodes.empty() || !datas.empty()) {
+    if (!datas.empty()) {
+      const node_data& data = *datas.back();
+      datas.pop_back();
+      if (!marks.mark(&data, kDataMarked))
+        continue;
+
+      if (data.m_isFrozen) {
+        if (std::find(frozen.begin(), frozen.end(), data.m_frozen.pData) ==
+            frozen.end())
+          frozen.push_back(data.m_frozen.pData);
+      } else if (data.m_type == NodeType::Sequence) {
+        nodes.insert(nodes.end(), data.m_sequence.nodes.begin(),
+                     data.m_sequence.nodes.end());
+      } else if (data.m_type == NodeType::Map) {
+        for (const auto& entry : data.m_map.entries) {
+          nodes.push_back(entry.first);
+          nodes.push_back(entry.second);
+        }
+      }
+      // the maps that wait for this data to become defined
+      if (data.m_pSide) {
+        for (const auto& pair : data.m_pSide->waitingPairs) {
+          datas.push_back(pair.map);
+          nodes.push_back(pair.self);
+          nodes.push_back(pair.other);
+        }
+      }
+      continue;
+    }
+
+    const node& node = *nodes.back();
+    nodes.pop_back();
+    if (!marks.mark(&node, kNodeMarked))
+      continue;
+
+    if (node.m_pDependency)
+      nodes.push_back(node.m_pDependency);
+    nodes.insert(nodes.end(), node.m_dependencies.begin(),
+                 node.m_dependencies.end());
+    if (marks.mark(node.m_pRef, kRefMarked))
+      datas.push_back(&node.m_pRef->data());
+  }
+
+  std::size_t reclaimed = 0;
+  m_free.clear();
+  m_size = 0;
+  memory_chunk* pPrevious = nullptr;
+  const unsigned char* pNextMarks = marks.marks().data();
+  for (memory_chunk* pChunk = m_pFirst; pChunk;) {
+    memory_chunk* pNext = pChunk->m_pNext;
+    const unsigned char* pMarks = pNextMarks;
+    pNextMarks += pChunk->size();
+
+    std::size_t live = 0;
+    for (std::size_t i = 0; i < pChunk->size(); i++) {
+      const unsigned char mark = pMarks[i];
+      if (mark != 0 && mark != kFreeSlot)
+        live++;
+    }
+
+    for (std::size_t i = 0; i < pChunk->size(); i++) {
+      const unsigned char mark = pMarks[i];
+      memory_chunk::slot& slot = (*pChunk)[i];
+      if (mark == kFreeSlot) {
+        if (live > 0)
+          m_free.push_back(&slot.m_node);
+        continue;
+      }
+
+      if (!(mark & kDataMarked)) {
+        reclaimed += slot.m_data.heap_size();
+        if (mark != 0) {
+          slot.m_data.~node_data();
+          new (&slot.m_data) node_data;
+        }
+      } else {
+        // a key or value may outlive the maps that indexed or held it
+        node_data& data = slot.m_data;
+        auto unmarked = [&](const node_data* pMap) {
+          return !marks.marked(pMap, kDataMarked);
+        };
+        if (data.m_pIndexingMap && unmarked(data.m_pIndexingMap))
+          data.m_pIndexingMap = nullptr;
+        if (data.m_pHoldingMap && unmarked(data.m_pHoldingMap))
+          data.m_pHoldingMap = nullptr;
+        if (data.m_pSide) {
+          std::vector<node_data*>& indexing = data.m_pSide->indexingMaps;
+          indexing.erase(
+              std::remove_if(indexing.begin(), indexing.end(), unmarked),
+              indexing.end());
+          std::vector<node_data*>& holding = data.m_pSide->holdingMaps;
+          holding.erase(
+              std::remove_if(holding.begin(), holding.end(), unmarked),
+              holding.end());
+        }
+      }
+      if (!(mark & kNodeMarked)) {
+        reclaimed += slot.m_node.m_dependencies.capacity() * sizeof(node*);
+        if (mark != 0) {
+          slot.m_node.m_pDependency = nullptr;
+          std::vector<node*>().swap(slot.m_node.m_dependencies);
+        }
+      }
+      if (mark == 0) {
+        reclaimed += sizeof(memory_chunk::slot);
+        if (live > 0) {
+          pChunk->reset(i);
+          m_free.push_back(&slot.m_node);
+        }
+      }
+    }
+
+    if (live == 0) {
+      if (pPrevious)
+        pPrevious->m_pNext = pNext;
+      else
+        m_pFirst = pNext;
+      if (m_pLast == pChunk)
+        m_pLast = pPrevious;
+      delete pChunk;
+    } else {
+      m_size += live;
+      pPrevious = pChunk;
+    }
+    pChunk = pNext;
+  }
+
+  // documents that only the released nodes were thawing from
+  m_frozen.erase(
+      std::remove_if(m_frozen.begin(), m_frozen.end(),
+                     [&](const ref_ptr<const frozen_data>& pData) {
+                       return std::find(frozen.begin(), frozen.end(),
+                                        pData.get()) == frozen.end();
+                     }),
+      m_frozen.end());
+  return reclaimed;
+}
+
+// Counts a node by the type of the data it refers to, but the bytes by the
+// data in its slot, which is what the slot holds on to even after the node was
+// made to refer to another node's data.
+void memory::add_usage(MemoryUsage& usage) const {
+  std::vector<const node*> free(m_free.begin(), m_free.end());
+  std::sort(free.begin(), free.end(), std::less<const node*>());
+
+  usage.nodeBytes += sizeof(memory) + m_free.capacity() * sizeof(node*) +
+                     m_frozen.capacity() * sizeof(ref_ptr<const frozen_data>);
+  for (memory_chunk* pChunk = m_pFirst; pChunk; pChunk = pChunk->m_pNext) {
+    usage.nodeBytes +=
+        sizeof(memory_chunk) + pChunk->capacity() * sizeof(memory_chunk::slot);
+    for (std::size_t i = 0; i < pChunk->size(); i++) {
+      const memory_chunk::slot& slot = (*pChunk)[i];
+      if (std::binary_search(free.begin(), free.end(), &slot.m_node,
+                             std::less<const node*>())) {
+        usage.freeNodes++;
+        continue;
+      }
+
+      switch (slot.m_node.type()) {
+        case NodeType::Undefined:
+          usage.undefinedNodes++;
+          break;
+        case NodeType::Null:
+          usage.nullNodes++;
+          break;
+        case NodeType::Scalar:
+          usage.scalarNodes++;
+          break;
+        case NodeType::Sequence:
+          usage.sequenceNodes++;
+          break;
+        case NodeType::Map:
+          usage.mapNodes++;
+          break;
+      }
+
+      const node_data& data = slot.m_data;
+      usage.scalarBytes += data.scalar_heap_size();
+      usage.containerBytes += data.container_heap_size();
+      usage.tagBytes += data.tag_heap_size();
+      usage.nodeBytes += data.side_heap_size() +
+                         slot.m_node.m_dependencies.capacity() * sizeof(node*);
+    }
+  }
+
+  for (const ref_ptr<const frozen_data>& pData : m_frozen)
+    usage.frozenBytes += frozen_heap_size(*pData);
+}
+
+void memory::list() {
+  if (listing.load(std::memory_order_relaxed))
+    link();
+}
+
+void memory::set_listing(bool enabled) {
+  listing.store(enabled, std::memory_order_relaxed);
+}
+
+bool memory::is_listing() { return listing.load(std::memory_order_relaxed); }
+
+void memory::link() {
+  if (m_isListed)
+    return;
+
+  listed_shard& shard = listed_shard_of(*this);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  m_pPrevListed = nullptr;
+  m_pNextListed = shard.pFirst;
+  if (shard.pFirst)
+    shard.pFirst->m_pPrevListed = this;
+  shard.pFirst = this;
+  m_isListed = true;
+}
+
+void memory::unlist() {
+  listed_shard& shard = listed_shard_of(*this);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  if (m_pPrevListed)
+    m_pPrevListed->m_pNextListed = m_pNextListed;
+  else
+    shard.pFirst = m_pNextListed;
+  if (m_pNextListed)
+    m_pNextListed->m_pPrevListed = m_pPrevListed;
+  m_pPrevListed = m_pNextListed = nullptr;
+  m_isListed = false;
 }
 
-void memory::merge(const memory& rhs) {
-  m_nodes.insert(rhs.m_nodes.begin(), rhs.m_nodes.end());
+// Merging unlists the memory that forwards, so the listed memories are all
+// roots. Holding the lock of a list keeps its memories from being destroyed
+// while they are counted; nothing keeps them from being changed.
+std::vector<MemoryUsage> memory::listed_usage() {
+  std::vector<MemoryUsage> usages;
+  for (std::size_t i = 0; i < kListedShards; i++) {
+    listed_shard& shard = listed_shards()[i];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    for (const memory* pMemory = shard.pFirst; pMemory;
+         pMemory = pMemory->m_pNextListed) {
+      usages.emplace_back();
+      pMemory->add_usage(usages.back());
+    }
+  }
+  return usages;
 }
 }  // namespace detail
 }  // namespace YAML
@@ -0,0 +1,65 @@
+#include "node/memory_usage.h"
+
+#include "exceptions.h"
+#include "node/detail/memory.h"
+#include "node/node.h"
+
+namespace YAML {
+MemoryUsage::MemoryUsage()
+    : undefinedNodes(0),
+      nullNodes(0),
+      scalarNodes(0),
+      sequenceNodes(0),
+      mapNodes(0),
+      freeNodes(0),
+      scalarBytes(0),
+      tagBytes(0),
+      containerBytes(0),
+      nodeBytes(0),
+      frozenBytes(0) {}
+
+MemoryUsage& MemoryUsage::operator+=(const MemoryUsage& rhs) {
+  undefinedNodes += rhs.undefinedNodes;
+  nullNodes += rhs.nullNodes;
+  scalarNodes += rhs.scalarNodes;
+  sequenceNodes += rhs.sequenceNodes;
+  mapNodes += rhs.mapNodes;
+  freeNodes += rhs.freeNodes;
+  scalarBytes += rhs.scalarBytes;
+  tagBytes += rhs.tagBytes;
+  containerBytes += rhs.containerBytes;
+  nodeBytes += rhs.nodeBytes;
+  frozenBytes += rhs.frozenBytes;
+  return *this;
+}
+
+MemoryUsage GetMemoryUsage(const Node& node) {
+  if (!node.m_isValid) {
+    detail::raise(InvalidNode(node.m_invalidKey));
+    return MemoryUsage();
+  }
+
+  MemoryUsage usage;
+  if (node.m_pMemory)
+    node.m_pMemory->add_usage(usage);
+  return usage;
+}
+
+std::size_t GetNodeCount(const Node& node) {
+  if (!node.m_isValid) {
+    detail::raise(InvalidNode(node.m_invalidKey));
+    return 0;
+  }
+  return node.m_pMemory ? node.m_pMemory->size() : 0;
+}
+
+std::vector<MemoryUsage> GetDocumentMemoryUsage() {
+  return detail::memory::listed_usage();
+}
+
+void SetDocumentTracking(bool enabled) {
+  detail::memory::set_listing(enabled);
+}
+
+bool IsDocumentTracking() { return detail::memory::is_listing(); }
+}  // namespace YAML
@@ -1,12 +1,102 @@
 #include "node/node.h"
-#include "nodebuilder.h"
-#include "nodeevents.h"
+
+#include <unordered_map>
+
+#include "frozendata.h"  // IWYU pragma: keep
+#include "node/detail/memory.h"
+#include "node/detail/node.h"
+#include "node/detail/node_iterator.h"
+#include "node/impl.h"
 
 namespace YAML {
+namespace {
+// Copies a node tree into a new memory. Nodes that are aliased in the source
+// are aliased in the copy as well. Sequences and maps whose elements are still
+// frozen (see FrozenNode::Thaw) share them with the source instead of being
+// copied, so cloning a thawed document only copies what was touched since.
+class node_cloner {
+ public:
+  node_cloner() : m_pMemory(new detail::memory_holder), m_copies{} {}
+
+  const detail::shared_memory_holder& memory() const { return m_pMemory; }
+
+  detail::node& clone(const detail::node& source) {
+    auto found = m_copies.find(source.ref());
+    if (found != m_copies.end())
+      return *found->second;
+
+    detail::node& copy = m_pMemory->create_node();
+    m_copies.emplace(source.ref(), &copy);
+
+    switch (source.type()) {
+      case NodeType::Undefined:
+        return copy;
+      case NodeType::Null:
+        copy.set_null();
+        break;
+      case NodeType::Scalar:
+        copy.set_scalar(source.scalar());
+        break;
+      case NodeType::Sequence:
+        copy.set_type(NodeType::Sequence);
+        if (share_frozen_elements(source, copy))
+          break;
+        for (auto element : source) {
+          if ((*element).is_defined())
+            copy.push_back(clone(*element), m_pMemory);
+        }
+        break;
+      case NodeType::Map:
+        copy.set_type(NodeType::Map);
+        if (share_frozen_elements(source, copy))
+          break;
+        for (auto element : source)
+          copy.insert(clone(*element.first), clone(*element.second),
+                      m_pMemory);
+        break;
+    }
+
+    copy.set_mark(source.mark());
+    copy.set_tag(source.tag());
+    copy.set_style(source.style());
+    return copy;
+  }
+
+ private:
+  bool share_frozen_elements(const detail::node& source, detail::node& copy) {
+    if (!copy.data().share_frozen_elements(source.data()))
+      return false;
+    m_pMemory->retain(*source.data().frozen_document());
+    return true;
+  }
+
+  detail::shared_memory_holder m_pMemory;
+  std::unordered_map<const detail::node_ref*, detail::node*> m_copies;
+};
+}  // namespace
+
 Node Clone(const Node& node) {
-  NodeEvents events(node);
-  NodeBuilder builder;
-  events.Emit(builder);
-  return builder.Root();
+  if (!node.m_pNode || !node.m_pNode->is_defined())
+    return Node();
+
+  node_cloner cloner;
+  detail::node& root = cloner.clone(*node.m_pNode);
+  return Node(root, cloner.memory());
+}
+
+std::size_t Compact(const Node& node) {
+  if (!node.m_isValid) {
+    detail::raise(InvalidNode(node.m_invalidKey));
+    return 0;
+  }
+  return node.m_pMemory ? node.m_pMemory->compact() : 0;
+}
+
+ResolvedScalar ResolveScalar(const Node& node) {
+  if (!node.m_isValid) {
+    detail::raise(InvalidNode(node.m_invalidKey));
+    return ResolveScalar("", 0);
+  }
+  return node.m_pNode ? node.m_pNode->resolved_scalar() : ResolveScalar("", 0);
 }
 }  // namespace YAML
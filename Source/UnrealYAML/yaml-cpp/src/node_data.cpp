@@ -2,10 +2,13 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <iterator>
+#include <new>
 #include <sstream>
 
 #include "exceptions.h"
+#include "frozendata.h"
 #include "node/detail/memory.h"
 #include "node/detail/node.h"
 #include "node/detail/node_iterator.h"
@@ -14,77 +17,170 @@
 
 namespace YAML {
 namespace detail {
-YAML_CPP_API std::atomic<size_t> node::m_amount{0};
+namespace {
+// maps with fewer entries are searched linearly
+const std::size_t kKeyIndexThreshold = 16;
+
+// FNV-1a
+std::size_t hash_key(const char* key, std::size_t size) {
+  std::size_t hash = static_cast<std::size_t>(14695981039346656037ULL);
+  for (std::size_t i = 0; i < size; i++) {
+    hash ^= static_cast<unsigned char>(key[i]);
+    hash *= static_cast<std::size_t>(1099511628211ULL);
+  }
+  return hash;
+}
+
+bool is_string_key(const node& keyNode, const char* key, std::size_t size) {
+  if (keyNode.type() != NodeType::Scalar)
+    return false;
+  const std::string& scalar = keyNode.scalar();
+  return scalar.size() == size && std::memcmp(scalar.data(), key, size) == 0;
+}
+}  // namespace
 
 const std::string& node_data::empty_scalar() {
   static const std::string svalue;
   return svalue;
 }
 
+// short strings are stored inside the string object itself
+std::size_t node_data::string_heap_size(const std::string& value) {
+  const char* pData = value.data();
+  const char* pObject = reinterpret_cast<const char*>(&value);
+  if (pData >= pObject && pData < pObject + sizeof(value))
+    return 0;
+  return value.capacity() + 1;
+}
+
 node_data::node_data()
-    : m_isDefined(false),
-      m_mark(Mark::null_mark()),
+    : m_mark(Mark::null_mark()),
       m_type(NodeType::Null),
-      m_tag{},
       m_style(EmitterStyle::Default),
-      m_scalar{},
-      m_sequence{},
-      m_seqSize(0),
-      m_map{},
-      m_undefinedPairs{} {}
+      m_isDefined(false),
+      m_isFrozen(false),
+      m_tagKind(tag_kind::None),
+      m_resolvedType(0),
+      m_pIndexingMap(nullptr),
+      m_pHoldingMap(nullptr),
+      m_pSide{} {}
+
+node_data::~node_data() { destroy_payload(); }
 
 void node_data::mark_defined() {
   if (m_type == NodeType::Undefined)
     m_type = NodeType::Null;
+  set_defined();
+}
+
+void node_data::set_defined() {
+  if (m_isDefined)
+    return;
+
   m_isDefined = true;
+  if (!m_pSide)
+    return;
+
+  std::vector<undefined_pair> waiting;
+  waiting.swap(m_pSide->waitingPairs);
+  for (const undefined_pair& pair : waiting) {
+    // if key and value both refer to this data, there is a record for each
+    // of them, but the entry must only be counted once
+    if (&pair.other->data() == this && pair.other < pair.self)
+      continue;
+    if (pair.other->is_defined())
+      pair.map->m_map.undefinedPairs--;
+  }
 }
 
 void node_data::set_mark(const Mark& mark) { m_mark = mark; }
 
 void node_data::set_type(NodeType type) {
+  // only new data is made undefined (see Node(NodeType)), which no map holds
+  // yet; nodes turn undefined through node::set_ref() and node::set_data()
   if (type == NodeType::Undefined) {
-    m_type = type;
+    reset_payload(type);
     m_isDefined = false;
     return;
   }
 
-  m_isDefined = true;
+  set_defined();
   if (type == m_type)
     return;
 
-  m_type = type;
+  reset_payload(type);
+}
 
-  switch (m_type) {
-    case NodeType::Null:
-      break;
-    case NodeType::Scalar:
-      m_scalar.clear();
-      break;
-    case NodeType::Sequence:
-      reset_sequence();
-      break;
-    case NodeType::Map:
-      reset_map();
-      break;
-    case NodeType::Undefined:
-      assert(false);
-      break;
+const std::string& node_data::tag() const {
+  static const std::string nonSpecific("?");
+  static const std::string nonPlain("!");
+
+  switch (m_tagKind) {
+    case tag_kind::None:
+      return empty_scalar();
+    case tag_kind::NonSpecific:
+      return nonSpecific;
+    case tag_kind::NonPlain:
+      return nonPlain;
+    case tag_kind::Other:
+      return m_pSide->tag;
   }
+  return empty_scalar();
 }
 
-void node_data::set_tag(const std::string& tag) { m_tag = tag; }
+void node_data::set_tag(const std::string& tag) {
+  if (tag.empty()) {
+    m_tagKind = tag_kind::None;
+  } else if (tag == "?") {
+    m_tagKind = tag_kind::NonSpecific;
+  } else if (tag == "!") {
+    m_tagKind = tag_kind::NonPlain;
+  } else {
+    side().tag = tag;
+    m_tagKind = tag_kind::Other;
+  }
+}
 
 void node_data::set_style(EmitterStyle style) { m_style = style; }
 
 void node_data::set_null() {
-  m_isDefined = true;
-  m_type = NodeType::Null;
+  set_defined();
+  reset_payload(NodeType::Null);
 }
 
 void node_data::set_scalar(const std::string& scalar) {
-  m_isDefined = true;
-  m_type = NodeType::Scalar;
-  m_scalar = scalar;
+  set_defined();
+  drop_key_indexes();
+  if (m_type != NodeType::Scalar)
+    reset_payload(NodeType::Scalar);
+  m_scalar.value = scalar;
+  m_resolvedType.store(0, std::memory_order_relaxed);
+}
+
+ResolvedScalar node_data::resolve_scalar() const {
+  ResolvedScalar scalar;
+  if (m_type != NodeType::Scalar) {
+    // null nodes resolve like an empty scalar, everything else as a string
+    scalar = ResolveScalar("", 0);
+    if (type() != NodeType::Null)
+      scalar.type = ScalarType::String;
+    return scalar;
+  }
+
+  scalar = ResolveScalar(m_scalar.value.data(), m_scalar.value.size());
+
+  // other threads that resolve it at the same time keep their own result
+  unsigned char unresolved = 0;
+  if (!m_resolvedType.compare_exchange_strong(unresolved, kResolving,
+                                              std::memory_order_relaxed))
+    return scalar;
+  std::memcpy(&m_scalar.resolvedValue, &scalar.magnitude,
+              sizeof(m_scalar.resolvedValue));
+  m_resolvedType.store(
+      static_cast<unsigned char>((static_cast<unsigned char>(scalar.type) + 1) |
+                                 (scalar.negative ? kResolvedNegative : 0)),
+      std::memory_order_release);
+  return scalar;
 }
 
 // size/iterator
@@ -92,106 +188,108 @@ std::size_t node_data::size() const {
   if (!m_isDefined)
     return 0;
 
+  if (m_isFrozen)
+    return m_frozen.pData->nodes[m_frozen.index].count;
+
   switch (m_type) {
     case NodeType::Sequence:
-      compute_seq_size();
-      return m_seqSize;
+      return compute_seq_size();
     case NodeType::Map:
-      compute_map_size();
-      return m_map.size() - m_undefinedPairs.size();
+      return m_map.entries.size() - m_map.undefinedPairs;
     default:
       return 0;
   }
   return 0;
 }
 
-void node_data::compute_seq_size() const {
-  while (m_seqSize < m_sequence.size() && m_sequence[m_seqSize]->is_defined())
-    m_seqSize++;
-}
-
-void node_data::compute_map_size() const {
-  auto it = m_undefinedPairs.begin();
-  while (it != m_undefinedPairs.end()) {
-    auto jt = std::next(it);
-    if (it->first->is_defined() && it->second->is_defined())
-      m_undefinedPairs.erase(it);
-    it = jt;
-  }
+// Threads that count at the same time store the same size, see
+// sequence_payload.
+std::size_t node_data::compute_seq_size() const {
+  const std::size_t cached = m_sequence.size.load(std::memory_order_relaxed);
+  std::size_t size = cached;
+  while (size < m_sequence.nodes.size() && m_sequence.nodes[size]->is_defined())
+    size++;
+  if (size != cached)
+    m_sequence.size.store(size, std::memory_order_relaxed);
+  return size;
 }
 
 const_node_iterator node_data::begin() const {
-  if (!m_isDefined)
+  // frozen elements must be thawed before iterating, see thaw_elements()
+  if (!m_isDefined || m_isFrozen)
     return {};
 
   switch (m_type) {
     case NodeType::Sequence:
-      return const_node_iterator(m_sequence.begin());
+      return const_node_iterator(m_sequence.nodes.begin());
     case NodeType::Map:
-      return const_node_iterator(m_map.begin(), m_map.end());
+      return const_node_iterator(m_map.entries.begin(), m_map.entries.end(),
+                                 m_map.undefinedPairs > 0);
     default:
       return {};
   }
 }
 
 node_iterator node_data::begin() {
-  if (!m_isDefined)
+  if (!m_isDefined || m_isFrozen)
     return {};
 
   switch (m_type) {
     case NodeType::Sequence:
-      return node_iterator(m_sequence.begin());
+      return node_iterator(m_sequence.nodes.begin());
     case NodeType::Map:
-      return node_iterator(m_map.begin(), m_map.end());
+      return node_iterator(m_map.entries.begin(), m_map.entries.end(),
+                           m_map.undefinedPairs > 0);
     default:
       return {};
   }
 }
 
 const_node_iterator node_data::end() const {
-  if (!m_isDefined)
+  if (!m_isDefined || m_isFrozen)
     return {};
 
   switch (m_type) {
     case NodeType::Sequence:
-      return const_node_iterator(m_sequence.end());
+      return const_node_iterator(m_sequence.nodes.end());
     case NodeType::Map:
-      return const_node_iterator(m_map.end(), m_map.end());
+      return const_node_iterator(m_map.entries.end(), m_map.entries.end());
     default:
       return {};
   }
 }
 
 node_iterator node_data::end() {
-  if (!m_isDefined)
+  if (!m_isDefined || m_isFrozen)
     return {};
 
   switch (m_type) {
     case NodeType::Sequence:
-      return node_iterator(m_sequence.end());
+      return node_iterator(m_sequence.nodes.end());
     case NodeType::Map:
-      return node_iterator(m_map.end(), m_map.end());
+      return node_iterator(m_map.entries.end(), m_map.entries.end());
     default:
       return {};
   }
 }
 
 // sequence
-void node_data::push_back(node& node,
-                          const shared_memory_holder& /* pMemory */) {
-  if (m_type == NodeType::Undefined || m_type == NodeType::Null) {
-    m_type = NodeType::Sequence;
-    reset_sequence();
-  }
+void node_data::push_back(node& node, const shared_memory_holder& pMemory) {
+  thaw_elements(pMemory);
+  if (m_type == NodeType::Undefined || m_type == NodeType::Null)
+    reset_payload(NodeType::Sequence);
 
-  if (m_type != NodeType::Sequence)
-    throw BadPushback();
+  if (m_type != NodeType::Sequence) {
+    detail::raise(BadPushback());
+    return;
+  }
 
-  m_sequence.push_back(&node);
+  m_sequence.nodes.push_back(&node);
 }
 
 void node_data::insert(node& key, node& value,
                        const shared_memory_holder& pMemory) {
+  thaw_elements(pMemory);
   switch (m_type) {
     case NodeType::Map:
       break;
@@ -201,20 +299,21 @@ void node_data::insert(node& key, node& value,
       convert_to_map(pMemory);
       break;
     case NodeType::Scalar:
-      throw BadSubscript(m_mark, key);
+      detail::raise(BadSubscript(m_mark, key));
+      return;
   }
 
   insert_map_pair(key, value);
 }
 
 // indexing
-node* node_data::get(node& key,
-                     const shared_memory_holder& /* pMemory */) const {
+node* node_data::get(node& key, const shared_memory_holder& pMemory) const {
+  thaw_elements(pMemory);
   if (m_type != NodeType::Map) {
     return nullptr;
   }
 
-  for (const auto& it : m_map) {
+  for (const auto& it : m_map.entries) {
     if (it.first->is(key))
       return it.second;
   }
@@ -223,6 +322,7 @@ node* node_data::get(node& key,
 }
 
 node& node_data::get(node& key, const shared_memory_holder& pMemory) {
+  thaw_elements(pMemory);
   switch (m_type) {
     case NodeType::Map:
       break;
@@ -232,10 +332,12 @@ node& node_data::get(node& key, const shared_memory_holder& pMemory) {
       convert_to_map(pMemory);
       break;
     case NodeType::Scalar:
-      throw BadSubscript(m_mark, key);
+      detail::raise(BadSubscript(m_mark, key));
+      // a node outside of the document, so changes to it go nowhere
+      return pMemory->create_node();
   }
 
-  for (const auto& it : m_map) {
+  for (const auto& it : m_map.entries) {
     if (it.first->is(key))
       return *it.second;
   }
@@ -245,54 +347,499 @@ node& node_data::get(node& key, const shared_memory_holder& pMemory) {
   return value;
 }
 
-bool node_data::remove(node& key, const shared_memory_holder& /* pMemory */) {
+bool node_data::remove(node& key, const shared_memory_holder& pMemory) {
+  thaw_elements(pMemory);
   if (m_type != NodeType::Map)
     return false;
 
-  for (auto it = m_undefinedPairs.begin(); it != m_undefinedPairs.end();) {
-    auto jt = std::next(it);
-    if (it->first->is(key))
-      m_undefinedPairs.erase(it);
-    it = jt;
-  }
-
   auto it =
-      std::find_if(m_map.begin(), m_map.end(),
+      std::find_if(m_map.entries.begin(), m_map.entries.end(),
                    [&](std::pair<YAML::detail::node*, YAML::detail::node*> j) {
                      return (j.first->is(key));
                    });
 
-  if (it != m_map.end()) {
-    m_map.erase(it);
+  if (it != m_map.entries.end()) {
+    erase_map_pair(it - m_map.entries.begin());
     return true;
   }
 
   return false;
 }
 
-void node_data::reset_sequence() {
-  m_sequence.clear();
-  m_seqSize = 0;
+void node_data::reset_payload(NodeType type) {
+  drop_key_indexes();
+  if (!m_isFrozen && m_type == NodeType::Map && m_map.undefinedPairs > 0) {
+    for (const auto& it : m_map.entries)
+      release_undefined_pair(*it.first, *it.second);
+  }
+  destroy_payload();
+
+  switch (type) {
+    case NodeType::Scalar:
+      new (&m_scalar) scalar_payload{std::string{}, 0};
+      m_resolvedType.store(0, std::memory_order_relaxed);
+      break;
+    case NodeType::Sequence:
+      new (&m_sequence) sequence_payload{node_seq{}, {0}};
+      break;
+    case NodeType::Map:
+      new (&m_map) map_payload{node_map{}, 0, nullptr};
+      break;
+    case NodeType::Undefined:
+    case NodeType::Null:
+      break;
+  }
+  m_type = type;
+}
+
+void node_data::destroy_payload() {
+  if (m_isFrozen) {
+    m_isFrozen = false;
+    m_type = NodeType::Null;
+    return;
+  }
+
+  switch (m_type) {
+    case NodeType::Scalar:
+      m_scalar.~scalar_payload();
+      break;
+    case NodeType::Sequence:
+      m_sequence.~sequence_payload();
+      break;
+    case NodeType::Map:
+      m_map.~map_payload();
+      break;
+    case NodeType::Undefined:
+    case NodeType::Null:
+      break;
+  }
+  m_type = NodeType::Null;
+}
+
+std::size_t node_data::scalar_heap_size() const {
+  if (m_isFrozen || m_type != NodeType::Scalar)
+    return 0;
+  return string_heap_size(m_scalar.value);
+}
+
+std::size_t node_data::container_heap_size() const {
+  if (m_isFrozen)
+    return 0;
+  switch (m_type) {
+    case NodeType::Sequence:
+      return m_sequence.nodes.capacity() * sizeof(node*);
+    case NodeType::Map: {
+      std::size_t size = m_map.entries.capacity() * sizeof(kv_pair);
+      if (m_map.pKeyIndex) {
+        size += sizeof(key_index) +
+                m_map.pKeyIndex->slots.capacity() * sizeof(key_slot);
+      }
+      return size;
+    }
+    default:
+      return 0;
+  }
 }
 
-void node_data::reset_map() {
-  m_map.clear();
-  m_undefinedPairs.clear();
+std::size_t node_data::tag_heap_size() const {
+  return m_pSide ? string_heap_size(m_pSide->tag) : 0;
+}
+
+std::size_t node_data::side_heap_size() const {
+  if (!m_pSide)
+    return 0;
+  return sizeof(side_storage) +
+         m_pSide->waitingPairs.capacity() * sizeof(undefined_pair) +
+         m_pSide->indexingMaps.capacity() * sizeof(node_data*) +
+         m_pSide->holdingMaps.capacity() * sizeof(node_data*);
+}
+
+void node_data::thaw(const frozen_data& data, std::uint32_t index) {
+  const frozen_record& record = data.nodes[index];
+  m_mark = record.mark;
+  m_style = record.style;
+  set_tag(data.tags[record.tag]);
+
+  switch (record.type) {
+    case NodeType::Undefined:
+      set_type(NodeType::Undefined);
+      break;
+    case NodeType::Null:
+      set_null();
+      break;
+    case NodeType::Scalar:
+      set_defined();
+      drop_key_indexes();
+      if (m_type != NodeType::Scalar)
+        reset_payload(NodeType::Scalar);
+      m_scalar.value.assign(data.scalar(record), record.count);
+      m_resolvedType.store(0, std::memory_order_relaxed);
+      break;
+    case NodeType::Sequence:
+    case NodeType::Map:
+      set_defined();
+      reset_payload(NodeType::Null);
+      new (&m_frozen) frozen_payload{&data, index};
+      m_type = record.type;
+      m_isFrozen = true;
+      break;
+  }
+}
+
+// Like the cached sequence size, the elements are filled in on const access.
+void node_data::thaw_elements(const shared_memory_holder& pMemory) const {
+  if (!m_isFrozen)
+    return;
+
+  node_data& self = const_cast<node_data&>(*this);
+  const frozen_data& data = *m_frozen.pData;
+  const frozen_record& record = data.nodes[m_frozen.index];
+  const std::uint32_t* children = data.children.data() + record.first;
+
+  self.m_isFrozen = false;
+  if (record.type == NodeType::Sequence) {
+    new (&self.m_sequence) sequence_payload{node_seq{}, {0}};
+    self.m_sequence.nodes.reserve(record.count);
+    for (std::uint32_t i = 0; i < record.count; i++) {
+      node& element = pMemory->create_node();
+      element.data().thaw(data, children[i]);
+      self.m_sequence.nodes.push_back(&element);
+    }
+  } else {
+    new (&self.m_map)
+        map_payload{node_map{}, 0, nullptr};
+    self.m_map.entries.reserve(record.count);
+    for (std::uint32_t i = 0; i < record.count; i++) {
+      node& key = pMemory->create_node();
+      key.data().thaw(data, children[2 * i]);
+      node& value = pMemory->create_node();
+      value.data().thaw(data, children[2 * i + 1]);
+      self.m_map.entries.emplace_back(&key, &value);
+      key.data().add_holding_map(self);
+      value.data().add_holding_map(self);
+    }
+    if (record.count >= kKeyIndexThreshold)
+      self.build_key_index();
+  }
+}
+
+bool node_data::share_frozen_elements(const node_data& rhs) {
+  if (!rhs.m_isFrozen)
+    return false;
+
+  set_defined();
+  reset_payload(NodeType::Null);
+  new (&m_frozen) frozen_payload(rhs.m_frozen);
+  m_type = rhs.m_type;
+  m_isFrozen = true;
+  return true;
+}
+
+node_data::side_storage& node_data::side() {
+  if (!m_pSide)
+    m_pSide.reset(new side_storage);
+  return *m_pSide;
 }
 
 void node_data::insert_map_pair(node& key, node& value) {
-  m_map.emplace_back(&key, &value);
+  m_map.entries.emplace_back(&key, &value);
+  key.data().add_holding_map(*this);
+  value.data().add_holding_map(*this);
+  track_undefined_pair(key, value);
+
+  // built as soon as the map is large enough, so that loaded maps have
+  // their index before the first lookup, which may be a const one
+  if (m_map.pKeyIndex) {
+    index_key(m_map.entries.size() - 1);
+  } else if (m_map.entries.size() >= kKeyIndexThreshold) {
+    build_key_index();
+  }
+}
+
+void node_data::erase_map_pair(std::size_t index) {
+  release_undefined_pair(*m_map.entries[index].first,
+                         *m_map.entries[index].second);
+  m_map.entries.erase(m_map.entries.begin() + index);
+
+  if (m_map.pKeyIndex)
+    unindex_key(index);
+}
+
+void node_data::track_undefined_pair(node& key, node& value) {
+  if (key.is_defined() && value.is_defined())
+    return;
+
+  m_map.undefinedPairs++;
+  if (!key.is_defined())
+    key.data().add_undefined_pair(*this, key, value);
+  if (!value.is_defined() && &value != &key)
+    value.data().add_undefined_pair(*this, value, key);
+}
+
+void node_data::release_undefined_pair(node& key, node& value) {
+  if (key.is_defined() && value.is_defined())
+    return;
+
+  m_map.undefinedPairs--;
+  if (!key.is_defined())
+    key.data().remove_undefined_pair(*this, key, value);
+  if (!value.is_defined() && &value != &key)
+    value.data().remove_undefined_pair(*this, value, key);
+}
+
+void node_data::add_undefined_pair(node_data& map, node& self, node& other) {
+  side().waitingPairs.push_back({&map, &self, &other});
+}
+
+void node_data::remove_undefined_pair(const node_data& map, const node& self,
+                                      const node& other) {
+  if (!m_pSide)
+    return;
+
+  std::vector<undefined_pair>& waiting = m_pSide->waitingPairs;
+  auto it = std::find_if(waiting.begin(), waiting.end(),
+                         [&](const undefined_pair& pair) {
+                           return pair.map == &map && pair.self == &self &&
+                                  pair.other == &other;
+                         });
+  if (it != waiting.end())
+    waiting.erase(it);
+}
+
+void node_data::update_undefined_pairs(node_data& replacement) {
+  if (&replacement == this)
+    return;
+
+  // After node::set_ref or node::set_data, some of the waiting entries may
+  // refer to a different node_data; they now wait for that one instead.
+  if (m_pSide && !m_pSide->waitingPairs.empty()) {
+    std::vector<undefined_pair> waiting;
+    waiting.swap(m_pSide->waitingPairs);
+    for (const undefined_pair& pair : waiting) {
+      node_data& data = pair.self->data();
+      if (!data.is_defined())
+        data.side().waitingPairs.push_back(pair);
+      else if (pair.other->is_defined() &&
+               !(&pair.other->data() == &data && pair.other < pair.self))
+        pair.map->m_map.undefinedPairs--;
+    }
+  }
 
-  if (!key.is_defined() || !value.is_defined())
-    m_undefinedPairs.emplace_back(&key, &value);
+  // Which of the nodes that referred to this data moved is not known, so
+  // every map that holds this data now holds the replacement as well. A map
+  // with an entry that turned undefined has not counted it; since the
+  // entries of other maps may still be defined, each map counts again.
+  const bool turnedUndefined = m_isDefined && !replacement.m_isDefined;
+  auto hand_over = [&](node_data& map) {
+    replacement.add_holding_map(map);
+    if (turnedUndefined && !map.m_isFrozen && map.m_type == NodeType::Map)
+      map.count_undefined_pairs();
+  };
+  if (m_pHoldingMap)
+    hand_over(*m_pHoldingMap);
+  if (m_pSide) {
+    for (node_data* pMap : m_pSide->holdingMaps)
+      hand_over(*pMap);
+  }
+}
+
+// The entries are tracked from scratch, as insert_map_pair() does, so first
+// the records of the ones already tracked are dropped; they are all held by
+// data that is not defined.
+void node_data::count_undefined_pairs() {
+  auto drop_records = [this](const node& element) {
+    node_data& data = element.data();
+    if (data.m_isDefined || !data.m_pSide)
+      return;
+    std::vector<undefined_pair>& waiting = data.m_pSide->waitingPairs;
+    waiting.erase(std::remove_if(waiting.begin(), waiting.end(),
+                                 [this](const undefined_pair& pair) {
+                                   return pair.map == this;
+                                 }),
+                  waiting.end());
+  };
+  for (const kv_pair& pair : m_map.entries) {
+    drop_records(*pair.first);
+    drop_records(*pair.second);
+  }
+
+  m_map.undefinedPairs = 0;
+  for (const kv_pair& pair : m_map.entries)
+    track_undefined_pair(*pair.first, *pair.second);
+}
+
+// The maps may have dropped their index since, or may not even be maps any
+// more; either way they have no index to drop. The next index built hashes
+// the data again and registers with it.
+void node_data::drop_key_indexes() {
+  if (m_pIndexingMap) {
+    m_pIndexingMap->drop_key_index();
+    m_pIndexingMap = nullptr;
+  }
+  if (m_pSide && !m_pSide->indexingMaps.empty()) {
+    for (node_data* pMap : m_pSide->indexingMaps)
+      pMap->drop_key_index();
+    m_pSide->indexingMaps.clear();
+  }
+}
+
+void node_data::drop_key_index() {
+  if (!m_isFrozen && m_type == NodeType::Map)
+    m_map.pKeyIndex.reset();
+}
+
+// A key is rarely shared between maps, so only the first map is kept inline.
+void node_data::add_indexing_map(node_data& map) {
+  if (!m_pIndexingMap || m_pIndexingMap == &map) {
+    m_pIndexingMap = &map;
+    return;
+  }
+
+  std::vector<node_data*>& maps = side().indexingMaps;
+  if (std::find(maps.begin(), maps.end(), &map) == maps.end())
+    maps.push_back(&map);
+}
+
+// Maps usually hold a node once, so the first map is kept inline. A node
+// assigned to many entries of one map registers it once, since the entries
+// are mostly added in a row.
+void node_data::add_holding_map(node_data& map) {
+  if (!m_pHoldingMap || m_pHoldingMap == &map) {
+    m_pHoldingMap = &map;
+    return;
+  }
+
+  std::vector<node_data*>& maps = side().holdingMaps;
+  if (maps.empty() || maps.back() != &map)
+    maps.push_back(&map);
+}
+
+node* node_data::find_string_key(const char* key, std::size_t size) {
+  const std::size_t position = find_string_key_position(key, size);
+  return position < m_map.entries.size() ? m_map.entries[position].second
+                                         : nullptr;
+}
+
+node* node_data::lookup_string_key(const char* key, std::size_t size) const {
+  const std::size_t position = lookup_string_key_position(key, size);
+  return position < m_map.entries.size() ? m_map.entries[position].second
+                                         : nullptr;
+}
+
+// Rebuilds the index that a changed key dropped, see insert_map_pair().
+std::size_t node_data::find_string_key_position(const char* key,
+                                                std::size_t size) {
+  if (!m_map.pKeyIndex && m_map.entries.size() >= kKeyIndexThreshold)
+    build_key_index();
+  return lookup_string_key_position(key, size);
+}
+
+// Only reads, so a map without an index, which only the paths that change
+// the map build, is searched linearly.
+std::size_t node_data::lookup_string_key_position(const char* key,
+                                                  std::size_t size) const {
+  if (!m_map.pKeyIndex) {
+    for (std::size_t i = 0; i < m_map.entries.size(); i++) {
+      if (is_string_key(*m_map.entries[i].first, key, size))
+        return i;
+    }
+    return m_map.entries.size();
+  }
+
+  // with duplicate keys (see force_insert) the first one wins, as it does
+  // for the linear search
+  std::size_t found = m_map.entries.size();
+  const std::size_t hash = hash_key(key, size);
+  const std::vector<key_slot>& slots = m_map.pKeyIndex->slots;
+  const std::size_t mask = slots.size() - 1;
+  for (std::size_t i = hash & mask; slots[i].position != 0;
+       i = (i + 1) & mask) {
+    const std::size_t position = slots[i].position - 1;
+    if (slots[i].hash == hash && position < found &&
+        is_string_key(*m_map.entries[position].first, key, size))
+      found = position;
+  }
+  return found;
+}
+
+void node_data::build_key_index() {
+  std::size_t slots = 2 * kKeyIndexThreshold;
+  while (slots < 2 * m_map.entries.size())
+    slots *= 2;
+  m_map.pKeyIndex.reset(new key_index{0, std::vector<key_slot>(slots)});
+  for (std::size_t i = 0; i < m_map.entries.size(); i++)
+    index_key(i);
+}
+
+// Keys that are not scalars yet may become one, so they register with the
+// map too, see drop_key_indexes().
+void node_data::index_key(std::size_t position) {
+  const node& key = *m_map.entries[position].first;
+  key.data().add_indexing_map(*this);
+  if (key.type() != NodeType::Scalar)
+    return;
+
+  key_index& index = *m_map.pKeyIndex;
+  if (2 * (index.size + 1) > index.slots.size()) {
+    std::vector<key_slot> slots(2 * index.slots.size());
+    const std::size_t mask = slots.size() - 1;
+    for (const key_slot& slot : index.slots) {
+      if (slot.position == 0)
+        continue;
+      std::size_t i = slot.hash & mask;
+      while (slots[i].position != 0)
+        i = (i + 1) & mask;
+      slots[i] = slot;
+    }
+    index.slots.swap(slots);
+  }
+
+  const std::string& scalar = key.scalar();
+  const std::size_t hash = hash_key(scalar.data(), scalar.size());
+  const std::size_t mask = index.slots.size() - 1;
+  std::size_t i = hash & mask;
+  while (index.slots[i].position != 0)
+    i = (i + 1) & mask;
+  index.slots[i] = key_slot{hash, position + 1};
+  index.size++;
+}
+
+// The entries keep their order, so the ones after the erased entry move up
+// by one, and the index follows them instead of being rebuilt. The freed
+// slot is refilled from the rest of its probe run, so that lookups, which
+// stop at the first free slot, still reach every key.
+void node_data::unindex_key(std::size_t position) {
+  key_index& index = *m_map.pKeyIndex;
+  std::vector<key_slot>& slots = index.slots;
+  std::size_t freed = slots.size();
+  for (std::size_t i = 0; i < slots.size(); i++) {
+    if (slots[i].position == position + 1)
+      freed = i;
+    else if (slots[i].position > position + 1)
+      slots[i].position--;
+  }
+  if (freed == slots.size())
+    return;
+
+  const std::size_t mask = slots.size() - 1;
+  for (std::size_t i = (freed + 1) & mask; slots[i].position != 0;
+       i = (i + 1) & mask) {
+    // a slot may move back to the freed one unless its home lies after it
+    const std::size_t home = slots[i].hash & mask;
+    if (((i - home) & mask) >= ((i - freed) & mask)) {
+      slots[freed] = slots[i];
+      freed = i;
+    }
+  }
+  slots[freed] = key_slot{0, 0};
+  index.size--;
 }
 
 void node_data::convert_to_map(const shared_memory_holder& pMemory) {
   switch (m_type) {
     case NodeType::Undefined:
     case NodeType::Null:
-      reset_map();
-      m_type = NodeType::Map;
+      reset_payload(NodeType::Map);
       break;
     case NodeType::Sequence:
       convert_sequence_to_map(pMemory);
@@ -308,18 +855,18 @@ void node_data::convert_to_map(const shared_memory_holder& pMemory) {
 void node_data::convert_sequence_to_map(const shared_memory_holder& pMemory) {
   assert(m_type == NodeType::Sequence);
 
-  reset_map();
-  for (std::size_t i = 0; i < m_sequence.size(); i++) {
+  node_seq sequence;
+  sequence.swap(m_sequence.nodes);
+  reset_payload(NodeType::Map);
+
+  for (std::size_t i = 0; i < sequence.size(); i++) {
     std::stringstream stream;
     stream << i;
 
     node& key = pMemory->create_node();
     key.set_scalar(stream.str());
-    insert_map_pair(key, *m_sequence[i]);
+    insert_map_pair(key, *sequence[i]);
   }
-
-  reset_sequence();
-  m_type = NodeType::Map;
 }
 }  // namespace detail
 }  // namespace YAML
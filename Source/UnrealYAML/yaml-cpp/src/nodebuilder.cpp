@@ -26,6 +26,8 @@ Node NodeBuilder::Root() {
   if (!m_pRoot)
     return Node();
 
+  // the document is complete, see SetDocumentTracking()
+  m_pMemory->list();
   return Node(*m_pRoot, m_pMemory);
 }
 
@@ -26,11 +26,10 @@ NodeEvents::NodeEvents(const Node& node)
 }
 
 void NodeEvents::Setup(const detail::node& node) {
-  int& refCount = m_refCount[node.ref()];
-  refCount++;
-  if (refCount > 1)
+  if (!m_refCount.add(node.ref()))
     return;
 
+  node.thaw_elements(m_pMemory);
   if (node.type() == NodeType::Sequence) {
     for (auto element : node)
       Setup(*element);
@@ -92,7 +91,47 @@ void NodeEvents::Emit(const detail::node& node, EventHandler& handler,
 }
 
 bool NodeEvents::IsAliased(const detail::node& node) const {
-  auto it = m_refCount.find(node.ref());
-  return it != m_refCount.end() && it->second > 1;
+  return m_refCount.aliased(node.ref());
+}
+
+// Linear probing in a table that is at most 3/4 full; the slot holds the
+// pointer, which is aligned, with its low bit as the "aliased" flag.
+bool NodeEvents::RefCount::add(const detail::node_ref* ref) {
+  if (4 * (m_size + 1) > 3 * m_slots.size())
+    grow();
+
+  const std::uintptr_t key = reinterpret_cast<std::uintptr_t>(ref);
+  std::uintptr_t& slot = m_slots[find(key)];
+  if (slot != 0) {
+    slot |= 1;
+    return false;
+  }
+  slot = key;
+  m_size++;
+  return true;
+}
+
+bool NodeEvents::RefCount::aliased(const detail::node_ref* ref) const {
+  if (m_slots.empty())
+    return false;
+  return (m_slots[find(reinterpret_cast<std::uintptr_t>(ref))] & 1) != 0;
+}
+
+std::size_t NodeEvents::RefCount::find(std::uintptr_t key) const {
+  const std::size_t mask = m_slots.size() - 1;
+  std::size_t index =
+      static_cast<std::size_t>((key >> 3) * 0x9E3779B97F4A7C15ull) & mask;
+  while (m_slots[index] != 0 && (m_slots[index] & ~std::uintptr_t(1)) != key)
+    index = (index + 1) & mask;
+  return index;
+}
+
+void NodeEvents::RefCount::grow() {
+  std::vector<std::uintptr_t> slots(m_slots.empty() ? 64 : 2 * m_slots.size());
+  slots.swap(m_slots);
+  for (std::uintptr_t slot : slots) {
+    if (slot != 0)
+      m_slots[find(slot & ~std::uintptr_t(1))] = slot;
+  }
 }
 }  // namespace YAML
@@ -7,10 +7,13 @@
 #pragma once
 #endif
 
+#include <cstddef>
+#include <cstdint>
 #include <map>
 #include <vector>
 
 #include "anchor.h"
+#include "node/detail/memory.h"
 #include "node/ptr.h"
 
 namespace YAML {
@@ -60,7 +63,25 @@ class NodeEvents {
   detail::shared_memory_holder m_pMemory;
   detail::node* m_root;
 
-  using RefCount = std::map<const detail::node_ref*, int>;
+  // The node_refs that were reached, with the low bit set on those that
+  // were reached more than once. It holds every node of the document, so it
+  // is a flat hash table of one pointer per slot rather than a map.
+  class RefCount {
+   public:
+    RefCount() : m_slots{}, m_size(0) {}
+
+    // true if the ref was not reached before
+    bool add(const detail::node_ref* ref);
+    bool aliased(const detail::node_ref* ref) const;
+
+   private:
+    std::size_t find(std::uintptr_t key) const;
+    void grow();
+
+   private:
+    std::vector<std::uintptr_t> m_slots;
+    std::size_t m_size;
+  };
   RefCount m_refCount;
 };
 }  // namespace YAML
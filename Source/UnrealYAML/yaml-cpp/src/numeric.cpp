@@ -0,0 +1,1158 @@
+#include "numeric.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <locale>
+#include <sstream>
+#include <string>
+
+// Floating point numbers are parsed and written with the algorithms of the
+// double-conversion library: values with few digits are parsed exactly with
+// a single floating point operation, the others with 64-bit approximations
+// of powers of ten whose error is tracked (Strtod), and written with Grisu3.
+// Both detect the rare cases they cannot decide, which then go through the
+// standard library in the classic locale.
+
+namespace YAML {
+namespace {
+bool IsDigit(char ch) { return '0' <= ch && ch <= '9'; }
+
+int DigitValue(char ch, int base) {
+  int digit;
+  if ('0' <= ch && ch <= '9')
+    digit = ch - '0';
+  else if ('a' <= ch && ch <= 'f')
+    digit = ch - 'a' + 10;
+  else if ('A' <= ch && ch <= 'F')
+    digit = ch - 'A' + 10;
+  else
+    return -1;
+  return digit < base ? digit : -1;
+}
+
+// Eight decimal digits at once, as one 64-bit word: the digits are checked
+// and combined with a few multiplications instead of one step per digit.
+std::uint64_t LoadEightDigits(const char* p) {
+  std::uint64_t chunk = 0;
+  for (int i = 0; i < 8; i++)
+    chunk |= std::uint64_t(static_cast<unsigned char>(p[i])) << (8 * i);
+  return chunk;
+}
+
+bool AreEightDigits(std::uint64_t chunk) {
+  return (chunk & 0xF0F0F0F0F0F0F0F0) == 0x3030303030303030 &&
+         ((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) ==
+             0x3030303030303030;
+}
+
+std::uint32_t EightDigitsValue(std::uint64_t chunk) {
+  chunk -= 0x3030303030303030;
+  chunk = (chunk * 10 + (chunk >> 8)) & 0x00FF00FF00FF00FF;
+  chunk = ((chunk & 0x000000FF000000FF) * (100 + (1000000ULL << 32)) +
+           ((chunk >> 16) & 0x000000FF000000FF) * (1 + (10000ULL << 32))) >>
+          32;
+  return static_cast<std::uint32_t>(chunk);
+}
+
+const char* SkipDigits(const char* p, const char* end) {
+  while (end - p >= 8 && AreEightDigits(LoadEightDigits(p)))
+    p += 8;
+  while (p != end && IsDigit(*p))
+    p++;
+  return p;
+}
+
+enum class integer_text { Invalid, Valid, Overflow };
+
+// Reads an integer in any of its forms; only decimals may have a sign.
+integer_text ReadInteger(const char* p, const char* end, bool& negative,
+                         std::uint64_t& magnitude, int& base) {
+  negative = false;
+  magnitude = 0;
+  base = 10;
+  if (p != end && (*p == '-' || *p == '+')) {
+    negative = *p == '-';
+    p++;
+  } else if (end - p > 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'o')) {
+    base = p[1] == 'x' ? 16 : 8;
+    p += 2;
+  }
+  if (p == end)
+    return integer_text::Invalid;
+
+  // magnitude * base + digit overflows past these
+  const std::uint64_t max = std::numeric_limits<std::uint64_t>::max();
+  const std::uint64_t maxMultiple = max / base;
+  const int maxLastDigit = static_cast<int>(max % base);
+  bool overflow = false;
+  if (base == 10) {
+    // below 10^11, eight more digits still fit
+    while (end - p >= 8 && magnitude < 100000000000ULL) {
+      const std::uint64_t chunk = LoadEightDigits(p);
+      if (!AreEightDigits(chunk))
+        break;
+      magnitude = magnitude * 100000000 + EightDigitsValue(chunk);
+      p += 8;
+    }
+  }
+  for (; p != end; ++p) {
+    const int digit = DigitValue(*p, base);
+    if (digit < 0)
+      return integer_text::Invalid;
+    if (magnitude > maxMultiple ||
+        (magnitude == maxMultiple && digit > maxLastDigit))
+      overflow = true;
+    else
+      magnitude = magnitude * base + digit;
+  }
+  return overflow ? integer_text::Overflow : integer_text::Valid;
+}
+
+// [-+].inf and .nan
+template <typename T>
+bool ReadSpecial(const char* p, const char* end, T& value) {
+  bool negative = false;
+  const bool hasSign = p != end && (*p == '-' || *p == '+');
+  if (hasSign)
+    negative = *p++ == '-';
+  if (end - p != 4 || p[0] != '.')
+    return false;
+
+  auto is = [p](const char* name) { return std::memcmp(p + 1, name, 3) == 0; };
+  if (is("inf") || is("Inf") || is("INF")) {
+    value = negative ? -std::numeric_limits<T>::infinity()
+                     : std::numeric_limits<T>::infinity();
+    return true;
+  }
+  if (!hasSign && (is("nan") || is("NaN") || is("NAN"))) {
+    value = std::numeric_limits<T>::quiet_NaN();
+    return true;
+  }
+  return false;
+}
+
+template <typename T>
+bool ReadWithStream(const char* begin, const char* end, T& value) {
+  std::istringstream stream(std::string(begin, end));
+  stream.imbue(std::locale::classic());
+  stream >> value;
+  return !stream.fail();
+}
+
+// A decimal as its significant digits, without leading and trailing zeros,
+// and the power of ten they are multiplied with.
+struct decimal {
+  bool negative;
+  // the first digits, as many as fit into 64 bits
+  std::uint64_t significand;
+  int readDigits;
+  // the digit after them, and the number of all digits
+  char nextDigit;
+  int digits;
+  int exponent;
+};
+
+bool ReadDecimal(const char* p, const char* end, decimal& result) {
+  result.negative = false;
+  if (p != end && (*p == '-' || *p == '+'))
+    result.negative = *p++ == '-';
+
+  const char* const intBegin = p;
+  p = SkipDigits(p, end);
+  const char* const intEnd = p;
+  const char* fracBegin = p;
+  if (p != end && *p == '.') {
+    fracBegin = ++p;
+    p = SkipDigits(p, end);
+  }
+  const char* const fracEnd = p;
+  if (intBegin == intEnd && fracBegin == fracEnd)
+    return false;
+
+  // large exponents only need to stay large
+  int exponent = 0;
+  if (p != end && (*p == 'e' || *p == 'E')) {
+    p++;
+    bool negativeExponent = false;
+    if (p != end && (*p == '-' || *p == '+'))
+      negativeExponent = *p++ == '-';
+    if (p == end || !IsDigit(*p))
+      return false;
+    for (; p != end && IsDigit(*p); ++p) {
+      if (exponent < 100000)
+        exponent = exponent * 10 + (*p - '0');
+    }
+    if (negativeExponent)
+      exponent = -exponent;
+  }
+  if (p != end)
+    return false;
+
+  // the digits of both parts, seen as one integer
+  const int intDigits = static_cast<int>(intEnd - intBegin);
+  const int allDigits = intDigits + static_cast<int>(fracEnd - fracBegin);
+  auto digitAt = [&](int index) {
+    return index < intDigits ? intBegin[index] : fracBegin[index - intDigits];
+  };
+  int first = 0;
+  while (first < allDigits && digitAt(first) == '0')
+    first++;
+  int last = allDigits;
+  while (last > first && digitAt(last - 1) == '0')
+    last--;
+
+  result.digits = last - first;
+  result.exponent =
+      exponent - static_cast<int>(fracEnd - fracBegin) + (allDigits - last);
+  result.significand = 0;
+  result.readDigits = 0;
+  const std::uint64_t max = std::numeric_limits<std::uint64_t>::max();
+  auto read = [&](const char* q, const char* stop) {
+    // eight digits at a time while the significand stays below 10^19
+    for (; stop - q >= 8 && result.readDigits <= 11; q += 8) {
+      const std::uint64_t chunk = LoadEightDigits(q);
+      result.significand =
+          result.significand * 100000000 + EightDigitsValue(chunk);
+      result.readDigits += 8;
+    }
+    for (; q != stop && result.significand <= max / 10 - 1; ++q) {
+      result.significand = result.significand * 10 + (*q - '0');
+      result.readDigits++;
+    }
+    return q == stop;
+  };
+  // the significant digits [first, last), from the integer part on into the
+  // fraction part
+  const int intLast = std::min(last, intDigits);
+  bool readAll = true;
+  if (first < intLast)
+    readAll = read(intBegin + first, intBegin + intLast);
+  if (readAll && last > intDigits)
+    read(fracBegin + std::max(first - intDigits, 0),
+         fracBegin + (last - intDigits));
+  result.nextDigit = result.readDigits < result.digits
+                         ? digitAt(first + result.readDigits)
+                         : '0';
+  return true;
+}
+
+// A floating point number with a 64-bit significand.
+struct diy_fp {
+  std::uint64_t f;
+  int e;
+};
+
+const std::uint64_t kUint64Msb = 0x8000000000000000ull;
+
+// the upper 64 bits of the product, rounded
+diy_fp Multiply(diy_fp x, diy_fp y) {
+  const std::uint64_t kMask32 = 0xFFFFFFFFu;
+  const std::uint64_t a = x.f >> 32;
+  const std::uint64_t b = x.f & kMask32;
+  const std::uint64_t c = y.f >> 32;
+  const std::uint64_t d = y.f & kMask32;
+  const std::uint64_t ac = a * c;
+  const std::uint64_t bc = b * c;
+  const std::uint64_t ad = a * d;
+  const std::uint64_t bd = b * d;
+  std::uint64_t tmp = (bd >> 32) + (ad & kMask32) + (bc & kMask32);
+  tmp += 1u << 31;
+  return {ac + (ad >> 32) + (bc >> 32) + (tmp >> 32), x.e + y.e + 64};
+}
+
+diy_fp Normalize(diy_fp x) {
+  while (!(x.f & 0xFFC0000000000000ull)) {
+    x.f <<= 10;
+    x.e -= 10;
+  }
+  while (!(x.f & kUint64Msb)) {
+    x.f <<= 1;
+    x.e--;
+  }
+  return x;
+}
+
+struct cached_power {
+  std::uint64_t significand;
+  std::int16_t binaryExponent;
+  std::int16_t decimalExponent;
+};
+
+// 10^-348, 10^-340, ..., 10^340
+const cached_power kCachedPowers[] = {
+    {0xfa8fd5a0081c0288ull, -1220, -348},
+    {0xbaaee17fa23ebf76ull, -1193, -340},
+    {0x8b16fb203055ac76ull, -1166, -332},
+    {0xcf42894a5dce35eaull, -1140, -324},
+    {0x9a6bb0aa55653b2dull, -1113, -316},
+    {0xe61acf033d1a45dfull, -1087, -308},
+    {0xab70fe17c79ac6caull, -1060, -300},
+    {0xff77b1fcbebcdc4full, -1034, -292},
+    {0xbe5691ef416bd60cull, -1007, -284},
+    {0x8dd01fad907ffc3cull, -980, -276},
+    {0xd3515c2831559a83ull, -954, -268},
+    {0x9d71ac8fada6c9b5ull, -927, -260},
+    {0xea9c227723ee8bcbull, -901, -252},
+    {0xaecc49914078536dull, -874, -244},
+    {0x823c12795db6ce57ull, -847, -236},
+    {0xc21094364dfb5637ull, -821, -228},
+    {0x9096ea6f3848984full, -794, -220},
+    {0xd77485cb25823ac7ull, -768, -212},
+    {0xa086cfcd97bf97f4ull, -741, -204},
+    {0xef340a98172aace5ull, -715, -196},
+    {0xb23867fb2a35b28eull, -688, -188},
+    {0x84c8d4dfd2c63f3bull, -661, -180},
+    {0xc5dd44271ad3cdbaull, -635, -172},
+    {0x936b9fcebb25c996ull, -608, -164},
+    {0xdbac6c247d62a584ull, -582, -156},
+    {0xa3ab66580d5fdaf6ull, -555, -148},
+    {0xf3e2f893dec3f126ull, -529, -140},
+    {0xb5b5ada8aaff80b8ull, -502, -132},
+    {0x87625f056c7c4a8bull, -475, -124},
+    {0xc9bcff6034c13053ull, -449, -116},
+    {0x964e858c91ba2655ull, -422, -108},
+    {0xdff9772470297ebdull, -396, -100},
+    {0xa6dfbd9fb8e5b88full, -369, -92},
+    {0xf8a95fcf88747d94ull, -343, -84},
+    {0xb94470938fa89bcfull, -316, -76},
+    {0x8a08f0f8bf0f156bull, -289, -68},
+    {0xcdb02555653131b6ull, -263, -60},
+    {0x993fe2c6d07b7facull, -236, -52},
+    {0xe45c10c42a2b3b06ull, -210, -44},
+    {0xaa242499697392d3ull, -183, -36},
+    {0xfd87b5f28300ca0eull, -157, -28},
+    {0xbce5086492111aebull, -130, -20},
+    {0x8cbccc096f5088ccull, -103, -12},
+    {0xd1b71758e219652cull, -77, -4},
+    {0x9c40000000000000ull, -50, 4},
+    {0xe8d4a51000000000ull, -24, 12},
+    {0xad78ebc5ac620000ull, 3, 20},
+    {0x813f3978f8940984ull, 30, 28},
+    {0xc097ce7bc90715b3ull, 56, 36},
+    {0x8f7e32ce7bea5c70ull, 83, 44},
+    {0xd5d238a4abe98068ull, 109, 52},
+    {0x9f4f2726179a2245ull, 136, 60},
+    {0xed63a231d4c4fb27ull, 162, 68},
+    {0xb0de65388cc8ada8ull, 189, 76},
+    {0x83c7088e1aab65dbull, 216, 84},
+    {0xc45d1df942711d9aull, 242, 92},
+    {0x924d692ca61be758ull, 269, 100},
+    {0xda01ee641a708deaull, 295, 108},
+    {0xa26da3999aef774aull, 322, 116},
+    {0xf209787bb47d6b85ull, 348, 124},
+    {0xb454e4a179dd1877ull, 375, 132},
+    {0x865b86925b9bc5c2ull, 402, 140},
+    {0xc83553c5c8965d3dull, 428, 148},
+    {0x952ab45cfa97a0b3ull, 455, 156},
+    {0xde469fbd99a05fe3ull, 481, 164},
+    {0xa59bc234db398c25ull, 508, 172},
+    {0xf6c69a72a3989f5cull, 534, 180},
+    {0xb7dcbf5354e9beceull, 561, 188},
+    {0x88fcf317f22241e2ull, 588, 196},
+    {0xcc20ce9bd35c78a5ull, 614, 204},
+    {0x98165af37b2153dfull, 641, 212},
+    {0xe2a0b5dc971f303aull, 667, 220},
+    {0xa8d9d1535ce3b396ull, 694, 228},
+    {0xfb9b7cd9a4a7443cull, 720, 236},
+    {0xbb764c4ca7a44410ull, 747, 244},
+    {0x8bab8eefb6409c1aull, 774, 252},
+    {0xd01fef10a657842cull, 800, 260},
+    {0x9b10a4e5e9913129ull, 827, 268},
+    {0xe7109bfba19c0c9dull, 853, 276},
+    {0xac2820d9623bf429ull, 880, 284},
+    {0x80444b5e7aa7cf85ull, 907, 292},
+    {0xbf21e44003acdd2dull, 933, 300},
+    {0x8e679c2f5e44ff8full, 960, 308},
+    {0xd433179d9c8cb841ull, 986, 316},
+    {0x9e19db92b4e31ba9ull, 1013, 324},
+    {0xeb96bf6ebadf77d9ull, 1039, 332},
+    {0xaf87023b9bf0ee6bull, 1066, 340},
+};
+const int kCachedPowersOffset = 348;
+const int kDecimalExponentDistance = 8;
+const int kMinCachedDecimalExponent = -348;
+
+// the largest cached power of ten that is not larger than 10^exponent
+diy_fp CachedPowerForDecimalExponent(int exponent, int& foundExponent) {
+  const cached_power& power =
+      kCachedPowers[(exponent + kCachedPowersOffset) / kDecimalExponentDistance];
+  foundExponent = power.decimalExponent;
+  return {power.significand, power.binaryExponent};
+}
+
+// a cached power of ten whose binary exponent is in [minExponent, maxExponent]
+diy_fp CachedPowerForBinaryExponentRange(int minExponent, int& foundExponent) {
+  const double k = std::ceil((minExponent + 63) * 0.30102999566398114);
+  const cached_power& power =
+      kCachedPowers[(kCachedPowersOffset + static_cast<int>(k) - 1) /
+                        kDecimalExponentDistance +
+                    1];
+  foundExponent = power.decimalExponent;
+  return {power.significand, power.binaryExponent};
+}
+
+// The layout of the IEEE formats.
+template <typename T>
+struct ieee_format;
+
+template <>
+struct ieee_format<double> {
+  using bits = std::uint64_t;
+  static const int kSignificandSize = 52;
+  static const int kExponentBias = 0x3FF + kSignificandSize;
+};
+
+template <>
+struct ieee_format<float> {
+  using bits = std::uint32_t;
+  static const int kSignificandSize = 23;
+  static const int kExponentBias = 0x7F + kSignificandSize;
+};
+
+template <typename T>
+struct ieee {
+  using format = ieee_format<T>;
+  using bits = typename format::bits;
+  static const int kDenormalExponent = 1 - format::kExponentBias;
+  static const int kMaxExponent =
+      (1 << (sizeof(T) * 8 - 1 - format::kSignificandSize)) - 1 -
+      format::kExponentBias;
+  static const bits kHiddenBit = bits(1) << format::kSignificandSize;
+  static const bits kSignificandMask = kHiddenBit - 1;
+
+  // value must be positive and finite
+  static diy_fp Split(T value, bool& lowerBoundaryIsCloser) {
+    bits raw;
+    std::memcpy(&raw, &value, sizeof(T));
+    const int biasedExponent = static_cast<int>(raw >> format::kSignificandSize);
+    const bits significand = raw & kSignificandMask;
+    lowerBoundaryIsCloser = significand == 0 && biasedExponent > 1;
+    if (biasedExponent == 0)
+      return {significand, kDenormalExponent};
+    return {significand + kHiddenBit, biasedExponent - format::kExponentBias};
+  }
+
+  // Rounds a significand that fits into the format to a value, handling
+  // denormals and overflow.
+  static T Join(std::uint64_t significand, int exponent) {
+    while (significand > kHiddenBit + kSignificandMask) {
+      significand >>= 1;
+      exponent++;
+    }
+    if (exponent >= kMaxExponent)
+      return std::numeric_limits<T>::infinity();
+    if (exponent < kDenormalExponent)
+      return 0;
+    while (exponent > kDenormalExponent && (significand & kHiddenBit) == 0) {
+      significand <<= 1;
+      exponent--;
+    }
+    bits biasedExponent = 0;
+    if (exponent != kDenormalExponent || (significand & kHiddenBit) != 0)
+      biasedExponent = static_cast<bits>(exponent + format::kExponentBias);
+    const bits raw = (static_cast<bits>(significand) & kSignificandMask) |
+                     (biasedExponent << format::kSignificandSize);
+    T value;
+    std::memcpy(&value, &raw, sizeof(T));
+    return value;
+  }
+
+  // bits of precision that a value with the given binary magnitude has
+  static int SignificandSizeForOrderOfMagnitude(int order) {
+    if (order >= kDenormalExponent + format::kSignificandSize + 1)
+      return format::kSignificandSize + 1;
+    if (order <= kDenormalExponent)
+      return 0;
+    return order - kDenormalExponent;
+  }
+};
+
+// 10^1 to 10^7
+diy_fp AdjustmentPowerOfTen(int exponent) {
+  static const diy_fp kPowers[] = {
+      {0xa000000000000000ull, -60}, {0xc800000000000000ull, -57},
+      {0xfa00000000000000ull, -54}, {0x9c40000000000000ull, -50},
+      {0xc350000000000000ull, -47}, {0xf424000000000000ull, -44},
+      {0x9896800000000000ull, -40}};
+  return kPowers[exponent - 1];
+}
+
+// Multiplies the significand with an approximation of the power of ten and
+// keeps track of the error in eighths of the last bit. Returns false if the
+// error leaves the rounding undecided.
+bool ApproximateDecimal(const decimal& input, double& value) {
+  const int kDenominatorLog = 3;
+  const std::uint64_t kDenominator = 1 << kDenominatorLog;
+  const int kMaxUint64DecimalDigits = 19;
+
+  diy_fp x = {input.significand, 0};
+  int exponent = input.exponent;
+  std::uint64_t error = 0;
+  if (input.readDigits < input.digits) {
+    if (input.nextDigit >= '5')
+      x.f++;
+    exponent += input.digits - input.readDigits;
+    error = kDenominator / 2;
+  }
+  int oldE = x.e;
+  x = Normalize(x);
+  error <<= oldE - x.e;
+
+  int cachedExponent;
+  const diy_fp cachedPower =
+      CachedPowerForDecimalExponent(exponent, cachedExponent);
+  if (cachedExponent != exponent) {
+    const int adjustmentExponent = exponent - cachedExponent;
+    x = Multiply(x, AdjustmentPowerOfTen(adjustmentExponent));
+    // exact if the product still fits into 64 bits
+    if (kMaxUint64DecimalDigits - input.readDigits < adjustmentExponent)
+      error += kDenominator / 2;
+  }
+  x = Multiply(x, cachedPower);
+  // the error of the cached power, of the product, and of the rounding
+  error += kDenominator / 2 + (error == 0 ? 0 : 1) + kDenominator / 2;
+
+  oldE = x.e;
+  x = Normalize(x);
+  error <<= oldE - x.e;
+
+  int precisionDigits =
+      64 - ieee<double>::SignificandSizeForOrderOfMagnitude(64 + x.e);
+  if (precisionDigits + kDenominatorLog >= 64) {
+    // very small denormals
+    const int shift = precisionDigits + kDenominatorLog - 64 + 1;
+    x.f >>= shift;
+    x.e += shift;
+    error = (error >> shift) + 1 + kDenominator;
+    precisionDigits -= shift;
+  }
+  const std::uint64_t precisionMask = (std::uint64_t(1) << precisionDigits) - 1;
+  const std::uint64_t precisionBits = (x.f & precisionMask) * kDenominator;
+  const std::uint64_t halfWay =
+      (std::uint64_t(1) << (precisionDigits - 1)) * kDenominator;
+  std::uint64_t significand = x.f >> precisionDigits;
+  if (precisionBits >= halfWay + error)
+    significand++;
+  value = ieee<double>::Join(significand, x.e + precisionDigits);
+  return !(halfWay - error < precisionBits && precisionBits < halfWay + error);
+}
+
+const double kExactPowersOfTen[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                    1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                    1e18, 1e19, 1e20, 1e21, 1e22};
+
+// Significands and powers of ten that are both exact give a correctly rounded
+// result with a single operation.
+bool ExactDecimal(const decimal& input, double& value) {
+  if (input.readDigits < input.digits ||
+      input.significand > (std::uint64_t(1) << 53) || input.exponent < -22 ||
+      input.exponent > 22)
+    return false;
+  const double significand = static_cast<double>(input.significand);
+  value = input.exponent < 0 ? significand / kExactPowersOfTen[-input.exponent]
+                             : significand * kExactPowersOfTen[input.exponent];
+  return true;
+}
+
+// Doubles outside of these decimal exponents are infinite or zero.
+const int kMaxDecimalExponent = 309;
+const int kMinDecimalExponent = -324;
+
+// the floating point numbers that are not integers, or integers too large for
+// 64 bits
+bool ParseDecimal(const char* begin, const char* end, double& value) {
+  if (ReadSpecial(begin, end, value))
+    return true;
+
+  decimal input;
+  if (!ReadDecimal(begin, end, input))
+    return false;
+
+  if (input.digits == 0) {
+    value = 0;
+  } else if (ExactDecimal(input, value)) {
+  } else if (input.exponent + input.digits - 1 >= kMaxDecimalExponent) {
+    return false;
+  } else if (input.exponent + input.digits <= kMinDecimalExponent ||
+             input.exponent + input.digits - input.readDigits <
+                 kMinCachedDecimalExponent) {
+    value = 0;
+  } else if (!ApproximateDecimal(input, value)) {
+    if (!ReadWithStream(begin, end, value))
+      return false;
+    // the stream keeps the sign
+    return !std::isinf(value);
+  }
+  if (std::isinf(value))
+    return false;
+  if (input.negative)
+    value = -value;
+  return true;
+}
+
+bool ParseDouble(const char* begin, const char* end, double& value) {
+  bool negative;
+  std::uint64_t magnitude;
+  int base;
+  switch (ReadInteger(begin, end, negative, magnitude, base)) {
+    case integer_text::Valid:
+      value = static_cast<double>(magnitude);
+      if (negative)
+        value = -value;
+      return true;
+    case integer_text::Overflow:
+      // decimals this long are still fine as floating point numbers
+      if (base != 10)
+        return false;
+      break;
+    case integer_text::Invalid:
+      break;
+  }
+  return ParseDecimal(begin, end, value);
+}
+
+// name in one of the spellings of the core schema: lowercase, Capitalized or
+// UPPERCASE
+bool IsName(const char* p, std::size_t size, const char* name) {
+  if (size != std::strlen(name))
+    return false;
+  auto upper = [](char ch) { return static_cast<char>(ch - 'a' + 'A'); };
+  const bool capital = p[0] == upper(name[0]);
+  if (!capital && p[0] != name[0])
+    return false;
+  const bool uppercase = capital && size > 1 && p[1] == upper(name[1]);
+  for (std::size_t i = 1; i < size; i++) {
+    if (p[i] != (uppercase ? upper(name[i]) : name[i]))
+      return false;
+  }
+  return true;
+}
+
+// ParseDouble(), keeping integers as they are
+void ResolveNumber(const char* begin, const char* end, ResolvedScalar& scalar) {
+  bool negative;
+  std::uint64_t magnitude;
+  int base;
+  switch (ReadInteger(begin, end, negative, magnitude, base)) {
+    case integer_text::Valid:
+      if (negative &&
+          magnitude > static_cast<std::uint64_t>(
+                          std::numeric_limits<long long>::max()) + 1) {
+        scalar.type = ScalarType::Float;
+        scalar.floatValue = -static_cast<double>(magnitude);
+      } else {
+        scalar.type = ScalarType::Int;
+        scalar.negative = negative;
+        scalar.magnitude = magnitude;
+      }
+      return;
+    case integer_text::Overflow:
+      if (base != 10)
+        return;
+      break;
+    case integer_text::Invalid:
+      break;
+  }
+  double value;
+  if (ParseDecimal(begin, end, value)) {
+    scalar.type = ScalarType::Float;
+    scalar.floatValue = value;
+  }
+}
+
+// Grisu3: generates the shortest digits in the interval (low, high) around
+// w, all scaled by the same power of ten, and returns false if the
+// approximations leave the result in doubt.
+bool RoundWeed(char* buffer, int length, std::uint64_t distanceTooHighW,
+               std::uint64_t unsafeInterval, std::uint64_t rest,
+               std::uint64_t tenKappa, std::uint64_t unit) {
+  const std::uint64_t smallDistance = distanceTooHighW - unit;
+  const std::uint64_t bigDistance = distanceTooHighW + unit;
+  while (rest < smallDistance && unsafeInterval - rest >= tenKappa &&
+         (rest + tenKappa < smallDistance ||
+          smallDistance - rest >= rest + tenKappa - smallDistance)) {
+    buffer[length - 1]--;
+    rest += tenKappa;
+  }
+  if (rest < bigDistance && unsafeInterval - rest >= tenKappa &&
+      (rest + tenKappa < bigDistance ||
+       bigDistance - rest > rest + tenKappa - bigDistance))
+    return false;
+  return 2 * unit <= rest && rest <= unsafeInterval - 4 * unit;
+}
+
+const std::uint32_t kSmallPowersOfTen[] = {
+    0, 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+    1000000000};
+
+bool GenerateDigits(diy_fp low, diy_fp w, diy_fp high, char* buffer,
+                    int& length, int& kappa) {
+  std::uint64_t unit = 1;
+  const diy_fp tooLow = {low.f - unit, low.e};
+  const diy_fp tooHigh = {high.f + unit, high.e};
+  std::uint64_t unsafeInterval = tooHigh.f - tooLow.f;
+  const diy_fp one = {std::uint64_t(1) << -w.e, w.e};
+  std::uint32_t integrals = static_cast<std::uint32_t>(tooHigh.f >> -one.e);
+  std::uint64_t fractionals = tooHigh.f & (one.f - 1);
+
+  // the largest power of ten that is not larger than integrals
+  const int integralBits = 64 + one.e;
+  kappa = ((integralBits + 1) * 1233 >> 12) + 1;
+  if (integrals < kSmallPowersOfTen[kappa])
+    kappa--;
+  std::uint32_t divisor = kSmallPowersOfTen[kappa];
+
+  length = 0;
+  while (kappa > 0) {
+    buffer[length++] = static_cast<char>('0' + integrals / divisor);
+    integrals %= divisor;
+    kappa--;
+    const std::uint64_t rest =
+        (static_cast<std::uint64_t>(integrals) << -one.e) + fractionals;
+    if (rest < unsafeInterval)
+      return RoundWeed(buffer, length, tooHigh.f - w.f, unsafeInterval, rest,
+                       static_cast<std::uint64_t>(divisor) << -one.e, unit);
+    divisor /= 10;
+  }
+  for (;;) {
+    fractionals *= 10;
+    unit *= 10;
+    unsafeInterval *= 10;
+    buffer[length++] = static_cast<char>('0' + (fractionals >> -one.e));
+    fractionals &= one.f - 1;
+    kappa--;
+    if (fractionals < unsafeInterval)
+      return RoundWeed(buffer, length, (tooHigh.f - w.f) * unit,
+                       unsafeInterval, fractionals, one.f, unit);
+  }
+}
+
+// value must be positive and finite; writes at most 17 digits whose value
+// times 10^exponent is the value
+template <typename T>
+bool ShortestDigits(T value, char* buffer, int& length, int& exponent) {
+  bool lowerBoundaryIsCloser;
+  const diy_fp v = ieee<T>::Split(value, lowerBoundaryIsCloser);
+  const diy_fp w = Normalize(v);
+  const diy_fp high = Normalize({(v.f << 1) + 1, v.e - 1});
+  diy_fp low = lowerBoundaryIsCloser ? diy_fp{(v.f << 2) - 1, v.e - 2}
+                                     : diy_fp{(v.f << 1) - 1, v.e - 1};
+  low.f <<= low.e - high.e;
+  low.e = high.e;
+
+  // scale into the range where the integral digits fit into 32 bits
+  const int kMinimalTargetExponent = -60;
+  int tenMkExponent;
+  const diy_fp tenMk = CachedPowerForBinaryExponentRange(
+      kMinimalTargetExponent - (w.e + 64), tenMkExponent);
+  int kappa;
+  const bool result =
+      GenerateDigits(Multiply(low, tenMk), Multiply(w, tenMk),
+                     Multiply(high, tenMk), buffer, length, kappa);
+  exponent = kappa - tenMkExponent;
+  return result;
+}
+
+// Writes the value rounded to the given number of digits and returns whether
+// they parse back to the value.
+template <typename T>
+bool RoundedDigits(T value, int digits, char* buffer, int& length,
+                   int& exponent) {
+  char text[48];
+  std::snprintf(text, sizeof(text), "%.*e", digits - 1,
+                static_cast<double>(value));
+
+  // the digits, without whatever decimal point the locale has
+  const char* p = text;
+  length = 0;
+  for (; *p && *p != 'e'; ++p) {
+    if (IsDigit(*p))
+      buffer[length++] = *p;
+  }
+  exponent = std::atoi(p + 1) - (length - 1);
+
+  char canonical[48];
+  std::memcpy(canonical, buffer, length);
+  const int size =
+      length + std::snprintf(canonical + length, sizeof(canonical) - length,
+                             "e%d", exponent);
+  T parsed;
+  return ParseNumber(canonical, canonical + size, parsed) && parsed == value;
+}
+
+// For the values Grisu3 gives up on. If some number of digits round-trips,
+// so does every larger one; most of these values need the most digits.
+template <typename T>
+void ShortestDigitsSlow(T value, char* buffer, int& length, int& exponent) {
+  const int maxDigits = std::numeric_limits<T>::max_digits10;
+  int digits = maxDigits - 2;
+  if (RoundedDigits(value, digits, buffer, length, exponent)) {
+    while (digits > 1 &&
+           RoundedDigits(value, digits - 1, buffer, length, exponent))
+      digits--;
+  } else {
+    while (++digits < maxDigits &&
+           !RoundedDigits(value, digits, buffer, length, exponent)) {
+    }
+  }
+  RoundedDigits(value, digits, buffer, length, exponent);
+  while (length > 1 && buffer[length - 1] == '0') {
+    length--;
+    exponent++;
+  }
+}
+
+// Grisu3 for a given number of digits: rounds the digits generated so far up
+// if the rest is more than half of the last digit, and returns false if the
+// error of w could decide it either way.
+bool RoundWeedCounted(char* buffer, int length, std::uint64_t rest,
+                      std::uint64_t tenKappa, std::uint64_t unit, int& kappa) {
+  if (unit >= tenKappa || tenKappa - unit <= unit)
+    return false;
+  if (tenKappa - rest > rest && tenKappa - 2 * rest >= 2 * unit)
+    return true;
+  if (rest > unit && tenKappa - (rest - unit) <= rest - unit) {
+    buffer[length - 1]++;
+    for (int i = length - 1; i > 0 && buffer[i] == '0' + 10; i--) {
+      buffer[i] = '0';
+      buffer[i - 1]++;
+    }
+    if (buffer[0] == '0' + 10) {
+      buffer[0] = '1';
+      kappa++;
+    }
+    return true;
+  }
+  return false;
+}
+
+bool GenerateCountedDigits(diy_fp w, int digits, char* buffer, int& length,
+                           int& kappa) {
+  std::uint64_t unit = 1;
+  const diy_fp one = {std::uint64_t(1) << -w.e, w.e};
+  std::uint32_t integrals = static_cast<std::uint32_t>(w.f >> -one.e);
+  std::uint64_t fractionals = w.f & (one.f - 1);
+
+  const int integralBits = 64 + one.e;
+  kappa = ((integralBits + 1) * 1233 >> 12) + 1;
+  if (integrals < kSmallPowersOfTen[kappa])
+    kappa--;
+  std::uint32_t divisor = kSmallPowersOfTen[kappa];
+
+  length = 0;
+  while (kappa > 0) {
+    buffer[length++] = static_cast<char>('0' + integrals / divisor);
+    integrals %= divisor;
+    kappa--;
+    if (--digits == 0)
+      break;
+    divisor /= 10;
+  }
+  if (digits == 0) {
+    const std::uint64_t rest =
+        (static_cast<std::uint64_t>(integrals) << -one.e) + fractionals;
+    return RoundWeedCounted(buffer, length, rest,
+                            static_cast<std::uint64_t>(divisor) << -one.e,
+                            unit, kappa);
+  }
+  while (digits > 0 && fractionals > unit) {
+    fractionals *= 10;
+    unit *= 10;
+    buffer[length++] = static_cast<char>('0' + (fractionals >> -one.e));
+    fractionals &= one.f - 1;
+    kappa--;
+    digits--;
+  }
+  if (digits != 0)
+    return false;
+  return RoundWeedCounted(buffer, length, fractionals, one.f, unit, kappa);
+}
+
+// value must be positive and finite; writes the value rounded to the given
+// number of digits (at most 17), without trailing zeros, times 10^exponent
+void CountedDigits(double value, int digits, char* buffer, int& length,
+                   int& exponent) {
+  bool lowerBoundaryIsCloser;
+  const diy_fp w =
+      Normalize(ieee<double>::Split(value, lowerBoundaryIsCloser));
+
+  const int kMinimalTargetExponent = -60;
+  int tenMkExponent;
+  const diy_fp tenMk = CachedPowerForBinaryExponentRange(
+      kMinimalTargetExponent - (w.e + 64), tenMkExponent);
+  int kappa;
+  if (GenerateCountedDigits(Multiply(w, tenMk), digits, buffer, length,
+                            kappa))
+    exponent = kappa - tenMkExponent;
+  else
+    RoundedDigits(value, digits, buffer, length, exponent);
+  while (length > 1 && buffer[length - 1] == '0') {
+    length--;
+    exponent++;
+  }
+}
+
+char* WriteExponent(char* p, int exponent) {
+  *p++ = 'e';
+  *p++ = exponent < 0 ? '-' : '+';
+  if (exponent < 0)
+    exponent = -exponent;
+  if (exponent >= 100)
+    *p++ = static_cast<char>('0' + exponent / 100);
+  *p++ = static_cast<char>('0' + exponent / 10 % 10);
+  *p++ = static_cast<char>('0' + exponent % 10);
+  return p;
+}
+
+// Writes digits times 10^exponent like printf's %g does: fixed notation
+// unless the decimal exponent is below -4 or at least precision.
+char* WriteDigits(char* p, const char* digits, int length, int exponent,
+                  int precision) {
+  const int point = length + exponent;
+  const int scientificExponent = point - 1;
+  if (scientificExponent < -4 || scientificExponent >= precision) {
+    *p++ = digits[0];
+    if (length > 1) {
+      *p++ = '.';
+      std::memcpy(p, digits + 1, length - 1);
+      p += length - 1;
+    }
+    return WriteExponent(p, scientificExponent);
+  }
+
+  if (point <= 0) {
+    *p++ = '0';
+    *p++ = '.';
+    std::memset(p, '0', -point);
+    p += -point;
+    std::memcpy(p, digits, length);
+    return p + length;
+  }
+  if (point >= length) {
+    std::memcpy(p, digits, length);
+    p += length;
+    std::memset(p, '0', point - length);
+    return p + point - length;
+  }
+  std::memcpy(p, digits, point);
+  p += point;
+  *p++ = '.';
+  std::memcpy(p, digits + point, length - point);
+  return p + length - point;
+}
+
+// Writes the sign, and the whole value if it is .nan, .inf or zero; returns
+// false with the value made positive otherwise.
+template <typename T>
+bool WriteSpecial(char*& p, T& value) {
+  if (std::isnan(value)) {
+    std::memcpy(p, ".nan", 4);
+    p += 4;
+    return true;
+  }
+  if (std::signbit(value)) {
+    *p++ = '-';
+    value = -value;
+  }
+  if (std::isinf(value)) {
+    std::memcpy(p, ".inf", 4);
+    p += 4;
+    return true;
+  }
+  if (value == 0) {
+    *p++ = '0';
+    return true;
+  }
+  return false;
+}
+
+// Like printf's %g with the precision that always round-trips, but with the
+// fewest digits that do.
+template <typename T>
+char* FormatFloatingPoint(char* p, T value) {
+  if (WriteSpecial(p, value))
+    return p;
+
+  char digits[24];
+  int length;
+  int exponent;
+  if (!ShortestDigits(value, digits, length, exponent))
+    ShortestDigitsSlow(value, digits, length, exponent);
+  return WriteDigits(p, digits, length, exponent,
+                     std::numeric_limits<T>::max_digits10);
+}
+}  // namespace
+
+ResolvedScalar ResolveScalar(const char* data, std::size_t size) {
+  ResolvedScalar scalar;
+  scalar.type = ScalarType::String;
+  scalar.negative = false;
+  scalar.magnitude = 0;
+  if (size == 0) {
+    scalar.type = ScalarType::Null;
+    return scalar;
+  }
+
+  switch (data[0]) {
+    case '~':
+      if (size == 1)
+        scalar.type = ScalarType::Null;
+      break;
+    case 'n':
+    case 'N':
+      if (IsName(data, size, "null"))
+        scalar.type = ScalarType::Null;
+      break;
+    case 't':
+    case 'T':
+    case 'f':
+    case 'F':
+      if (IsName(data, size, "true") || IsName(data, size, "false")) {
+        scalar.type = ScalarType::Bool;
+        scalar.boolValue = data[0] == 't' || data[0] == 'T';
+      }
+      break;
+    case '+':
+    case '-':
+    case '.':
+      ResolveNumber(data, data + size, scalar);
+      break;
+    default:
+      if (IsDigit(data[0]))
+        ResolveNumber(data, data + size, scalar);
+      break;
+  }
+  return scalar;
+}
+
+bool ParseNumber(const char* begin, const char* end, long long& value) {
+  bool negative;
+  std::uint64_t magnitude;
+  int base;
+  if (ReadInteger(begin, end, negative, magnitude, base) !=
+      integer_text::Valid)
+    return false;
+
+  const std::uint64_t max = std::numeric_limits<long long>::max();
+  if (negative) {
+    if (magnitude > max + 1)
+      return false;
+    value = magnitude == max + 1 ? std::numeric_limits<long long>::min()
+                                 : -static_cast<long long>(magnitude);
+  } else {
+    if (magnitude > max)
+      return false;
+    value = static_cast<long long>(magnitude);
+  }
+  return true;
+}
+
+bool ParseNumber(const char* begin, const char* end,
+                 unsigned long long& value) {
+  bool negative;
+  std::uint64_t magnitude;
+  int base;
+  if (ReadInteger(begin, end, negative, magnitude, base) !=
+          integer_text::Valid ||
+      negative)
+    return false;
+  value = magnitude;
+  return true;
+}
+
+bool ParseNumber(const char* begin, const char* end, double& value) {
+  return ParseDouble(begin, end, value);
+}
+
+bool ParseNumber(const char* begin, const char* end, float& value) {
+  double result;
+  return ParseDouble(begin, end, result) &&
+         NarrowNumber(result, begin, end, value);
+}
+
+// A float parsed as a double can be rounded twice, which is only wrong if the
+// double lies exactly halfway between two floats.
+bool NarrowNumber(double result, const char* begin, const char* end,
+                  float& value) {
+  if (std::isnan(result) || std::isinf(result)) {
+    value = static_cast<float>(result);
+    return true;
+  }
+
+  // halfway between the largest float and the next power of two, which
+  // rounds up to infinity
+  const double kOverflow = 3.4028235677973366e38;
+  if (std::fabs(result) > kOverflow)
+    return false;
+
+  value = static_cast<float>(result);
+  if (static_cast<double>(value) == result)
+    return true;
+
+  bool halfway;
+  if (std::fabs(result) >= std::numeric_limits<float>::min()) {
+    // the 29 bits a float does not have are exactly one half
+    std::uint64_t bits;
+    std::memcpy(&bits, &result, sizeof(bits));
+    const std::uint64_t kHalf = std::uint64_t(1) << 28;
+    halfway = (bits & (2 * kHalf - 1)) == kHalf;
+  } else {
+    const float neighbor = std::nextafter(
+        value, result > value ? std::numeric_limits<float>::infinity()
+                              : -std::numeric_limits<float>::infinity());
+    halfway =
+        (static_cast<double>(value) + static_cast<double>(neighbor)) / 2 ==
+        result;
+  }
+  if (halfway || std::fabs(result) == kOverflow)
+    return ReadWithStream(begin, end, value) && !std::isinf(value);
+  return true;
+}
+
+char* FormatNumber(char* buffer, unsigned long long value) {
+  char digits[20];
+  char* p = digits + sizeof(digits);
+  do {
+    *--p = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  const std::size_t size = digits + sizeof(digits) - p;
+  std::memcpy(buffer, p, size);
+  return buffer + size;
+}
+
+char* FormatNumber(char* buffer, long long value) {
+  if (value < 0) {
+    *buffer++ = '-';
+    return FormatNumber(buffer, 0 - static_cast<unsigned long long>(value));
+  }
+  return FormatNumber(buffer, static_cast<unsigned long long>(value));
+}
+
+char* FormatNumber(char* buffer, double value) {
+  return FormatFloatingPoint(buffer, value);
+}
+
+char* FormatNumber(char* buffer, float value) {
+  return FormatFloatingPoint(buffer, value);
+}
+
+char* FormatNumber(char* buffer, double value, std::size_t precision) {
+  if (WriteSpecial(buffer, value))
+    return buffer;
+
+  const int digits = static_cast<int>(
+      std::min<std::size_t>(std::max<std::size_t>(precision, 1), 17));
+  char text[24];
+  int length;
+  int exponent;
+  CountedDigits(value, digits, text, length, exponent);
+  return WriteDigits(buffer, text, length, exponent, digits);
+}
+}  // namespace YAML
@@ -8,6 +8,9 @@ namespace YAML {
 ostream_wrapper::ostream_wrapper()
     : m_buffer(1, '\0'),
       m_pStream(nullptr),
+      m_pSink(nullptr),
+      m_sinkBufferSize(0),
+      m_buffered(0),
       m_pos(0),
       m_row(0),
       m_col(0),
@@ -16,47 +19,92 @@ ostream_wrapper::ostream_wrapper()
 ostream_wrapper::ostream_wrapper(std::ostream& stream)
     : m_buffer{},
       m_pStream(&stream),
+      m_pSink(nullptr),
+      m_sinkBufferSize(0),
+      m_buffered(0),
       m_pos(0),
       m_row(0),
       m_col(0),
       m_comment(false) {}
 
-ostream_wrapper::~ostream_wrapper() = default;
+ostream_wrapper::ostream_wrapper(OutputSink& sink, std::size_t bufferSize)
+    : m_buffer{},
+      m_pStream(nullptr),
+      m_pSink(&sink),
+      m_sinkBufferSize(std::max<std::size_t>(bufferSize, 1)),
+      m_buffered(0),
+      m_pos(0),
+      m_row(0),
+      m_col(0),
+      m_comment(false) {}
 
-void ostream_wrapper::write(const std::string& str) {
-  if (m_pStream) {
-    m_pStream->write(str.c_str(), str.size());
-  } else {
-    m_buffer.resize(std::max(m_buffer.size(), m_pos + str.size() + 1));
-    std::copy(str.begin(), str.end(), m_buffer.begin() + m_pos);
-  }
+ostream_wrapper::~ostream_wrapper() { flush(); }
 
-  for (char ch : str) {
-    update_pos(ch);
-  }
+void ostream_wrapper::write(const std::string& str) {
+  write(str.data(), str.size());
 }
 
 void ostream_wrapper::write(const char* str, std::size_t size) {
-  if (m_pStream) {
+  if (m_pSink) {
+    if (m_buffered + size > m_sinkBufferSize)
+      flush();
+    // writes that would fill the whole buffer go to the sink directly; the
+    // buffer only grows to its full size for output that needs it
+    if (size >= m_sinkBufferSize) {
+      m_pSink->Write(str, size);
+    } else {
+      if (m_buffered + size > m_buffer.size())
+        m_buffer.resize(std::min(
+            m_sinkBufferSize, std::max(m_buffered + size, 2 * m_buffer.size())));
+      std::memcpy(&m_buffer[m_buffered], str, size);
+      m_buffered += size;
+    }
+  } else if (m_pStream) {
     m_pStream->write(str, size);
   } else {
     m_buffer.resize(std::max(m_buffer.size(), m_pos + size + 1));
-    std::copy(str, str + size, m_buffer.begin() + m_pos);
+    std::memcpy(&m_buffer[m_pos], str, size);
   }
 
-  for (std::size_t i = 0; i < size; i++) {
-    update_pos(str[i]);
+  m_pos += size;
+  update_pos(str, size);
+}
+
+void ostream_wrapper::flush() {
+  if (m_pSink && m_buffered > 0) {
+    m_pSink->Write(&m_buffer[0], m_buffered);
+    m_buffered = 0;
   }
 }
 
-void ostream_wrapper::update_pos(char ch) {
-  m_pos++;
-  m_col++;
+// Each newline starts a new row and the column counts from the last one. In
+// longer text the newlines are found with memchr; short writes, most of them
+// a single character, are cheaper to look at directly.
+void ostream_wrapper::update_pos(const char* str, std::size_t size) {
+  const char* const end = str + size;
+  const char* line = str;
+  if (size < 16) {
+    for (const char* p = str; p != end; ++p) {
+      if (*p == '\n') {
+        m_row++;
+        line = p + 1;
+      }
+    }
+  } else {
+    while (line != end) {
+      const char* newline =
+          static_cast<const char*>(std::memchr(line, '\n', end - line));
+      if (!newline)
+        break;
+      m_row++;
+      line = newline + 1;
+    }
+  }
 
-  if (ch == '\n') {
-    m_row++;
+  if (line != str) {
     m_col = 0;
     m_comment = false;
   }
+  m_col += end - line;
 }
 }  // namespace YAML
@@ -32,7 +32,8 @@ Node Load(std::istream& input) {
 Node LoadFile(const std::string& filename) {
   std::ifstream fin(filename);
   if (!fin) {
-    throw BadFile(filename);
+    detail::raise(BadFile(filename));
+    return Node();
   }
   return Load(fin);
 }
@@ -65,7 +66,8 @@ std::vector<Node> LoadAll(std::istream& input) {
 std::vector<Node> LoadAllFromFile(const std::string& filename) {
   std::ifstream fin(filename);
   if (!fin) {
-    throw BadFile(filename);
+    detail::raise(BadFile(filename));
+    return {};
   }
   return LoadAll(fin);
 }
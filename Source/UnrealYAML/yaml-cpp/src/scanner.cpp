@@ -51,8 +51,19 @@ Token& Scanner::peek() {
 
 Mark Scanner::mark() const { return INPUT.mark(); }
 
+void Scanner::fail(const Mark& mark, const std::string& msg) {
+  INPUT.fail(mark, msg);
+}
+
 void Scanner::EnsureTokensInQueue() {
   while (true) {
+    // after an error, what is left in the queue is never read
+    if (INPUT.failed()) {
+      m_tokens = std::queue<Token>();
+      m_endedStream = true;
+      return;
+    }
+
     if (!m_tokens.empty()) {
       Token& token = m_tokens.front();
 
@@ -171,7 +182,7 @@ void Scanner::ScanNextToken() {
   }
 
   // don't know what it is!
-  throw ParserException(INPUT.mark(), ErrorMsg::UNKNOWN_TOKEN);
+  return INPUT.fail(INPUT.mark(), ErrorMsg::UNKNOWN_TOKEN);
 }
 
 void Scanner::ScanToNextToken() {
@@ -281,7 +292,9 @@ Token::TYPE Scanner::GetStartTokenFor(IndentMarker::INDENT_TYPE type) const {
       break;
   }
   assert(false);
-  throw std::runtime_error("yaml-cpp: internal error, invalid indent type");
+  detail::raise(Exception(Mark::null_mark(),
+                          "yaml-cpp: internal error, invalid indent type"));
+  return Token::BLOCK_MAP_START;
 }
 
 Scanner::IndentMarker* Scanner::PushIndentTo(int column,
@@ -380,13 +393,4 @@ int Scanner::GetTopIndent() const {
   }
   return m_indents.top()->column;
 }
-
-void Scanner::ThrowParserException(const std::string& msg) const {
-  Mark mark = Mark::null_mark();
-  if (!m_tokens.empty()) {
-    const Token& token = m_tokens.front();
-    mark = token.mark;
-  }
-  throw ParserException(mark, msg);
-}
 }  // namespace YAML
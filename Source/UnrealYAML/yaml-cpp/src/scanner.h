@@ -44,6 +44,15 @@ class Scanner {
   /** Returns the current mark in the input stream. */
   Mark mark() const;
 
+  /**
+   * Raises a ParserException at the mark. Without exceptions, no more tokens
+   * are read: the scanner is then empty.
+   */
+  void fail(const Mark &mark, const std::string &msg);
+
+  /** Returns true if scanning stopped at an error. */
+  bool failed() const { return INPUT.failed(); }
+
  private:
   struct IndentMarker {
     enum INDENT_TYPE { MAP, SEQ, NONE };
@@ -125,12 +134,6 @@ class Scanner {
   bool VerifySimpleKey();
   void PopAllSimpleKeys();
 
-  /**
-   * Throws a ParserException with the current token location (if available),
-   * and does not parse any more tokens.
-   */
-  void ThrowParserException(const std::string &msg) const;
-
   bool IsWhitespaceToBeEaten(char ch);
 
   /**
@@ -49,7 +49,8 @@ std::string ScanScalar(Stream& INPUT, ScanScalarParams& params) {
           break;
         }
         if (params.onDocIndicator == THROW) {
-          throw ParserException(INPUT.mark(), ErrorMsg::DOC_IN_SCALAR);
+          INPUT.fail(INPUT.mark(), ErrorMsg::DOC_IN_SCALAR);
+          return scalar;
         }
       }
 
@@ -82,10 +83,11 @@ std::string ScanScalar(Stream& INPUT, ScanScalarParams& params) {
       }
     }
 
-    // eof? if we're looking to eat something, then we throw
+    // eof? if we're looking to eat something, then we fail
     if (!INPUT) {
       if (params.eatEnd) {
-        throw ParserException(INPUT.mark(), ErrorMsg::EOF_IN_SCALAR);
+        INPUT.fail(INPUT.mark(), ErrorMsg::EOF_IN_SCALAR);
+        return scalar;
       }
       break;
     }
@@ -135,7 +137,8 @@ std::string ScanScalar(Stream& INPUT, ScanScalarParams& params) {
       // we check for tabs that masquerade as indentation
       if (INPUT.peek() == '\t' && INPUT.column() < params.indent &&
           params.onTabInIndentation == THROW) {
-        throw ParserException(INPUT.mark(), ErrorMsg::TAB_IN_INDENTATION);
+        INPUT.fail(INPUT.mark(), ErrorMsg::TAB_IN_INDENTATION);
+        return scalar;
       }
 
       if (!params.eatLeadingWhitespace) {
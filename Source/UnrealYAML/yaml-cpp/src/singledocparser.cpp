@@ -27,7 +27,8 @@ SingleDocParser::~SingleDocParser() = default;
 
 // HandleDocument
 // . Handles the next document
-// . Throws a ParserException on error.
+// . Throws a ParserException on error, or fails the scanner without
+//   exceptions.
 void SingleDocParser::HandleDocument(EventHandler& eventHandler) {
   assert(!m_scanner.empty());  // guaranteed that there are tokens
   assert(!m_curAnchor);
@@ -50,6 +51,8 @@ void SingleDocParser::HandleDocument(EventHandler& eventHandler) {
 
 void SingleDocParser::HandleNode(EventHandler& eventHandler) {
   DepthGuard<500> depthguard(depth, m_scanner.mark(), ErrorMsg::BAD_FILE);
+  if (depthguard.exceeded())
+    return m_scanner.fail(m_scanner.mark(), ErrorMsg::BAD_FILE);
 
   // an empty node *is* a possibility
   if (m_scanner.empty()) {
@@ -70,7 +73,11 @@ void SingleDocParser::HandleNode(EventHandler& eventHandler) {
 
   // special case: an alias node
   if (m_scanner.peek().type == Token::ALIAS) {
-    eventHandler.OnAlias(mark, LookupAnchor(mark, m_scanner.peek().value));
+    anchor_t anchor = LookupAnchor(mark, m_scanner.peek().value);
+    if (anchor == NullAnchor)  // unknown, without exceptions
+      eventHandler.OnNull(mark, NullAnchor);
+    else
+      eventHandler.OnAlias(mark, anchor);
     m_scanner.pop();
     return;
   }
@@ -169,12 +176,16 @@ void SingleDocParser::HandleBlockSequence(EventHandler& eventHandler) {
   m_pCollectionStack->PushCollectionType(CollectionType::BlockSeq);
 
   while (true) {
-    if (m_scanner.empty())
-      throw ParserException(m_scanner.mark(), ErrorMsg::END_OF_SEQ);
+    if (m_scanner.empty()) {
+      m_scanner.fail(m_scanner.mark(), ErrorMsg::END_OF_SEQ);
+      break;
+    }
 
     Token token = m_scanner.peek();
-    if (token.type != Token::BLOCK_ENTRY && token.type != Token::BLOCK_SEQ_END)
-      throw ParserException(token.mark, ErrorMsg::END_OF_SEQ);
+    if (token.type != Token::BLOCK_ENTRY && token.type != Token::BLOCK_SEQ_END) {
+      m_scanner.fail(token.mark, ErrorMsg::END_OF_SEQ);
+      break;
+    }
 
     m_scanner.pop();
     if (token.type == Token::BLOCK_SEQ_END)
@@ -202,8 +213,10 @@ void SingleDocParser::HandleFlowSequence(EventHandler& eventHandler) {
   m_pCollectionStack->PushCollectionType(CollectionType::FlowSeq);
 
   while (true) {
-    if (m_scanner.empty())
-      throw ParserException(m_scanner.mark(), ErrorMsg::END_OF_SEQ_FLOW);
+    if (m_scanner.empty()) {
+      m_scanner.fail(m_scanner.mark(), ErrorMsg::END_OF_SEQ_FLOW);
+      break;
+    }
 
     // first check for end
     if (m_scanner.peek().type == Token::FLOW_SEQ_END) {
@@ -214,16 +227,20 @@ void SingleDocParser::HandleFlowSequence(EventHandler& eventHandler) {
     // then read the node
     HandleNode(eventHandler);
 
-    if (m_scanner.empty())
-      throw ParserException(m_scanner.mark(), ErrorMsg::END_OF_SEQ_FLOW);
+    if (m_scanner.empty()) {
+      m_scanner.fail(m_scanner.mark(), ErrorMsg::END_OF_SEQ_FLOW);
+      break;
+    }
 
     // now eat the separator (or could be a sequence end, which we ignore - but
     // if it's neither, then it's a bad node)
     Token& token = m_scanner.peek();
     if (token.type == Token::FLOW_ENTRY)
       m_scanner.pop();
-    else if (token.type != Token::FLOW_SEQ_END)
-      throw ParserException(token.mark, ErrorMsg::END_OF_SEQ_FLOW);
+    else if (token.type != Token::FLOW_SEQ_END) {
+      m_scanner.fail(token.mark, ErrorMsg::END_OF_SEQ_FLOW);
+      break;
+    }
   }
 
   m_pCollectionStack->PopCollectionType(CollectionType::FlowSeq);
@@ -255,13 +272,17 @@ void SingleDocParser::HandleBlockMap(EventHandler& eventHandler) {
   m_pCollectionStack->PushCollectionType(CollectionType::BlockMap);
 
   while (true) {
-    if (m_scanner.empty())
-      throw ParserException(m_scanner.mark(), ErrorMsg::END_OF_MAP);
+    if (m_scanner.empty()) {
+      m_scanner.fail(m_scanner.mark(), ErrorMsg::END_OF_MAP);
+      break;
+    }
 
     Token token = m_scanner.peek();
     if (token.type != Token::KEY && token.type != Token::VALUE &&
-        token.type != Token::BLOCK_MAP_END)
-      throw ParserException(token.mark, ErrorMsg::END_OF_MAP);
+        token.type != Token::BLOCK_MAP_END) {
+      m_scanner.fail(token.mark, ErrorMsg::END_OF_MAP);
+      break;
+    }
 
     if (token.type == Token::BLOCK_MAP_END) {
       m_scanner.pop();
@@ -294,8 +315,10 @@ void SingleDocParser::HandleFlowMap(EventHandler& eventHandler) {
   m_pCollectionStack->PushCollectionType(CollectionType::FlowMap);
 
   while (true) {
-    if (m_scanner.empty())
-      throw ParserException(m_scanner.mark(), ErrorMsg::END_OF_MAP_FLOW);
+    if (m_scanner.empty()) {
+      m_scanner.fail(m_scanner.mark(), ErrorMsg::END_OF_MAP_FLOW);
+      break;
+    }
 
     Token& token = m_scanner.peek();
     const Mark mark = token.mark;
@@ -321,16 +344,20 @@ void SingleDocParser::HandleFlowMap(EventHandler& eventHandler) {
       eventHandler.OnNull(mark, NullAnchor);
     }
 
-    if (m_scanner.empty())
-      throw ParserException(m_scanner.mark(), ErrorMsg::END_OF_MAP_FLOW);
+    if (m_scanner.empty()) {
+      m_scanner.fail(m_scanner.mark(), ErrorMsg::END_OF_MAP_FLOW);
+      break;
+    }
 
     // now eat the separator (or could be a map end, which we ignore - but if
     // it's neither, then it's a bad node)
     Token& nextToken = m_scanner.peek();
     if (nextToken.type == Token::FLOW_ENTRY)
       m_scanner.pop();
-    else if (nextToken.type != Token::FLOW_MAP_END)
-      throw ParserException(nextToken.mark, ErrorMsg::END_OF_MAP_FLOW);
+    else if (nextToken.type != Token::FLOW_MAP_END) {
+      m_scanner.fail(nextToken.mark, ErrorMsg::END_OF_MAP_FLOW);
+      break;
+    }
   }
 
   m_pCollectionStack->PopCollectionType(CollectionType::FlowMap);
@@ -398,7 +425,7 @@ void SingleDocParser::ParseProperties(std::string& tag, anchor_t& anchor,
 void SingleDocParser::ParseTag(std::string& tag) {
   Token& token = m_scanner.peek();
   if (!tag.empty())
-    throw ParserException(token.mark, ErrorMsg::MULTIPLE_TAGS);
+    return m_scanner.fail(token.mark, ErrorMsg::MULTIPLE_TAGS);
 
   Tag tagInfo(token);
   tag = tagInfo.Translate(m_directives);
@@ -408,7 +435,7 @@ void SingleDocParser::ParseTag(std::string& tag) {
 void SingleDocParser::ParseAnchor(anchor_t& anchor, std::string& anchor_name) {
   Token& token = m_scanner.peek();
   if (anchor)
-    throw ParserException(token.mark, ErrorMsg::MULTIPLE_ANCHORS);
+    return m_scanner.fail(token.mark, ErrorMsg::MULTIPLE_ANCHORS);
 
   anchor_name = token.value;
   anchor = RegisterAnchor(token.value);
@@ -428,7 +455,8 @@ anchor_t SingleDocParser::LookupAnchor(const Mark& mark,
   if (it == m_anchors.end()) {
     std::stringstream ss;
     ss << ErrorMsg::UNKNOWN_ANCHOR << name;
-    throw ParserException(mark, ss.str());
+    m_scanner.fail(mark, ss.str());
+    return NullAnchor;
   }
 
   return it->second;
@@ -185,6 +185,7 @@ inline void QueueUnicodeCodepoint(std::deque<char>& q, unsigned long ch) {
 Stream::Stream(std::istream& input)
     : m_input(input),
       m_mark{},
+      m_failed(false),
       m_charSet{},
       m_readahead{},
       m_pPrefetched(new unsigned char[YAML_PREFETCH_SIZE]),
@@ -251,8 +252,17 @@ char Stream::peek() const {
 }
 
 Stream::operator bool() const {
-  return m_input.good() ||
-         (!m_readahead.empty() && m_readahead[0] != Stream::eof());
+  return !m_failed &&
+         (m_input.good() ||
+          (!m_readahead.empty() && m_readahead[0] != Stream::eof()));
+}
+
+void Stream::fail(const Mark& mark, const std::string& msg) {
+  if (m_failed)
+    return;
+  detail::raise(ParserException(mark, msg));
+  m_failed = true;
+  m_readahead.clear();
 }
 
 // get
@@ -299,6 +309,9 @@ void Stream::AdvanceCurrent() {
 }
 
 bool Stream::_ReadAheadTo(size_t i) const {
+  if (m_failed)
+    return false;
+
   while (m_input.good() && (m_readahead.size() <= i)) {
     switch (m_charSet) {
       case utf8:
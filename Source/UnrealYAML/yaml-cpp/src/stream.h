@@ -7,6 +7,7 @@
 #pragma once
 #endif
 
+#include "exceptions.h"
 #include "mark.h"
 #include <cstddef>
 #include <deque>
@@ -40,6 +41,11 @@ class Stream {
 
   static char eof() { return 0x04; }
 
+  // Raises a ParserException. Without exceptions, the stream then ends here:
+  // it has no more characters, which stops everything that scans it.
+  void fail(const Mark& mark, const std::string& msg);
+  bool failed() const { return m_failed; }
+
   const Mark mark() const { return m_mark; }
   int pos() const { return m_mark.pos; }
   int line() const { return m_mark.line; }
@@ -51,6 +57,7 @@ class Stream {
 
   std::istream& m_input;
   Mark m_mark;
+  bool m_failed;
 
   CharacterSet m_charSet;
   mutable std::deque<char> m_readahead;
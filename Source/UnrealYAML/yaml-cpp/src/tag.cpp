@@ -1,9 +1,9 @@
 #include "tag.h"
 
 #include <cassert>
-#include <stdexcept>
 
 #include "directives.h"
+#include "exceptions.h"
 #include "token.h"
 
 namespace YAML {
@@ -46,6 +46,8 @@ const std::string Tag::Translate(const Directives& directives) {
     default:
       assert(false);
   }
-  throw std::runtime_error("yaml-cpp: internal error, bad tag type");
+  detail::raise(
+      Exception(Mark::null_mark(), "yaml-cpp: internal error, bad tag type"));
+  return "";
 }
 }  // namespace YAML
@@ -0,0 +1,196 @@
+#include "node/view.h"
+
+#include "frozendata.h"  // IWYU pragma: keep
+#include "node/detail/node_data.h"
+
+namespace YAML {
+NodeView::NodeView(const Node& node)
+    : m_pNode(nullptr), m_frozen{}, m_isEmpty(false) {
+  if (!node.m_isValid) {
+    detail::raise(InvalidNode(node.m_invalidKey));
+    m_isEmpty = true;
+    return;
+  }
+
+  if (node.m_pNode)
+    *this = NodeView(*node.m_pNode);
+  else
+    m_isEmpty = true;
+}
+
+NodeView::NodeView(const detail::node& node)
+    : m_pNode(&node), m_frozen{}, m_isEmpty(false) {
+  const detail::node_data& data = node.data();
+  if (data.m_isFrozen)
+    m_frozen = FrozenNode(data.m_frozen.pData, data.m_frozen.index);
+}
+
+bool NodeView::IsDefined() const {
+  if (m_pNode)
+    return m_pNode->is_defined();
+  return m_isEmpty || m_frozen.IsDefined();
+}
+
+NodeType NodeView::Type() const {
+  if (m_pNode)
+    return m_pNode->type();
+  if (m_isEmpty)
+    return NodeType::Null;
+  return m_frozen.Type();
+}
+
+Mark NodeView::Mark() const {
+  if (m_pNode)
+    return m_pNode->mark();
+  if (m_isEmpty)
+    return YAML::Mark::null_mark();
+  return m_frozen.Mark();
+}
+
+EmitterStyle NodeView::Style() const {
+  if (m_pNode)
+    return m_pNode->style();
+  return m_frozen.Style();
+}
+
+const std::string& NodeView::Tag() const {
+  if (m_pNode)
+    return m_pNode->tag();
+  return m_frozen.Tag();
+}
+
+const char* NodeView::ScalarData() const {
+  if (m_pNode)
+    return m_pNode->scalar().data();
+  return m_frozen.ScalarData();
+}
+
+std::size_t NodeView::ScalarSize() const {
+  if (m_pNode)
+    return m_pNode->scalar().size();
+  return m_frozen.ScalarSize();
+}
+
+// The sequence size cached by node_data::size() is only read; where it may be
+// out of date, the defined elements are counted without storing the result.
+std::size_t NodeView::size() const {
+  if (!is_live())
+    return m_frozen.size();
+
+  const detail::node_data& data = this->data();
+  if (!data.m_isDefined)
+    return 0;
+
+  switch (data.m_type) {
+    case NodeType::Sequence: {
+      const auto& nodes = data.m_sequence.nodes;
+      std::size_t size = data.m_sequence.size.load(std::memory_order_relaxed);
+      while (size < nodes.size() && nodes[size]->is_defined())
+        size++;
+      return size;
+    }
+    case NodeType::Map:
+      return data.m_map.entries.size() - data.m_map.undefinedPairs;
+    default:
+      return 0;
+  }
+}
+
+NodeView NodeView::at(std::size_t index) const {
+  if (!is_live())
+    return NodeView(m_frozen.at(index));
+
+  if (Type() != NodeType::Sequence || index >= size())
+    return NodeView();
+  return NodeView(*data().m_sequence.nodes[index]);
+}
+
+NodeView NodeView::key_at(std::size_t index) const {
+  return IsMap() ? entry_at(index).first : NodeView();
+}
+
+NodeView NodeView::value_at(std::size_t index) const {
+  return IsMap() ? entry_at(index).second : NodeView();
+}
+
+std::pair<NodeView, NodeView> NodeView::entry_at(std::size_t index) const {
+  if (index >= size())
+    return {};
+
+  // entries that are not defined yet are skipped
+  if (is_live() && IsMap() && data().m_map.undefinedPairs > 0) {
+    std::size_t position = next_position(0);
+    while (index-- > 0)
+      position = next_position(position + 1);
+    return entry(position);
+  }
+  return entry(index);
+}
+
+std::size_t NodeView::next_position(std::size_t position) const {
+  if (!is_live() || Type() != NodeType::Map)
+    return position;
+
+  const detail::node_data& data = this->data();
+  if (data.m_map.undefinedPairs == 0)
+    return position;
+
+  const auto& entries = data.m_map.entries;
+  while (position < entries.size() && (!entries[position].first->is_defined() ||
+                                       !entries[position].second->is_defined()))
+    position++;
+  return position;
+}
+
+std::size_t NodeView::end_position() const {
+  if (is_live() && Type() == NodeType::Map)
+    return data().m_map.entries.size();
+  return size();
+}
+
+std::pair<NodeView, NodeView> NodeView::entry(std::size_t position) const {
+  if (!is_live()) {
+    if (m_frozen.IsMap())
+      return {NodeView(m_frozen.key_at(position)),
+              NodeView(m_frozen.value_at(position))};
+    return {NodeView(), NodeView(m_frozen.at(position))};
+  }
+
+  const detail::node_data& data = this->data();
+  if (Type() == NodeType::Map) {
+    const auto& entry = data.m_map.entries[position];
+    return {NodeView(*entry.first), NodeView(*entry.second)};
+  }
+  return {NodeView(), NodeView(*data.m_sequence.nodes[position])};
+}
+
+// Uses the key index of a large map if some earlier lookup through a Node
+// built it, and searches linearly otherwise.
+NodeView NodeView::find(const char* key, std::size_t size) const {
+  if (!is_live())
+    return NodeView(m_frozen.find(key, size));
+
+  if (Type() != NodeType::Map)
+    return NodeView();
+
+  const detail::node* pValue = data().lookup_string_key(key, size);
+  if (!pValue || !pValue->is_defined())
+    return NodeView();
+  return NodeView(*pValue);
+}
+
+Node NodeView::Clone() const {
+  if (!IsDefined())
+    return Node();
+  if (m_pNode)
+    return YAML::Clone(
+        Node(const_cast<detail::node&>(*m_pNode), detail::shared_memory_holder()));
+  return m_frozen.Thaw();
+}
+
+bool NodeView::is(const NodeView& rhs) const {
+  if (m_pNode || rhs.m_pNode)
+    return m_pNode && rhs.m_pNode && m_pNode->is(*rhs.m_pNode);
+  return m_isEmpty == rhs.m_isEmpty && m_frozen.is(rhs.m_frozen);
+}
+}  // namespace YAML